@@ -0,0 +1,316 @@
+#include "ComputeFaceTileBenchmark.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "ShaderStorage.h"
+#include "PolygonDistanceField.h"
+#include "glm/geometric.hpp"
+#include "glload/include/glload/gl_4_4.h"
+
+// Note: MUST be the same bindings as in the shader (the plane buffer's is set here).
+static const unsigned int FACE_PLANE_BUFFER_BINDING = 16;
+static const unsigned int DISTANCE_FIELD_BUFFER_BINDING = 11;
+static const unsigned int OUT_OF_BOUNDS_COUNTER_BINDING = 4;
+
+// the regions that are timed, from a handful of faces up to far more than fit in one tile
+static const unsigned int BENCHMARK_FACE_COUNTS[] = { 4, 64, 1024, 16384, 65536 };
+
+// the regions are circles around the middle of the window, about as big as the demo's region
+static const float BENCHMARK_REGION_RADIUS = 0.5f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets the particle count in every version of the benchmark shader, points them all at the 
+    benchmark's plane buffer (and the distance field version at the benchmark's distance 
+    field buffer), and generates the atomic counter and the timer query.
+Parameters:
+    numParticles                Used to tell a shader uniform how big the "all particles" 
+                                buffer is.
+    untiledShaderKey            The benchmark shader built without POLYGON_FACE_TILES.
+    tiledShaderKey              The benchmark shader built with it.
+    distanceFieldShaderKey      The benchmark shader built with POLYGON_DISTANCE_FIELD, or 
+                                empty to leave the distance field out.
+    distanceFieldTexelsPerSide  How finely each region is baked.
+    pThreadPool                 Spreads the baking across all cores.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeFaceTileBenchmark::ComputeFaceTileBenchmark(unsigned int numParticles,
+    const std::string &untiledShaderKey, const std::string &tiledShaderKey, 
+    const std::string &distanceFieldShaderKey, unsigned int distanceFieldTexelsPerSide, 
+    ThreadPool *pThreadPool) :
+    _distanceFieldProgramId(0),
+    _unifLocDistanceFieldFaceCount(-1),
+    _distanceFieldTexelsPerSide(distanceFieldTexelsPerSide),
+    _pThreadPool(pThreadPool),
+    _distanceFieldBufferId(0)
+{
+    _totalParticleCount = numParticles;
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+
+    _untiledProgramId = shaderStorageRef.GetShaderProgram(untiledShaderKey);
+    glUseProgram(_untiledProgramId);
+    glUniform1ui(shaderStorageRef.GetUniformLocation(untiledShaderKey, "uMaxParticleCount"),
+        numParticles);
+    _unifLocUntiledFaceCount = shaderStorageRef.GetUniformLocation(untiledShaderKey, 
+        "uPolygonFaceCount");
+
+    _tiledProgramId = shaderStorageRef.GetShaderProgram(tiledShaderKey);
+    glUseProgram(_tiledProgramId);
+    glUniform1ui(shaderStorageRef.GetUniformLocation(tiledShaderKey, "uMaxParticleCount"),
+        numParticles);
+    _unifLocTiledFaceCount = shaderStorageRef.GetUniformLocation(tiledShaderKey, 
+        "uPolygonFaceCount");
+
+    if (!distanceFieldShaderKey.empty())
+    {
+        _distanceFieldProgramId = shaderStorageRef.GetShaderProgram(distanceFieldShaderKey);
+        glUseProgram(_distanceFieldProgramId);
+        glUniform1ui(shaderStorageRef.GetUniformLocation(distanceFieldShaderKey, 
+            "uMaxParticleCount"), numParticles);
+        _unifLocDistanceFieldFaceCount = shaderStorageRef.GetUniformLocation(
+            distanceFieldShaderKey, "uPolygonFaceCount");
+    }
+
+    glUseProgram(0);
+
+    // the faces are uploaded for each region in Run()
+    glGenBuffers(1, &_planeBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _planeBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, FACE_PLANE_BUFFER_BINDING, _planeBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    unsigned int programIds[3] = { _untiledProgramId, _tiledProgramId, _distanceFieldProgramId };
+    size_t numPrograms = (_distanceFieldProgramId != 0) ? 3 : 2;
+    for (size_t programCount = 0; programCount < numPrograms; programCount++)
+    {
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(programIds[programCount], 
+            GL_SHADER_STORAGE_BLOCK, "FacePlaneBuffer");
+        glShaderStorageBlockBinding(programIds[programCount], ssboBlockIndex, 
+            FACE_PLANE_BUFFER_BINDING);
+    }
+
+    // each region's field is baked and uploaded in Run()
+    if (_distanceFieldProgramId != 0)
+    {
+        glGenBuffers(1, &_distanceFieldBufferId);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _distanceFieldBufferId);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DISTANCE_FIELD_BUFFER_BINDING, 
+            _distanceFieldBufferId);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(_distanceFieldProgramId, 
+            GL_SHADER_STORAGE_BLOCK, "DistanceFieldBuffer");
+        glShaderStorageBlockBinding(_distanceFieldProgramId, ssboBlockIndex, 
+            DISTANCE_FIELD_BUFFER_BINDING);
+    }
+
+    // Note: Don't bother giving it an initial value.  It is reset before every timing.
+    glGenBuffers(1, &_acCounterBufferId);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCounterBufferId);
+    glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, OUT_OF_BOUNDS_COUNTER_BINDING, _acCounterBufferId);
+
+    glGenQueries(1, &_timerQueryId);
+
+    printf("face tile benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the plane buffer, the distance field buffer, the atomic counter buffer, and the 
+    timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeFaceTileBenchmark::~ComputeFaceTileBenchmark()
+{
+    glDeleteBuffers(1, &_planeBufferId);
+    glDeleteBuffers(1, &_distanceFieldBufferId);
+    glDeleteBuffers(1, &_acCounterBufferId);
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times every way for every region and prints the results, one line per region.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeFaceTileBenchmark::Run() const
+{
+    size_t numRegions = sizeof(BENCHMARK_FACE_COUNTS) / sizeof(BENCHMARK_FACE_COUNTS[0]);
+    for (size_t regionCount = 0; regionCount < numRegions; regionCount++)
+    {
+        unsigned int numFaces = BENCHMARK_FACE_COUNTS[regionCount];
+        UploadCirclePlanes(numFaces);
+
+        glUseProgram(_untiledProgramId);
+        glUniform1ui(_unifLocUntiledFaceCount, numFaces);
+        glUseProgram(_tiledProgramId);
+        glUniform1ui(_unifLocTiledFaceCount, numFaces);
+        glUseProgram(0);
+
+        unsigned int untiledOut = 0;
+        double untiledMs = TimeDispatches(_untiledProgramId, &untiledOut);
+        unsigned int tiledOut = 0;
+        double tiledMs = TimeDispatches(_tiledProgramId, &tiledOut);
+
+        printf("polygon bounds check (%5u faces, %u out): every face = %.3f ms, face tiles = %.3f ms",
+            numFaces, untiledOut, untiledMs, tiledMs);
+        if (_distanceFieldProgramId != 0)
+        {
+            double bakeMs = BakeCircleDistanceField(numFaces);
+            glUseProgram(_distanceFieldProgramId);
+            glUniform1ui(_unifLocDistanceFieldFaceCount, numFaces);
+            glUseProgram(0);
+
+            unsigned int distanceFieldOut = 0;
+            double distanceFieldMs = TimeDispatches(_distanceFieldProgramId, &distanceFieldOut);
+            printf(", distance field = %.3f ms (%u out, bake %.1f ms)", distanceFieldMs, 
+                distanceFieldOut, bakeMs);
+        }
+        printf("\n");
+        if (tiledOut != untiledOut)
+        {
+            fprintf(stderr, "face tile benchmark error: face tiles counted %u out of bounds\n",
+                tiledOut);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Fills the benchmark's plane buffer with a circle of the given number of faces, laid out 
+    the same as PolygonSsbo's plane buffer (see polygonFacePlanes.glsl).  The faces go 
+    counterclockwise and their normals point out, same as the demo's region.
+Parameters:
+    numFaces    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeFaceTileBenchmark::UploadCirclePlanes(unsigned int numFaces) const
+{
+    std::vector<float> planes(3 * numFaces);
+    float radiansPerFace = 6.28318530718f / (float)numFaces;
+    for (unsigned int faceCount = 0; faceCount < numFaces; faceCount++)
+    {
+        float startRadians = (float)faceCount * radiansPerFace;
+        float startX = BENCHMARK_REGION_RADIUS * cosf(startRadians);
+        float startY = BENCHMARK_REGION_RADIUS * sinf(startRadians);
+        float endX = BENCHMARK_REGION_RADIUS * cosf(startRadians + radiansPerFace);
+        float endY = BENCHMARK_REGION_RADIUS * sinf(startRadians + radiansPerFace);
+
+        // the edge rotated -90 degrees
+        float normalX = endY - startY;
+        float normalY = -(endX - startX);
+        planes[(3 * faceCount) + 0] = normalX;
+        planes[(3 * faceCount) + 1] = normalY;
+        planes[(3 * faceCount) + 2] = (startX * normalX) + (startY * normalY);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _planeBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(float) * planes.size(), planes.data(), 
+        GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Bakes the same circle as UploadCirclePlanes(...) into a distance field on the CPU and 
+    uploads it into the benchmark's distance field buffer, laid out the same as 
+    PolygonDistanceFieldSsbo's (see polygonDistanceField.glsl).
+Parameters:
+    numFaces    Self-explanatory.
+Returns:
+    How long the baking took on the CPU, in milliseconds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeFaceTileBenchmark::BakeCircleDistanceField(unsigned int numFaces) const
+{
+    std::vector<PolygonFace> faces;
+    float radiansPerFace = 6.28318530718f / (float)numFaces;
+    for (unsigned int faceCount = 0; faceCount < numFaces; faceCount++)
+    {
+        float startRadians = (float)faceCount * radiansPerFace;
+        glm::vec2 start(BENCHMARK_REGION_RADIUS * cosf(startRadians), 
+            BENCHMARK_REGION_RADIUS * sinf(startRadians));
+        glm::vec2 end(BENCHMARK_REGION_RADIUS * cosf(startRadians + radiansPerFace), 
+            BENCHMARK_REGION_RADIUS * sinf(startRadians + radiansPerFace));
+
+        // the edge rotated -90 degrees
+        glm::vec2 normal = glm::normalize(glm::vec2(end.y - start.y, -(end.x - start.x)));
+        faces.push_back(PolygonFace(MyVertex(start, normal), MyVertex(end, normal)));
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    PolygonDistanceField distanceField;
+    Clock::time_point bakeStart = Clock::now();
+    distanceField.Bake(faces, _distanceFieldTexelsPerSide, _pThreadPool);
+    Clock::time_point bakeEnd = Clock::now();
+
+    const std::vector<float> &data = distanceField.GetDistances();
+    unsigned int headerBytes = sizeof(PolygonDistanceFieldHeader);
+    unsigned int dataBytes = sizeof(float) * data.size();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _distanceFieldBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, headerBytes + dataBytes, 0, GL_STATIC_DRAW);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, headerBytes, &distanceField.GetHeader());
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, headerBytes, dataBytes, data.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return std::chrono::duration<double, std::milli>(bakeEnd - bakeStart).count();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Summons the given benchmark shader NUM_DISPATCHES times in a row and waits for the GPU to
+    finish.
+Parameters:
+    computeProgramId    One of the versions of the benchmark shader.
+    outOfBoundsCount    The number of active particles that the shader found out of bounds.
+Returns:
+    The average GPU time of one dispatch, in milliseconds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeFaceTileBenchmark::TimeDispatches(unsigned int computeProgramId,
+    unsigned int *outOfBoundsCount) const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    // the counter adds up over all of the dispatches
+    GLuint acCounterValue = 0;
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCounterBufferId);
+    glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&acCounterValue);
+
+    glUseProgram(computeProgramId);
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int dispatchCount = 0; dispatchCount < NUM_DISPATCHES; dispatchCount++)
+    {
+        glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glUseProgram(0);
+
+    // asking for the result waits until the GPU is done
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &elapsedNs);
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&acCounterValue);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+    *outOfBoundsCount = acCounterValue / NUM_DISPATCHES;
+
+    return ((double)elapsedNs / 1000000.0) / NUM_DISPATCHES;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+
+class ThreadPool;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the polygon bounds check in particleBoundsBenchmark.comp two ways: every invocation 
+    reading every face out of the SSBO (the update shader's default) and the work group reading 
+    the faces into shared memory one tile at a time (polygonFaceTiles.glsl).  The same shader 
+    is built both ways, and both run on the live particle buffer, but they check the particles 
+    against their own regions: circles with more and more faces (4 up to 65536), so that the 
+    point where tiling starts to pay off can be found.
+
+    If given a third version of the shader, built with POLYGON_DISTANCE_FIELD, it also times 
+    the update shader's distance field check (see PolygonDistanceField), which should cost 
+    about the same for every face count.  Each region is baked into its own field for that.
+
+    Each Run() prints, for each face count, the GPU time per dispatch for each way, measured 
+    with a GL_TIME_ELAPSED query, and the out of bounds counts that each way came up with.  The 
+    face tiles' count must match.  The distance field's can be a little higher, because 
+    particles right next to a corner can come out "out" a little early.  The OpenGL renderer 
+    is printed on startup.
+
+    Note: Run() waits for the GPU to finish, and the biggest regions take many times longer 
+    than the rest of a frame, so it will make a big dent in the frame rate.  Only use it for 
+    measuring.
+
+    Note: This class is not concerned with the particle SSBO.  It must be configured for both 
+    compute shaders by its own object.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeFaceTileBenchmark
+{
+public:
+    ComputeFaceTileBenchmark(unsigned int numParticles, const std::string &untiledShaderKey,
+        const std::string &tiledShaderKey, 
+        const std::string &distanceFieldShaderKey = std::string(), 
+        unsigned int distanceFieldTexelsPerSide = 0, ThreadPool *pThreadPool = 0);
+    ~ComputeFaceTileBenchmark();
+
+    void Run() const;
+
+private:
+    void UploadCirclePlanes(unsigned int numFaces) const;
+    double BakeCircleDistanceField(unsigned int numFaces) const;
+    double TimeDispatches(unsigned int computeProgramId, unsigned int *outOfBoundsCount) const;
+
+    // each way is timed over this many dispatches
+    static const unsigned int NUM_DISPATCHES = 5;
+
+    unsigned int _totalParticleCount;
+    unsigned int _untiledProgramId;
+    unsigned int _tiledProgramId;
+    int _unifLocUntiledFaceCount;
+    int _unifLocTiledFaceCount;
+
+    // 0 if there is no distance field version of the shader
+    unsigned int _distanceFieldProgramId;
+    int _unifLocDistanceFieldFaceCount;
+    unsigned int _distanceFieldTexelsPerSide;
+    ThreadPool *_pThreadPool;
+
+    // the benchmark's own regions, so the demo's FacePlaneBuffer and DistanceFieldBuffer are 
+    // left alone
+    unsigned int _planeBufferId;
+    unsigned int _distanceFieldBufferId;
+    unsigned int _acCounterBufferId;
+    unsigned int _timerQueryId;
+};
@@ -0,0 +1,224 @@
+#include "ComputeParticleCollisionBenchmark.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include "ComputeParticleCollisions.h"
+#include "ParticleSsbo.h"
+#include "RandomStream.h"
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+#include "glm/geometric.hpp"
+
+// Note: The brute force shader's reference buffer is pointed at this in the constructor.
+static const unsigned int REFERENCE_BUFFER_BINDING = 27;
+
+// the particle counts that are timed, up to ComputeParticleCollisionBenchmark::
+// MAX_PARTICLE_COUNT
+static const unsigned int BENCHMARK_PARTICLE_COUNTS[] = { 1024, 16384, 131072, 1048576 };
+
+// the brute force is N^2 checks, so only counts up to this are checked against it
+static const unsigned int MAX_BRUTE_FORCE_PARTICLE_COUNT = 16384;
+
+// velocities can disagree by this much (relative to their size) from the order that the 
+// changes are added up in
+static const float VELOCITY_TOLERANCE = 1.0e-4f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Looks up the shaders and generates the reference buffer and the timer query.
+Parameters:
+    particleRadius      Self-explanatory.
+    keysShaderKey       particleCollisionKeys.comp
+    cellsShaderKey      particleCollisionCells.comp
+    resolveShaderKey    particleCollisionResolve.comp
+    bruteForceShaderKey particleCollisionBruteForce.comp
+    pPrimitives         Sorts the collision keys.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCollisionBenchmark::ComputeParticleCollisionBenchmark(float particleRadius,
+    const std::string &keysShaderKey, const std::string &cellsShaderKey,
+    const std::string &resolveShaderKey, const std::string &bruteForceShaderKey,
+    ComputePrimitives *pPrimitives) :
+    _particleRadius(particleRadius),
+    _keysShaderKey(keysShaderKey),
+    _cellsShaderKey(cellsShaderKey),
+    _resolveShaderKey(resolveShaderKey),
+    _pPrimitives(pPrimitives)
+{
+    _bruteForceProgramId = ShaderStorage::GetInstance().GetShaderProgram(bruteForceShaderKey);
+
+    // Note: Don't bother giving it an initial value.  The brute force writes all of it.
+    glGenBuffers(1, &_referenceBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _referenceBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * sizeof(GLfloat) * MAX_BRUTE_FORCE_PARTICLE_COUNT, 
+        0, GL_DYNAMIC_READ);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    GLuint ssboBlockIndex = glGetProgramResourceIndex(_bruteForceProgramId, 
+        GL_SHADER_STORAGE_BLOCK, "CollisionReferenceBuffer");
+    glShaderStorageBlockBinding(_bruteForceProgramId, ssboBlockIndex, REFERENCE_BUFFER_BINDING);
+
+    glGenQueries(1, &_timerQueryId);
+
+    printf("particle collision benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the reference buffer and the timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCollisionBenchmark::~ComputeParticleCollisionBenchmark()
+{
+    glDeleteBuffers(1, &_referenceBufferId);
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times every particle count and prints the results, one line per count.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisionBenchmark::Run() const
+{
+    size_t numCounts = sizeof(BENCHMARK_PARTICLE_COUNTS) / sizeof(BENCHMARK_PARTICLE_COUNTS[0]);
+    for (size_t countIndex = 0; countIndex < numCounts; countIndex++)
+    {
+        RunOnce(BENCHMARK_PARTICLE_COUNTS[countIndex]);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Scatters the given number of particles, times the build and the query (and the brute force 
+    if there aren't too many particles), and prints them.
+Parameters:
+    numParticles    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisionBenchmark::RunOnce(unsigned int numParticles) const
+{
+    // about one particle per cell
+    float cellSize = 2.0f * _particleRadius;
+    float halfWidth = 0.5f * sqrtf((float)numParticles) * cellSize;
+    std::vector<float> randomValues(4 * numParticles);
+    RandomStream randomStream(numParticles);
+    randomStream.FillBetween(randomValues.data(), 2 * numParticles, -halfWidth, 
+        2.0f * halfWidth);
+    randomStream.FillBetween(randomValues.data() + (2 * numParticles), 2 * numParticles, 
+        -0.5f, 1.0f);
+    std::vector<Particle> particles(numParticles);
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        Particle &p = particles[particleIndex];
+        p._position = glm::vec4(randomValues[(2 * particleIndex) + 0], 
+            randomValues[(2 * particleIndex) + 1], 0.0f, 1.0f);
+        p._velocity = glm::vec4(randomValues[(2 * numParticles) + (2 * particleIndex) + 0], 
+            randomValues[(2 * numParticles) + (2 * particleIndex) + 1], 0.0f, 0.0f);
+        p._isActive = 1;
+    }
+
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    ParticleSsbo particleBuffer;
+    particleBuffer.Init(particles, ParticleLayoutInfo(PARTICLE_LAYOUT_AOS, numParticles, 
+        glm::vec2(-halfWidth), glm::vec2(+halfWidth)));
+    particleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(_keysShaderKey));
+    particleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(_cellsShaderKey));
+    particleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(_resolveShaderKey));
+    particleBuffer.ConfigureCompute(_bruteForceProgramId);
+    ComputeParticleCollisions collisions(numParticles, _particleRadius, _keysShaderKey, 
+        _cellsShaderKey, _resolveShaderKey, _pPrimitives);
+    collisions.ConfigureCompute(_bruteForceProgramId);
+
+    // before the query changes the velocities
+    bool checkBruteForce = (numParticles <= MAX_BRUTE_FORCE_PARTICLE_COUNT);
+    GLuint64 bruteForceNs = 0;
+    if (checkBruteForce)
+    {
+        glUseProgram(_bruteForceProgramId);
+        glUniform1ui(glGetUniformLocation(_bruteForceProgramId, "uMaxParticleCount"), 
+            numParticles);
+        glUniform1f(glGetUniformLocation(_bruteForceProgramId, "uCollisionRadius"), 
+            _particleRadius);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, REFERENCE_BUFFER_BINDING, _referenceBufferId);
+        glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+        glDispatchCompute((numParticles / 256) + 1, 1, 1);
+        glEndQuery(GL_TIME_ELAPSED);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        glUseProgram(0);
+        glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &bruteForceNs);
+    }
+
+    // building doesn't change the particles, so it can be run over and over
+    GLuint64 buildNs = 0;
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int buildCount = 0; buildCount < NUM_BUILDS; buildCount++)
+    {
+        collisions.BuildCellTable();
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &buildNs);
+
+    GLuint64 queryNs = 0;
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    collisions.ResolveNeighbors();
+    glEndQuery(GL_TIME_ELAPSED);
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &queryNs);
+
+    double buildMs = ((double)buildNs / 1000000.0) / NUM_BUILDS;
+    double queryMs = (double)queryNs / 1000000.0;
+    if (!checkBruteForce)
+    {
+        printf("particle collisions (%7u particles): build = %.3f ms, query = %.3f ms\n",
+            numParticles, buildMs, queryMs);
+        return;
+    }
+
+    // compare every particle's velocity with the brute force's
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, particleBuffer.BufferId());
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(Particle) * numParticles, 
+        particles.data());
+    std::vector<glm::vec2> referenceVels(numParticles);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _referenceBufferId);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(glm::vec2) * numParticles, 
+        referenceVels.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    unsigned int numCollided = 0;
+    unsigned int numDisagreements = 0;
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        glm::vec2 vel(particles[particleIndex]._velocity);
+        glm::vec2 referenceVel = referenceVels[particleIndex];
+        float startSpeed = glm::length(glm::vec2(
+            randomValues[(2 * numParticles) + (2 * particleIndex) + 0], 
+            randomValues[(2 * numParticles) + (2 * particleIndex) + 1]));
+        float tolerance = VELOCITY_TOLERANCE * (1.0f + startSpeed + glm::length(referenceVel));
+        if (glm::length(vel - referenceVel) > tolerance)
+        {
+            numDisagreements++;
+        }
+        if (referenceVel.x != randomValues[(2 * numParticles) + (2 * particleIndex) + 0] ||
+            referenceVel.y != randomValues[(2 * numParticles) + (2 * particleIndex) + 1])
+        {
+            numCollided++;
+        }
+    }
+
+    printf("particle collisions (%7u particles, %u collided): build = %.3f ms, query = %.3f ms, brute force = %.3f ms\n",
+        numParticles, numCollided, buildMs, queryMs, (double)bruteForceNs / 1000000.0);
+    if (numDisagreements > 0)
+    {
+        fprintf(stderr, "particle collision benchmark error: %u velocities disagree with the brute force\n",
+            numDisagreements);
+    }
+}
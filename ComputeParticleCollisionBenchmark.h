@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+
+class ComputePrimitives;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the particle-particle collisions (see ComputeParticleCollisions) for more and more 
+    particles (1024 up to a little over a million) and checks their answers against checking 
+    every particle against every other one.
+
+    Each particle count gets its own particle buffer (array of structures) full of active 
+    particles scattered over a square that is sized so that there is about one particle per 
+    grid cell, which is crowded enough that lots of them touch.  Run() prints, for each count, 
+    the GPU time to build the cell table (hash, sort, and cell ranges) and to query it (check 
+    the neighbors and write the velocities), measured with a GL_TIME_ELAPSED query.  For the 
+    smaller counts it also times the O(N^2) brute force shader and prints how many particles' 
+    velocities disagree with it (only float rounding is allowed; they must be 0).  The OpenGL 
+    renderer is printed on startup.
+
+    Note: The brute force for the larger counts would take long enough to trip the driver's 
+    timeout, so it is skipped for them.
+
+    Note: The collision shaders must have been built with the array of structures layout's 
+    defines, and this class configures them for its own particle buffers.  Run it before the 
+    demo's particle buffer is set up, or configure the demo's shaders again afterwards.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleCollisionBenchmark
+{
+public:
+    ComputeParticleCollisionBenchmark(float particleRadius, const std::string &keysShaderKey,
+        const std::string &cellsShaderKey, const std::string &resolveShaderKey,
+        const std::string &bruteForceShaderKey, ComputePrimitives *pPrimitives);
+    ~ComputeParticleCollisionBenchmark();
+
+    void Run() const;
+
+    // the most particles that any run uses
+    static const unsigned int MAX_PARTICLE_COUNT = 1048576;
+
+private:
+    void RunOnce(unsigned int numParticles) const;
+
+    // the cell table build is timed over this many builds
+    static const unsigned int NUM_BUILDS = 5;
+
+    float _particleRadius;
+    std::string _keysShaderKey;
+    std::string _cellsShaderKey;
+    std::string _resolveShaderKey;
+    unsigned int _bruteForceProgramId;
+    ComputePrimitives *_pPrimitives;
+
+    unsigned int _referenceBufferId;
+    unsigned int _timerQueryId;
+};
@@ -0,0 +1,277 @@
+#include "ComputeParticleCollisions.h"
+
+#include "ComputePrimitives.h"
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// Note: The shaders' buffers are pointed at these bindings in ConfigureCompute(...).
+static const unsigned int KEY_BUFFER_BINDING = 23;
+static const unsigned int INDEX_BUFFER_BINDING = 24;
+static const unsigned int CELL_BUFFER_BINDING = 25;
+static const unsigned int SORTED_BUFFER_BINDING = 26;
+
+// the smallest table, so that a handful of particles still spread out
+static const unsigned int MIN_TABLE_SIZE = 1024;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sizes the table for the particle count, allocates the collision buffers, and points the 
+    collision shaders at them.
+Parameters:
+    numParticles        The size of the "all particles" buffer.  Every particle gets a spot in 
+                        the sort whether it is active or not.
+    particleRadius      Particles whose centers are closer than twice this are touching.  Also 
+                        decides the grid's cell size.
+    keysShaderKey       particleCollisionKeys.comp
+    cellsShaderKey      particleCollisionCells.comp
+    resolveShaderKey    particleCollisionResolve.comp
+    pPrimitives         Sorts the keys.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCollisions::ComputeParticleCollisions(unsigned int numParticles, 
+    float particleRadius, const std::string &keysShaderKey, const std::string &cellsShaderKey,
+    const std::string &resolveShaderKey, ComputePrimitives *pPrimitives)
+{
+    _totalParticleCount = numParticles;
+    _particleRadius = particleRadius;
+    _pPrimitives = pPrimitives;
+
+    // at least 2 slots per particle keeps most slots down to one cell's worth of particles
+    _tableSize = MIN_TABLE_SIZE;
+    _numKeyBits = 10;
+    while (_tableSize < (2 * numParticles))
+    {
+        _tableSize *= 2;
+        _numKeyBits++;
+    }
+
+    // one more bit for the "inactive" key, which is the table size
+    _numKeyBits++;
+
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    _keysProgramId = shaderStorageRef.GetShaderProgram(keysShaderKey);
+    _cellsProgramId = shaderStorageRef.GetShaderProgram(cellsShaderKey);
+    _resolveProgramId = shaderStorageRef.GetShaderProgram(resolveShaderKey);
+    ConfigureCompute(_keysProgramId);
+    ConfigureCompute(_cellsProgramId);
+    ConfigureCompute(_resolveProgramId);
+
+    // Note: Don't bother giving them initial values.  They are all written every frame.
+    glGenBuffers(1, &_keysBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _keysBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_indicesBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _indicesBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_cellsBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _cellsBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * sizeof(GLuint) * _tableSize, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_sortedBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _sortedBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 4 * sizeof(GLfloat) * numParticles, 0, 
+        GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the collision buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCollisions::~ComputeParticleCollisions()
+{
+    glDeleteBuffers(1, &_keysBufferId);
+    glDeleteBuffers(1, &_indicesBufferId);
+    glDeleteBuffers(1, &_cellsBufferId);
+    glDeleteBuffers(1, &_sortedBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Steps 1-3 in the class description: hashes the active particles, sorts them by slot, and 
+    fills in the cell table and the sorted copy of the particles.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::BuildCellTable() const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    BindBuffers();
+    UseProgram(_keysProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    _pPrimitives->SortKeyValue(_keysBufferId, _indicesBufferId, _totalParticleCount, 
+        _numKeyBits);
+
+    // only the slots that have particles are written, so the rest need to be [0, 0)
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _cellsBufferId);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // the sort's bindings don't overlap with these, but bind them again anyway in case 
+    // someone else's collisions were run in between
+    BindBuffers();
+    UseProgram(_cellsProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Step 4 in the class description: every active particle checks its neighbors in the cell 
+    table and writes its new velocity.  BuildCellTable() must have been called since the 
+    particles last moved.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::ResolveNeighbors() const
+{
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    BindBuffers();
+    UseProgram(_resolveProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does all of the steps in the class description.  Call it once per frame after the 
+    particles move.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::ResolveCollisions() const
+{
+    BuildCellTable();
+    ResolveNeighbors();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points whichever of the collision buffers the given program has at their bindings.  Done 
+    for the 3 collision shaders in the constructor, and any other shader that includes 
+    particleCollision.glsl (like the brute force reference) needs it too.
+Parameters:
+    computeProgramId    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::ConfigureCompute(unsigned int computeProgramId) const
+{
+    const char *blockNames[] = 
+    {
+        "CollisionKeyBuffer", "CollisionIndexBuffer", "CollisionCellBuffer", 
+        "CollisionSortedBuffer"
+    };
+    unsigned int blockBindings[] = 
+    {
+        KEY_BUFFER_BINDING, INDEX_BUFFER_BINDING, CELL_BUFFER_BINDING, SORTED_BUFFER_BINDING
+    };
+    for (size_t blockCount = 0; blockCount < 4; blockCount++)
+    {
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(computeProgramId, 
+            GL_SHADER_STORAGE_BLOCK, blockNames[blockCount]);
+        if (ssboBlockIndex != GL_INVALID_INDEX)
+        {
+            glShaderStorageBlockBinding(computeProgramId, ssboBlockIndex, 
+                blockBindings[blockCount]);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How many slots the hash table has.  Always a power of 2.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleCollisions::TableSize() const
+{
+    return _tableSize;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  After BuildCellTable(), holds every particle's slot in sorted order (TableSize() 
+    for inactive particles).
+Parameters: None
+Returns:
+    The buffer's ID.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleCollisions::KeyBufferId() const
+{
+    return _keysBufferId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  After BuildCellTable(), holds which particle is in each spot of the sorted order.
+Parameters: None
+Returns:
+    The buffer's ID.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleCollisions::IndexBufferId() const
+{
+    return _indicesBufferId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points the collision bindings at this object's buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::BindBuffers() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, KEY_BUFFER_BINDING, _keysBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INDEX_BUFFER_BINDING, _indicesBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CELL_BUFFER_BINDING, _cellsBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORTED_BUFFER_BINDING, _sortedBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds one of the collision shaders and gives it this object's uniforms.  They are set on 
+    every call because the benchmark runs several of these with the same shaders.
+
+    Note: The uniforms are not looked up through the shader storage because that complains 
+    when a uniform is missing, and not every collision shader uses every one of them.
+Parameters:
+    computeProgramId    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCollisions::UseProgram(unsigned int computeProgramId) const
+{
+    glUseProgram(computeProgramId);
+    glUniform1ui(glGetUniformLocation(computeProgramId, "uMaxParticleCount"), 
+        _totalParticleCount);
+    glUniform1f(glGetUniformLocation(computeProgramId, "uCollisionCellSize"), 
+        2.0f * _particleRadius);
+    glUniform1ui(glGetUniformLocation(computeProgramId, "uCollisionTableSize"), _tableSize);
+    glUniform1f(glGetUniformLocation(computeProgramId, "uCollisionRadius"), _particleRadius);
+}
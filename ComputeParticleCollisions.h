@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+
+class ComputePrimitives;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Bounces active particles off of each other.  Checking every particle against every other 
+    one is O(N^2), which is hopeless for a million particles, so the particles are put into a 
+    spatial hash (see particleCollision.glsl) and each one only checks the particles in its own 
+    grid cell and the 8 around it.  Each frame:
+    (1) particleCollisionKeys.comp: every particle gets its cell's slot in the table as a key
+    (2) the keys are radix sorted with the particles' indices as values (see 
+    ComputePrimitives::SortKeyValue(...)), which puts the particles in each slot next to each 
+    other
+    (3) particleCollisionCells.comp: the cell table gets where each slot's run of particles 
+    starts and ends, and the particles' positions and velocities are copied out in sorted order
+    (4) particleCollisionResolve.comp: every particle checks its neighbors and writes its new 
+    velocity to the particle buffer
+    The first 3 steps are "building" and the last is "querying" so that they can be timed 
+    separately (see ComputeParticleCollisionBenchmark), but ResolveCollisions() does all of 
+    them.
+
+    The table has at least twice as many slots as particles (rounded up to a power of 2), so 
+    the sort only needs enough key bits for that plus one more for the "inactive" key.
+
+    Note: Like the other compute classes, this class is not concerned with the particle SSBO.  
+    It must be configured for all 3 collision shaders by its own object.  The collision 
+    buffers, on the other hand, belong to this class, and they are bound to their bindings on 
+    every call so that more than one of these can be used at a time.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleCollisions
+{
+public:
+    ComputeParticleCollisions(unsigned int numParticles, float particleRadius,
+        const std::string &keysShaderKey, const std::string &cellsShaderKey,
+        const std::string &resolveShaderKey, ComputePrimitives *pPrimitives);
+    ~ComputeParticleCollisions();
+
+    void BuildCellTable() const;
+    void ResolveNeighbors() const;
+    void ResolveCollisions() const;
+
+    void ConfigureCompute(unsigned int computeProgramId) const;
+    unsigned int TableSize() const;
+    unsigned int KeyBufferId() const;
+    unsigned int IndexBufferId() const;
+
+private:
+    void BindBuffers() const;
+    void UseProgram(unsigned int computeProgramId) const;
+
+    unsigned int _totalParticleCount;
+    float _particleRadius;
+    unsigned int _tableSize;
+    unsigned int _numKeyBits;
+    ComputePrimitives *_pPrimitives;
+
+    unsigned int _keysProgramId;
+    unsigned int _cellsProgramId;
+    unsigned int _resolveProgramId;
+
+    unsigned int _keysBufferId;
+    unsigned int _indicesBufferId;
+    unsigned int _cellsBufferId;
+    unsigned int _sortedBufferId;
+};
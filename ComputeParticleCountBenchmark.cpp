@@ -0,0 +1,141 @@
+#include "ComputeParticleCountBenchmark.h"
+
+#include <stdio.h>
+
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets the particle count in both versions of the benchmark shader and generates the atomic
+    counters and the timer query.
+Parameters:
+    numParticles            Used to tell a shader uniform how big the "all particles" buffer
+                            is.
+    perInvocationShaderKey  The benchmark shader built with PER_INVOCATION_ATOMIC_COUNTERS.
+    workGroupShaderKey      The benchmark shader built without it.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCountBenchmark::ComputeParticleCountBenchmark(unsigned int numParticles,
+    const std::string &perInvocationShaderKey, const std::string &workGroupShaderKey)
+{
+    _totalParticleCount = numParticles;
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+
+    _perInvocationProgramId = shaderStorageRef.GetShaderProgram(perInvocationShaderKey);
+    glUseProgram(_perInvocationProgramId);
+    glUniform1ui(shaderStorageRef.GetUniformLocation(perInvocationShaderKey, "uMaxParticleCount"),
+        numParticles);
+
+    _workGroupProgramId = shaderStorageRef.GetShaderProgram(workGroupShaderKey);
+    glUseProgram(_workGroupProgramId);
+    glUniform1ui(shaderStorageRef.GetUniformLocation(workGroupShaderKey, "uMaxParticleCount"),
+        numParticles);
+
+    glUseProgram(0);
+
+    // Note: Don't bother giving them initial values.  They are reset before every timing.
+    glGenBuffers(1, &_acCountersBufferId);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCountersBufferId);
+    glBufferData(GL_ATOMIC_COUNTER_BUFFER, 2 * sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+    // Note: MUST be the same binding as declared in the shader.
+    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 1, _acCountersBufferId);
+
+    glGenQueries(1, &_timerQueryId);
+
+    printf("particle count benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the atomic counter buffer and the timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleCountBenchmark::~ComputeParticleCountBenchmark()
+{
+    glDeleteBuffers(1, &_acCountersBufferId);
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times both ways of counting and prints the results on one line.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleCountBenchmark::Run() const
+{
+    unsigned int perInvocationActive = 0;
+    unsigned int perInvocationInactive = 0;
+    double perInvocationMs = TimeDispatches(_perInvocationProgramId, &perInvocationActive,
+        &perInvocationInactive);
+
+    unsigned int workGroupActive = 0;
+    unsigned int workGroupInactive = 0;
+    double workGroupMs = TimeDispatches(_workGroupProgramId, &workGroupActive,
+        &workGroupInactive);
+
+    printf("particle counting (%u active, %u inactive): per invocation = %.3f ms, work group = %.3f ms\n",
+        perInvocationActive, perInvocationInactive, perInvocationMs, workGroupMs);
+    if (workGroupActive != perInvocationActive || workGroupInactive != perInvocationInactive)
+    {
+        fprintf(stderr, "particle count benchmark error: work group counts (%u active, %u inactive) don't match\n",
+            workGroupActive, workGroupInactive);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Summons the given benchmark shader NUM_DISPATCHES times in a row and waits for the GPU to
+    finish.
+Parameters:
+    computeProgramId    One of the two versions of the benchmark shader.
+    activeCount         The number of active particles that the shader counted.
+    inactiveCount       The number of inactive particles that the shader counted.
+Returns:
+    The average GPU time of one dispatch, in milliseconds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeParticleCountBenchmark::TimeDispatches(unsigned int computeProgramId,
+    unsigned int *activeCount, unsigned int *inactiveCount) const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    // the counters add up over all of the dispatches
+    GLuint acCounterValues[2] = { 0, 0 };
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCountersBufferId);
+    glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(acCounterValues), (void *)acCounterValues);
+
+    glUseProgram(computeProgramId);
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int dispatchCount = 0; dispatchCount < NUM_DISPATCHES; dispatchCount++)
+    {
+        glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glUseProgram(0);
+
+    // asking for the result waits until the GPU is done
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &elapsedNs);
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(acCounterValues), (void *)acCounterValues);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+    *activeCount = acCounterValues[0] / NUM_DISPATCHES;
+    *inactiveCount = acCounterValues[1] / NUM_DISPATCHES;
+
+    return ((double)elapsedNs / 1000000.0) / NUM_DISPATCHES;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the active particle counting in particleCountBenchmark.comp two ways: one atomic
+    counter operation per particle (the old way) and one per work group (workGroupCounter.glsl).
+    The same shader is built both ways, and both run on the live particle buffer, so the
+    number of active particles is whatever the demo has going at the time.
+
+    Each Run() prints the GPU time per dispatch for each way, measured with a GL_TIME_ELAPSED
+    query, and the counts that each way came up with, which must match.  The OpenGL renderer is
+    printed on startup so that runs on different drivers (ex: a software renderer like
+    llvmpipe vs. a GPU's driver) can be told apart.
+
+    Note: Run() waits for the GPU to finish, so it will make a dent in the frame rate.  Only
+    use it for measuring.
+
+    Note: This class is not concerned with the particle SSBO.  It must be configured for both
+    compute shaders by its own object.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleCountBenchmark
+{
+public:
+    ComputeParticleCountBenchmark(unsigned int numParticles,
+        const std::string &perInvocationShaderKey, const std::string &workGroupShaderKey);
+    ~ComputeParticleCountBenchmark();
+
+    void Run() const;
+
+private:
+    double TimeDispatches(unsigned int computeProgramId, unsigned int *activeCount,
+        unsigned int *inactiveCount) const;
+
+    // each way is timed over this many dispatches
+    static const unsigned int NUM_DISPATCHES = 20;
+
+    unsigned int _totalParticleCount;
+    unsigned int _perInvocationProgramId;
+    unsigned int _workGroupProgramId;
+
+    // the active and inactive counters are in the same buffer
+    unsigned int _acCountersBufferId;
+    unsigned int _timerQueryId;
+};
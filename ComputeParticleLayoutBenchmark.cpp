@@ -0,0 +1,166 @@
+#include "ComputeParticleLayoutBenchmark.h"
+
+#include <stdio.h>
+#include <vector>
+
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// not 3 (the demo's particles) or any of the other particle passes' buffers
+static const unsigned int PARTICLE_BUFFER_BINDING = 12;
+
+const float ComputeParticleLayoutBenchmark::DELTA_TIME_SEC = 0.01f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Builds the benchmark shader once per layout, points them all at the benchmark's particle
+    buffer, and generates that buffer and the timer query.
+Parameters:
+    liveLayoutInfo          The demo's particle buffer's layout.
+    liveParticleBufferId    The demo's particle buffer.  Only read.
+    quantizeMin             The bounds that the quantized layout packs positions into (see
+    quantizeMax             ParticleLayoutInfo).
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleLayoutBenchmark::ComputeParticleLayoutBenchmark(
+    const ParticleLayoutInfo &liveLayoutInfo, unsigned int liveParticleBufferId,
+    const glm::vec2 &quantizeMin, const glm::vec2 &quantizeMax) :
+    _liveLayoutInfo(liveLayoutInfo),
+    _liveParticleBufferId(liveParticleBufferId),
+    _quantizeMin(quantizeMin),
+    _quantizeMax(quantizeMax)
+{
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    for (int layout = 0; layout < PARTICLE_LAYOUT_COUNT; layout++)
+    {
+        ParticleLayoutInfo layoutInfo((ParticleLayout)layout, _liveLayoutInfo.NumParticles(),
+            _quantizeMin, _quantizeMax);
+        std::string shaderKey = std::string("compute particle layout benchmark ") +
+            layoutInfo.Name();
+        shaderStorageRef.NewShader(shaderKey);
+        shaderStorageRef.AddShaderFile(shaderKey, "particleLayoutBenchmark.comp",
+            GL_COMPUTE_SHADER, layoutInfo.ShaderDefines());
+        _programIds[layout] = shaderStorageRef.LinkShader(shaderKey);
+
+        glUseProgram(_programIds[layout]);
+        glUniform1ui(shaderStorageRef.GetUniformLocation(shaderKey, "uMaxParticleCount"),
+            layoutInfo.NumParticles());
+        glUniform1f(shaderStorageRef.GetUniformLocation(shaderKey, "uDeltaTimeSec"),
+            DELTA_TIME_SEC);
+
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(_programIds[layout],
+            GL_SHADER_STORAGE_BLOCK, "ParticleBuffer");
+        glShaderStorageBlockBinding(_programIds[layout], ssboBlockIndex,
+            PARTICLE_BUFFER_BINDING);
+    }
+    glUseProgram(0);
+
+    // Note: Don't bother giving it a size.  Each layout's particles are uploaded in Run().
+    glGenBuffers(1, &_particleBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, PARTICLE_BUFFER_BINDING, _particleBufferId);
+
+    glGenQueries(1, &_timerQueryId);
+
+    printf("particle layout benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the particle buffer and the timer query.  The shaders belong to ShaderStorage.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleLayoutBenchmark::~ComputeParticleLayoutBenchmark()
+{
+    glDeleteBuffers(1, &_particleBufferId);
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads the live particles back, then times every layout with them and prints the results,
+    one line per layout.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleLayoutBenchmark::Run() const
+{
+    // the particles may have just been written by a shader
+    unsigned int numBytes = _liveLayoutInfo.BufferSizeBytes();
+    std::vector<unsigned int> words(numBytes / sizeof(unsigned int));
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_COPY_READ_BUFFER, _liveParticleBufferId);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, numBytes, (void *)words.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    std::vector<Particle> allParticles;
+    _liveLayoutInfo.Unpack(words.data(), &allParticles);
+    unsigned int numActive = 0;
+    for (size_t particleIndex = 0; particleIndex < allParticles.size(); particleIndex++)
+    {
+        numActive += (allParticles[particleIndex]._isActive != 0) ? 1 : 0;
+    }
+
+    printf("particle layouts (%u of %u active, using %s):\n", numActive,
+        _liveLayoutInfo.NumParticles(), _liveLayoutInfo.Name());
+    for (int layout = 0; layout < PARTICLE_LAYOUT_COUNT; layout++)
+    {
+        ParticleLayoutInfo layoutInfo((ParticleLayout)layout, _liveLayoutInfo.NumParticles(),
+            _quantizeMin, _quantizeMax);
+        layoutInfo.Pack(allParticles, &words);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _particleBufferId);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, layoutInfo.BufferSizeBytes(), words.data(),
+            GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        double ms = TimeDispatches(_programIds[layout]);
+        float bytesPerParticle = layoutInfo.EstimateFrameBytesPerParticle(allParticles, 0);
+        float resetBytesPerParticle =
+            layoutInfo.EstimateFrameBytesPerParticle(allParticles, 1) - bytesPerParticle;
+
+        // bytes per millisecond / 1,000,000 = gigabytes per second
+        double gigabytesPerSec = (ms > 0.0) ?
+            ((double)bytesPerParticle * layoutInfo.NumParticles()) / (ms * 1000000.0) : 0.0;
+        printf("  %-14s %.3f ms per pass, %.1f bytes per particle (+%.1f with a separate reset pass), %.1f GB/s\n",
+            layoutInfo.Name(), ms, bytesPerParticle, resetBytesPerParticle, gigabytesPerSec);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Summons the given benchmark shader NUM_DISPATCHES times in a row and waits for the GPU to
+    finish.
+Parameters:
+    computeProgramId    The benchmark shader built for the layout that is in the buffer.
+Returns:
+    The average GPU time of one dispatch, in milliseconds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeParticleLayoutBenchmark::TimeDispatches(unsigned int computeProgramId) const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_liveLayoutInfo.NumParticles() / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    glUseProgram(computeProgramId);
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int dispatchCount = 0; dispatchCount < NUM_DISPATCHES; dispatchCount++)
+    {
+        glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glUseProgram(0);
+
+    // asking for the result waits until the GPU is done
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &elapsedNs);
+
+    return ((double)elapsedNs / 1000000.0) / NUM_DISPATCHES;
+}
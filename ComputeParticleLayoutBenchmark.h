@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ParticleLayout.h"
+#include "glm/vec2.hpp"
+#include <string>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the update shader's particle reads and writes (particleLayoutBenchmark.comp) with
+    every particle layout.  Each Run() copies the live particles into each layout in turn, in
+    a buffer of the benchmark's own, so the number of active particles is whatever the demo
+    has going at the time.
+
+    For each layout it prints:
+    - the GPU time per pass, measured with a GL_TIME_ELAPSED query
+    - the bytes moved per particle per pass, from
+    ParticleLayoutInfo::EstimateFrameBytesPerParticle(...), and how many more a separate reset
+    pass would add (the fused reset and update doesn't have one; see
+    BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE for a timing of that)
+    - the bandwidth that those bytes over that time come to
+
+    The shaders are built once per layout on startup.  The OpenGL renderer is printed too.
+
+    Note: Run() waits for the GPU to finish, so it will make a dent in the frame rate.  Only
+    use it for measuring.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleLayoutBenchmark
+{
+public:
+    ComputeParticleLayoutBenchmark(const ParticleLayoutInfo &liveLayoutInfo,
+        unsigned int liveParticleBufferId, const glm::vec2 &quantizeMin,
+        const glm::vec2 &quantizeMax);
+    ~ComputeParticleLayoutBenchmark();
+
+    void Run() const;
+
+private:
+    double TimeDispatches(unsigned int computeProgramId) const;
+
+    // each layout is timed over this many dispatches
+    static const unsigned int NUM_DISPATCHES = 20;
+
+    // same as the demo's fixed time step
+    static const float DELTA_TIME_SEC;
+
+    ParticleLayoutInfo _liveLayoutInfo;
+    unsigned int _liveParticleBufferId;
+    glm::vec2 _quantizeMin;
+    glm::vec2 _quantizeMax;
+    unsigned int _programIds[PARTICLE_LAYOUT_COUNT];
+
+    // every layout takes turns in this one (the sizes differ, so it is resized every time)
+    unsigned int _particleBufferId;
+    unsigned int _timerQueryId;
+};
@@ -0,0 +1,171 @@
+#include "ComputeParticleLiveList.h"
+
+#include <vector>
+
+#include "ComputePrimitives.h"
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// Note: The shaders' buffers are pointed at these bindings in ConfigureCompute(...).
+// Also Note: Not 3, 5, 6, or 7 (the other particle buffers).  Some drivers only have 32 
+// bindings, so use the free ones at the bottom.
+static const unsigned int LIST_BUFFER_BINDING = 8;
+static const unsigned int INDEX_BUFFER_BINDING = 9;
+static const unsigned int FLAG_BUFFER_BINDING = 10;
+
+// where the indirect dispatch arguments start in the list buffer (right after the count)
+static const unsigned int DISPATCH_ARGS_OFFSET_BYTES = sizeof(GLuint);
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Allocates the list's buffers (empty: every particle starts out inactive) and points the 
+    list's own shaders at them.
+Parameters:
+    numParticles    The size of the "all particles" buffer.  The list has room for all of them.
+    flagsShaderKey  particleLiveListFlags.comp
+    argsShaderKey   particleLiveListArgs.comp
+    pPrimitives     Compacts the flags into the list.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleLiveList::ComputeParticleLiveList(unsigned int numParticles, 
+    const std::string &flagsShaderKey, const std::string &argsShaderKey, 
+    ComputePrimitives *pPrimitives)
+{
+    _totalParticleCount = numParticles;
+    _pPrimitives = pPrimitives;
+
+    // count 0, and 0 x 1 x 1 work groups
+    GLuint listHeader[4] = { 0, 0, 1, 1 };
+    glGenBuffers(1, &_listBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _listBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(listHeader), listHeader, GL_DYNAMIC_COPY);
+
+    // Note: The indices don't need an initial value.  Only the first "count" are read.
+    glGenBuffers(1, &_indicesBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _indicesBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+
+    std::vector<GLuint> noFlags(numParticles, 0);
+    glGenBuffers(1, &_flagsBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _flagsBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, noFlags.data(), 
+        GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    _flagsProgramId = shaderStorageRef.GetShaderProgram(flagsShaderKey);
+    _argsProgramId = shaderStorageRef.GetShaderProgram(argsShaderKey);
+    ConfigureCompute(_flagsProgramId);
+    ConfigureCompute(_argsProgramId);
+
+    // this never changes, so set it once
+    glUseProgram(_flagsProgramId);
+    glUniform1ui(shaderStorageRef.GetUniformLocation(flagsShaderKey, "uMaxParticleCount"), 
+        numParticles);
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the list's buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleLiveList::~ComputeParticleLiveList()
+{
+    glDeleteBuffers(1, &_listBufferId);
+    glDeleteBuffers(1, &_indicesBufferId);
+    glDeleteBuffers(1, &_flagsBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Step 3 in the class description: rewrites the list from the flags and sizes the next 
+    update's dispatch.  Call it after every update.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleLiveList::Compact() const
+{
+    // the count goes right into the front of the list buffer
+    _pPrimitives->CompactIndices(_flagsBufferId, _indicesBufferId, _listBufferId, 
+        _totalParticleCount);
+
+    glUseProgram(_argsProgramId);
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sets every particle's flag from the particle buffer and compacts.  Call it whenever 
+    particles have been moved or (de)activated by something other than the reset and update 
+    shaders (ex: after ComputeParticleSort::Sort()).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleLiveList::Rebuild() const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    glUseProgram(_flagsProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    glUseProgram(0);
+
+    Compact();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Summons the currently bound compute program with one invocation for each particle in the 
+    list (rounded up to whole work groups of 256).  The number of work groups was written on 
+    the GPU, so the CPU doesn't know it and doesn't wait for it.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleLiveList::DispatchIndirect() const
+{
+    // the arguments were written by a shader (the reset's appends or the compaction)
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, _listBufferId);
+    glDispatchComputeIndirect(DISPATCH_ARGS_OFFSET_BYTES);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points the shader's live list buffers (whichever of them it has) at the list's bindings 
+    and binds the list's buffers there.
+Parameters:
+    computeProgramId    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleLiveList::ConfigureCompute(unsigned int computeProgramId) const
+{
+    const char *blockNames[] = { "LiveListBuffer", "LiveIndexBuffer", "LiveFlagBuffer" };
+    unsigned int bindings[] = { LIST_BUFFER_BINDING, INDEX_BUFFER_BINDING, FLAG_BUFFER_BINDING };
+    unsigned int bufferIds[] = { _listBufferId, _indicesBufferId, _flagsBufferId };
+    for (size_t blockCount = 0; blockCount < 3; blockCount++)
+    {
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(computeProgramId, 
+            GL_SHADER_STORAGE_BLOCK, blockNames[blockCount]);
+        if (ssboBlockIndex != GL_INVALID_INDEX)
+        {
+            glShaderStorageBlockBinding(computeProgramId, ssboBlockIndex, 
+                bindings[blockCount]);
+        }
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindings[blockCount], bufferIds[blockCount]);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+class ComputePrimitives;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps a dense list of the active ("live") particles' indices so that the update shader is 
+    only summoned for them instead of for every slot in the particle buffer.  With a mostly 
+    empty buffer, that is most of the update's work gone.
+
+    Each particle has a live flag (see particleLiveList.glsl).  Each frame:
+    (1) the reset shader sets the flags of the particles that it resets and appends them to 
+    the end of the list (and widens the update's dispatch to reach them)
+    (2) the update shader is dispatched indirectly over just the list, and clears the flags of 
+    the particles that die
+    (3) Compact(): the flags are compacted into the list again (ComputePrimitives::
+    CompactIndices(...)), which drops the dead particles and puts the live ones back in 
+    buffer order, and particleLiveListArgs.comp sizes the next update's dispatch from the new 
+    count
+    The CPU never needs to know how many particles are live.  The compaction still looks at 
+    every slot, but only at one flag each, while the update that it saves reads the particles 
+    and checks them against the region.
+
+    Rebuild() sets every flag from the particles themselves (particleLiveListFlags.comp) and 
+    then compacts.  That is for when the flags no longer match the particles (after the 
+    particle sort moves them around).
+
+    Note: Like the other compute classes, this class is not concerned with the particle SSBO.  
+    The list's buffers, on the other hand, belong to this class.  The reset and update shaders 
+    must be built with "#define PARTICLE_LIVE_LIST" and configured with ConfigureCompute(...).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleLiveList
+{
+public:
+    ComputeParticleLiveList(unsigned int numParticles, const std::string &flagsShaderKey,
+        const std::string &argsShaderKey, ComputePrimitives *pPrimitives);
+    ~ComputeParticleLiveList();
+
+    void Compact() const;
+    void Rebuild() const;
+    void DispatchIndirect() const;
+
+    void ConfigureCompute(unsigned int computeProgramId) const;
+
+private:
+    unsigned int _totalParticleCount;
+    ComputePrimitives *_pPrimitives;
+
+    unsigned int _flagsProgramId;
+    unsigned int _argsProgramId;
+
+    // the count and the indirect dispatch arguments, then the list, then a flag per particle
+    unsigned int _listBufferId;
+    unsigned int _indicesBufferId;
+    unsigned int _flagsBufferId;
+};
@@ -0,0 +1,129 @@
+#include "ComputeParticleRandomCheck.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "ParticleRandom.h"
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// not used by any of the particle passes' buffers
+static const unsigned int RANDOM_CHECK_BUFFER_BINDING = 4;
+
+// the first frames, a typical one, and the last one before the frame number wraps around
+static const unsigned int CHECK_FRAME_NUMBERS[] = { 0, 1, 2, 12345, 0xFFFFFFFF };
+
+// the first emitters and the largest index
+static const unsigned int CHECK_EMITTER_INDEXES[] = { 0, 1, 7, 0xFFFFFFFF };
+
+// both sides of a work group edge and a particle far into a big buffer
+static const unsigned int CHECK_PARTICLE_INDEXES[] = { 0, 1, 255, 256, 257, 999999, 0xFFFFFFFF };
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Builds the check's shader and points it at the check's buffer.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleRandomCheck::ComputeParticleRandomCheck()
+{
+    std::string shaderKey = "compute particle random check";
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    shaderStorageRef.NewShader(shaderKey);
+    shaderStorageRef.AddShaderFile(shaderKey, "particleRandomCheck.comp", GL_COMPUTE_SHADER);
+    _programId = shaderStorageRef.LinkShader(shaderKey);
+    _unifLocNumSamples = shaderStorageRef.GetUniformLocation(shaderKey, "uNumSamples");
+
+    GLuint ssboBlockIndex = glGetProgramResourceIndex(_programId, GL_SHADER_STORAGE_BLOCK,
+        "RandomCheckBuffer");
+    glShaderStorageBlockBinding(_programId, ssboBlockIndex, RANDOM_CHECK_BUFFER_BINDING);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Draws random numbers for every combination of CHECK_FRAME_NUMBERS, CHECK_EMITTER_INDEXES,
+    and CHECK_PARTICLE_INDEXES on the GPU, then draws the same ones with ParticleRandom and
+    compares them.  Prints the first mismatch (if any) and the result on one line.
+Parameters: None
+Returns:
+    True if every number matched, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputeParticleRandomCheck::Run() const
+{
+    // the keys go in first; the shader fills in the rest of each sample's entry
+    std::vector<unsigned int> data;
+    size_t numFrames = sizeof(CHECK_FRAME_NUMBERS) / sizeof(CHECK_FRAME_NUMBERS[0]);
+    size_t numEmitters = sizeof(CHECK_EMITTER_INDEXES) / sizeof(CHECK_EMITTER_INDEXES[0]);
+    size_t numParticles = sizeof(CHECK_PARTICLE_INDEXES) / sizeof(CHECK_PARTICLE_INDEXES[0]);
+    for (size_t frameCount = 0; frameCount < numFrames; frameCount++)
+    {
+        for (size_t emitterCount = 0; emitterCount < numEmitters; emitterCount++)
+        {
+            for (size_t particleCount = 0; particleCount < numParticles; particleCount++)
+            {
+                data.push_back(CHECK_FRAME_NUMBERS[frameCount]);
+                data.push_back(CHECK_EMITTER_INDEXES[emitterCount]);
+                data.push_back(CHECK_PARTICLE_INDEXES[particleCount]);
+                data.resize(data.size() + (STRIDE - 3), 0);
+            }
+        }
+    }
+    unsigned int numSamples = (unsigned int)(data.size() / STRIDE);
+
+    GLuint bufferId = 0;
+    glGenBuffers(1, &bufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * data.size(), data.data(),
+        GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, RANDOM_CHECK_BUFFER_BINDING, bufferId);
+
+    glUseProgram(_programId);
+    glUniform1ui(_unifLocNumSamples, numSamples);
+    glDispatchCompute((numSamples / 256) + 1, 1, 1);
+    glUseProgram(0);
+
+    std::vector<unsigned int> gpuData(data.size());
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferId);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * gpuData.size(),
+        gpuData.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, RANDOM_CHECK_BUFFER_BINDING, 0);
+    glDeleteBuffers(1, &bufferId);
+
+    unsigned int numMismatches = 0;
+    for (unsigned int sampleIndex = 0; sampleIndex < numSamples; sampleIndex++)
+    {
+        const unsigned int *pEntry = &gpuData[sampleIndex * STRIDE];
+        ParticleRandom random(pEntry[0], pEntry[1], pEntry[2]);
+        for (unsigned int drawCount = 0; drawCount < NUM_DRAWS; drawCount++)
+        {
+            // compare the floats as bits, same as the shader stored them
+            unsigned int expectedUint = random.NextUint();
+            float expectedFloat = random.NextOnRange0To1();
+            unsigned int expectedFloatBits = 0;
+            memcpy(&expectedFloatBits, &expectedFloat, sizeof(expectedFloatBits));
+
+            const unsigned int *pDraw = &pEntry[3 + (drawCount * 2)];
+            if (pDraw[0] != expectedUint || pDraw[1] != expectedFloatBits)
+            {
+                if (numMismatches == 0)
+                {
+                    printf("particle random check: first mismatch at frame %u, emitter %u, particle %u, draw %u: GPU 0x%08x 0x%08x, CPU 0x%08x 0x%08x\n",
+                        pEntry[0], pEntry[1], pEntry[2], drawCount, pDraw[0], pDraw[1],
+                        expectedUint, expectedFloatBits);
+                }
+                numMismatches++;
+            }
+        }
+    }
+
+    bool passed = (numMismatches == 0);
+    printf("particle random check (%u keys, %u draws each): %u mismatches: %s\n", numSamples,
+        NUM_DRAWS * 2, numMismatches, passed ? "PASSED" : "FAILED");
+    return passed;
+}
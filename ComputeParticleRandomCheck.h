@@ -0,0 +1,33 @@
+#pragma once
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks that the GPU's random numbers (particleRandom.glsl) are the same as ParticleRandom's
+    on the CPU, bit for bit.  Run() starts a stream for each sample (frame, emitter, particle)
+    key on both sides, draws from it with NextRandomUint(...) and RandomOnRange0To1(...) in
+    turn (particleRandomCheck.comp), and compares every number word for word.  The keys
+    include 0, the largest uint, and the indices at work group edges.
+
+    The CPU and GPU particle resets only make the same particles if this passes.
+
+    Note: Run() waits for the GPU and reads a buffer back, so only use this at startup.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleRandomCheck
+{
+public:
+    ComputeParticleRandomCheck();
+
+    bool Run() const;
+
+private:
+    // each sample's stream is drawn from this many times with each function
+    // Note: Must match particleRandomCheck.comp.
+    static const unsigned int NUM_DRAWS = 8;
+
+    // the key (3 words), then the draws (2 words each)
+    static const unsigned int STRIDE = 3 + (2 * NUM_DRAWS);
+
+    unsigned int _programId;
+    int _unifLocNumSamples;
+};
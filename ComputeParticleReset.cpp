@@ -5,45 +5,61 @@
 #include "glload/include/glload/gl_4_4.h"
 #include "glm/gtc/type_ptr.hpp"
 
-// for starting up the atomic counter for the compute shader's rand hash
-#include <random>
-#include <time.h>
-
-
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Generates atomic counters for use in the "particle reset" compute shader.
-    Looks up all uniforms in the compute shader.
+    Generates the atomic counter and the emitter SSBO for use in the "particle reset" compute 
+    shader.  Looks up all uniforms in the compute shader.
 
     Note: This constructor takes a string key for the compute shader instead of a program ID 
     because the shader storage object, which is responsible for finding uniforms, takes a shader 
     key instead of a direct program ID.
 Parameters: 
-    numParticles        Used to tell the compute shader how many are in the particle buffer.
-    computeShaderKey    Used to look up (1) the compute shader ID and (2) uniform locations.
+    numParticles            Used to tell the compute shader how many are in the particle buffer.
+    computeShaderKey        Used to look up (1) the compute shader ID and (2) uniform locations.
+    pDeadList               Optional.  If provided, resets are taken off of this dead list.
+    deadListPopShaderKey    Required with pDeadList.  The "dead list pop" compute shader.
 Returns:    None
 Creator:    John Cox (11-24-2016)
 -----------------------------------------------------------------------------------------------*/
 ComputeParticleReset::ComputeParticleReset(unsigned int numParticles, 
-    const std::string &computeShaderKey)
+    const std::string &computeShaderKey, const ParticleDeadListSsbo *pDeadList,
+    const std::string &deadListPopShaderKey) :
+    _frameNumber(0),
+    _deadListBufferId(0),
+    _deadListPopProgramId(0),
+    _unifLocMaxParticleEmitCount(-1),
+    _unifLocDeadListPopMaxParticleEmitCount(-1)
 {
     _totalParticleCount = numParticles;
     ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
     
     // find the uniforms in the "reset" compute shader
+    // Note: With a dead list, the spawn budget is enforced by the "dead list pop" shader instead.
     _unifLocParticleCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleCount");
-    _unifLocMaxParticleEmitCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleEmitCount");
-    _unifLocMinParticleVelocity = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMinParticleVelocity");
-    _unifLocDeltaParticleVelocity = shaderStorageRef.GetUniformLocation(computeShaderKey, "uDeltaParticleVelocity");
-    _unifLocUsePointEmitter = shaderStorageRef.GetUniformLocation(computeShaderKey, "uUsePointEmitter");
-    _unifLocPointEmitterCenter = shaderStorageRef.GetUniformLocation(computeShaderKey, "uPointEmitterCenter");
-    _unifLocBarEmitterP1 = shaderStorageRef.GetUniformLocation(computeShaderKey, "uBarEmitterP1");
-    _unifLocBarEmitterP2 = shaderStorageRef.GetUniformLocation(computeShaderKey, "uBarEmitterP2");
-    _unifLocBarEmitterEmitDir = shaderStorageRef.GetUniformLocation(computeShaderKey, "uBarEmitterEmitDir");
+    if (pDeadList != 0)
+    {
+        _deadListBufferId = pDeadList->BufferId();
+        _deadListPopProgramId = shaderStorageRef.GetShaderProgram(deadListPopShaderKey);
+        _unifLocDeadListPopMaxParticleEmitCount = shaderStorageRef.GetUniformLocation(deadListPopShaderKey, "uMaxParticleEmitCount");
+    }
+    else
+    {
+        _unifLocMaxParticleEmitCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleEmitCount");
+    }
+    _unifLocNumEmitters = shaderStorageRef.GetUniformLocation(computeShaderKey, "uNumEmitters");
+    _unifLocFrameNumber = shaderStorageRef.GetUniformLocation(computeShaderKey, "uFrameNumber");
 
     // now set up the atomic counters
     _computeProgramId = shaderStorageRef.GetShaderProgram(computeShaderKey);
 
+    // not looked up through the shader storage because that complains when a uniform is 
+    // missing, and this one is only there with GPU transforms
+    _unifLocEmitterTransform = glGetUniformLocation(_computeProgramId, "uEmitterTransform");
+
+    // the emitters are uploaded on every call to ResetParticles(...)
+    _emitterBuffer.Init();
+    _emitterBuffer.ConfigureCompute(_computeProgramId);
+
     glUseProgram(_computeProgramId);
 
     // the program in which this uniform is located must be bound in order to set the value
@@ -61,23 +77,14 @@ ComputeParticleReset::ComputeParticleReset(unsigned int numParticles,
     glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
     glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
 
-    // starting up the random hash counter
-    // Note: This value is also updated on every call to ResetParticles(...), so don't give it 
-    // an initial value.  DO seed random though.
-    srand(time(0));
-    glGenBuffers(1, &_acRandSeed);
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acRandSeed);
-    glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
-
-    glUseProgram(_computeProgramId);
+    // cleanup
+    glUseProgram(0);
 
     // don't need to have a program or bound buffer to set the buffer base
     // Note: It seems that atomic counters must be bound where they are declared and cannot be 
     // bound dynamically like the ParticleSsbo and PolygonSsbo.  So remember to use the SAME buffer 
     // binding base as specified in the shader.
     glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 3, _acParticleCounterBufferId);
-    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 4, _acRandSeed);
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -90,14 +97,12 @@ Creator:    John Cox (11-24-2016)
 ComputeParticleReset::~ComputeParticleReset()
 {
     glDeleteBuffers(1, &_acParticleCounterBufferId);
-    glDeleteBuffers(1, &_acRandSeed);
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Adds a point emitter to internal storage.  This is used to initialize particles.  If there 
-    multiple emitters, then the update will need to perform multiple calls to the compute 
-    shader, each with different emitter information.
+    Adds a point emitter to internal storage.  This is used to initialize particles.  All 
+    emitters are handled by the same call to the compute shader (see ResetParticles(...)).
 
     If, for some reason, the particle emitter cannot be cast to either a point emitter or a bar 
     emitter, then the emitter will not be added to either particle emitter collection and 
@@ -131,16 +136,34 @@ bool ComputeParticleReset::AddEmitter(const IParticleEmitter *pEmitter)
     return false;
 }
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    For a shader built with "#define GPU_TRANSFORMS".  The emitters are uploaded untransformed 
+    (their SetTransform(...) is never called), and the shader moves each emitter with this as 
+    it reads it.  The emitter SSBO then has the same contents every frame and is only uploaded 
+    once (see ParticleEmitterSsbo::UpdateValues(...)).
+Parameters:
+    emitterTransform    Where the emitters are this frame.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleReset::SetEmitterTransform(const glm::mat4 &emitterTransform)
+{
+    _emitterTransform = emitterTransform;
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     All the particle emitters reset particles to that emitter's location (up to a limit).
 
     Particles are spread out evenly between all the emitters (or at least as best as possible; 
     technically the first emitter emitter gets first dibs at the inactive particles, then the 
-    second emitter gets second dibs, etc.).  This caused some trouble because successive calls 
-    to the compute shader in the same frame caused many particles to have their positions 
-    updated more than once.  To solve this, the compute shader was split into two major 
-    sections: 
+    second emitter gets second dibs, etc.).  This used to be one call to the compute shader per 
+    emitter, each with its own uniforms, counter reset, and memory barrier, and every call had 
+    to wait on the one before it.  Now every emitter is uploaded into the emitter SSBO and 
+    given a range of "spawn slots".  The ranges are laid end to end (an exclusive prefix sum of 
+    each emitter's spawn count), so a single call to the compute shader can hand out slots 
+    with one atomic counter and each reset can find its emitter by slot.
 Parameters:    
     particlesPerEmitterPerFrame        Limits the number of particles that are reset per frame so 
     that they don't all spawn at once.
@@ -150,92 +173,106 @@ Creator:    John Cox (10-10-2016)
 -----------------------------------------------------------------------------------------------*/
 void ComputeParticleReset::ResetParticles(unsigned int particlesPerEmitterPerFrame)
 {
-    if (_pointEmitters.empty() || _barEmitters.empty())
+    if (_pointEmitters.empty() && _barEmitters.empty())
     {
         // nothing to do
         return;
     }
 
-    GLuint acResetCounterValue = 0;
-
-    // spreading the particles evenly between multiple emitters is done by letting all the 
-    // particle emitters have a go at all the inactive particles one by one, so all particles 
-    // must be considered
-    // Note: Yes, this algorithm is such that emitters resetting particles have to traverse 
-    // through the entire particle collection, but since there isn't a way of telling the CPU 
-    // where they were when the last particle was reset and since the GPU seems pretty fast on 
-    // running through the entire array, this algorithm is fine.
+    // every emitter goes into the emitter SSBO with its own range of spawn slots
+    unsigned int totalSpawnCount = _emitterBuffer.UpdateValues(_pointEmitters, _barEmitters, 
+        particlesPerEmitterPerFrame);
+    GLuint numEmitters = (GLuint)(_pointEmitters.size() + _barEmitters.size());
+
+    // find the inactive particles by looking at all of them (unless there is a dead list, in 
+    // which case this is ignored and the dispatch is sized on the GPU)
+    // Note: Yes, this algorithm is such that resetting particles has to traverse through the 
+    // entire particle collection, but since there isn't a way of telling the CPU where they 
+    // were when the last particle was reset and since the GPU seems pretty fast on running 
+    // through the entire array, this algorithm is fine.
     GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
     GLuint numWorkGroupsY = 1;
     GLuint numWorkGroupsZ = 1;
 
     glUseProgram(_computeProgramId);
 
-    // give the rand seed some variance from the last frame
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acRandSeed);
-    GLuint acRandSeed = rand();
-    glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), (void *)&_acRandSeed, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+    // every frame gets different random numbers
+    _frameNumber++;
+    glUniform1ui(_unifLocFrameNumber, _frameNumber);
+    glUniformMatrix4fv(_unifLocEmitterTransform, 1, GL_FALSE, glm::value_ptr(_emitterTransform));
 
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acParticleCounterBufferId);
-    glUniform1ui(_unifLocMaxParticleEmitCount, particlesPerEmitterPerFrame);
-
-    // give all point emitters a chance to reactive inactive particles at their positions
-    glUniform1ui(_unifLocUsePointEmitter, 1);
-    for (size_t pointEmitterCount = 0; pointEmitterCount < _pointEmitters.size(); pointEmitterCount++)
+    if (_deadListBufferId != 0)
+    {
+        // the pop shader enforces the spawn budget
+        glUseProgram(_deadListPopProgramId);
+        glUniform1ui(_unifLocDeadListPopMaxParticleEmitCount, totalSpawnCount);
+        glUseProgram(_computeProgramId);
+    }
+    else
     {
-        // reset everything necessary to control the emission parameters for this emitter
-        glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&acResetCounterValue);
+        glUniform1ui(_unifLocMaxParticleEmitCount, totalSpawnCount);
+    }
+    glUniform1ui(_unifLocNumEmitters, numEmitters);
 
-        const ParticleEmitterPoint *emitter = _pointEmitters[pointEmitterCount];
-        glUniform1f(_unifLocMinParticleVelocity, emitter->GetMinVelocity());
-        glUniform1f(_unifLocDeltaParticleVelocity, emitter->GetDeltaVelocity());
+    // the spawn slots start at 0 every frame
+    GLuint acResetCounterValue = 0;
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acParticleCounterBufferId);
+    glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&acResetCounterValue);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
 
-        // use an array for uploading vectors to be certain of the ordering 
-        glm::vec4 emitterPos = emitter->GetPos();
-        float emitterPosArr[4] = { emitterPos.x, emitterPos.y, emitterPos.z, emitterPos.w };
-        glUniform4fv(_unifLocPointEmitterCenter, 1, emitterPosArr);
+    // compute ALL the resets!
+    // Note: The emitter upload doesn't need a barrier.  Buffer uploads are ordered with later 
+    // commands.
+    DispatchResetPass(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 
-        // compute ALL the resets!
-        glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    // tell the GPU:
+    // (1) Accesses to the shader buffer after this call will reflect writes prior to the 
+    // barrier.  This is only available in OpenGL 4.3 or higher.
+    // (2) Vertex data sourced from buffer objects after the barrier will reflect data 
+    // written by shaders prior to the barrier.  The affected buffer(s) is determined by the 
+    // buffers that were bound for the vertex attributes.  In this case, that means 
+    // GL_ARRAY_BUFFER.
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 
-        // tell the GPU:
-        // (1) Accesses to the shader buffer after this call will reflect writes prior to the 
-        // barrier.  This is only available in OpenGL 4.3 or higher.
-        // (2) Vertex data sourced from buffer objects after the barrier will reflect data 
-        // written by shaders prior to the barrier.  The affected buffer(s) is determined by the 
-        // buffers that were bound for the vertex attributes.  In this case, that means 
-        // GL_ARRAY_BUFFER.
-        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
-    }
+    // cleanup
+    glUseProgram(0);
+}
 
-    // repeat for any bar emitters
-    glUniform1ui(_unifLocUsePointEmitter, 0);
-    for (size_t barEmitterCount = 0; barEmitterCount < _barEmitters.size(); barEmitterCount++)
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Summons the reset shader for every emitter.  The emitter SSBO and uniforms must already be 
+    set.
+
+    Without a dead list, the reset shader runs over the whole particle buffer.  With one, the 
+    "dead list pop" shader first takes the frame's share of inactive particles off the dead 
+    list and writes the number of work groups to summon into the dead list buffer itself, and 
+    the reset shader is then dispatched indirectly from there.  The CPU never needs to know how 
+    many particles were actually reset.
+Parameters:
+    numWorkGroupsX  Self-explanatory.  Only used if there is no dead list.
+    numWorkGroupsY  Same.
+    numWorkGroupsZ  Same.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleReset::DispatchResetPass(unsigned int numWorkGroupsX, 
+    unsigned int numWorkGroupsY, unsigned int numWorkGroupsZ) const
+{
+    if (_deadListBufferId == 0)
     {
-        glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&acResetCounterValue);
-
-        const ParticleEmitterBar *emitter = _barEmitters[barEmitterCount];
-        glUniform1f(_unifLocMinParticleVelocity, emitter->GetMinVelocity());
-        glUniform1f(_unifLocDeltaParticleVelocity, emitter->GetDeltaVelocity());
-
-        // each bar has three vectors that need to be uploaded (p1, p2, and emit direction)
-        glm::vec4 emitterBarP1 = emitter->GetBarStart();
-        glm::vec4 emitterBarP2 = emitter->GetBarEnd();
-        glm::vec4 emitDir = emitter->GetEmitDir();
-        float emitterBarP1Arr[4] = { emitterBarP1.x, emitterBarP1.y, emitterBarP1.z, emitterBarP1.w };
-        float emitterBarP2Arr[4] = { emitterBarP2.x, emitterBarP2.y, emitterBarP2.z, emitterBarP2.w };
-        float emitterBarEmitDir[4] = { emitDir.x, emitDir.y, emitDir.y, emitDir.z };
-        glUniform4fv(_unifLocBarEmitterP1, 1, emitterBarP1Arr);
-        glUniform4fv(_unifLocBarEmitterP2, 1, emitterBarP2Arr);
-        glUniform4fv(_unifLocBarEmitterEmitDir, 1, emitterBarEmitDir);
-
-        // MOAR resets!
         glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
-        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+        return;
     }
 
-    // cleanup
-    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
-    glUseProgram(0);
+    glUseProgram(_deadListPopProgramId);
+    glDispatchCompute(1, 1, 1);
+
+    // the reset shader reads what the pop shader wrote, and so does the indirect dispatch 
+    // ("command" barrier bit)
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    glUseProgram(_computeProgramId);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, _deadListBufferId);
+    glDispatchComputeIndirect(0);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
 }
@@ -3,6 +3,9 @@
 #include "IParticleEmitter.h"
 #include "ParticleEmitterPoint.h"
 #include "ParticleEmitterBar.h"
+#include "ParticleDeadListSsbo.h"
+#include "ParticleEmitterSsbo.h"
+#include "glm/mat4x4.hpp"
 #include <string>
 #include <vector>
 
@@ -16,6 +19,15 @@ Description:
     Note: This class is not concerned with the particle SSBO.  It is concerned with uniforms and 
     summoning the shader.  SSBO setup is performed in the appropriate SSBO object.
 
+    Every emitter is uploaded into an emitter SSBO (see ParticleEmitterSsbo) once per frame, 
+    and a single reset pass handles all of them.
+
+    If given a dead list (see ParticleDeadListSsbo), the reset pass only summons the reset 
+    shader for the particles that it will reset (popped off the dead list by the "dead list 
+    pop" shader, with an indirect dispatch).  Otherwise the reset pass runs over every 
+    particle to find the inactive ones.  The reset shader must be built with 
+    "#define PARTICLE_DEAD_LIST" to match.
+
     Note: When this class goes "poof", it won't delete the emitter pointers.  This is ensured by
     only using const pointers.
 Creator:    John Cox (11-24-2016)
@@ -23,43 +35,57 @@ Creator:    John Cox (11-24-2016)
 class ComputeParticleReset
 {
 public:
-    ComputeParticleReset(unsigned int numParticles, const std::string &computeShaderKey);
+    ComputeParticleReset(unsigned int numParticles, const std::string &computeShaderKey,
+        const ParticleDeadListSsbo *pDeadList = 0, 
+        const std::string &deadListPopShaderKey = std::string());
     ~ComputeParticleReset();
 
     bool AddEmitter(const IParticleEmitter *pEmitter);
+    void SetEmitterTransform(const glm::mat4 &emitterTransform);
 
     void ResetParticles(unsigned int particlesPerEmitterPerFrame);
 
 private:
+    void DispatchResetPass(unsigned int numWorkGroupsX, unsigned int numWorkGroupsY,
+        unsigned int numWorkGroupsZ) const;
+
     unsigned int _totalParticleCount;
     unsigned int _computeProgramId;
 
-    // the atomic counter is used to enforce the number of emitted particles per emitter per 
-    // frame 
+    // the atomic counter is used to enforce the number of emitted particles per frame and to 
+    // hand out spawn slots
     unsigned int _acParticleCounterBufferId;
 
-    // another atomic counter is used as a seed for the random hash
-    // Note: Rather than needing to seed the position and velocity as I did in the 
-    // "single emitter" project, use an atomic counter.  If it reaches maximum unsigned int, 
-    // that is ok.  The value will wrap around to 0 and begin again.  
-    unsigned int _acRandSeed;
+    // part of the key for the random numbers (see particleRandom.glsl)
+    // Note: Counted the same way as CpuParticleReset's so that both make the same particles.  
+    // If it reaches maximum unsigned int, that is ok.  The value will wrap around to 0 and 
+    // begin again.
+    unsigned int _frameNumber;
+
+    // 0 if there is no dead list
+    unsigned int _deadListBufferId;
+    unsigned int _deadListPopProgramId;
 
     // unlike most OpenGL IDs, uniform locations are GLint
     int _unifLocParticleCount;
     int _unifLocMaxParticleEmitCount;
-    int _unifLocMinParticleVelocity;
-    int _unifLocDeltaParticleVelocity;
-    int _unifLocUsePointEmitter;
-    int _unifLocPointEmitterCenter;
-    int _unifLocBarEmitterP1;
-    int _unifLocBarEmitterP2;
-    int _unifLocBarEmitterEmitDir;
+    int _unifLocNumEmitters;
+    int _unifLocFrameNumber;
+    int _unifLocDeadListPopMaxParticleEmitCount;
+
+    // only in the shader if it was built with "#define GPU_TRANSFORMS" (otherwise -1, and 
+    // OpenGL ignores uniform values for location -1)
+    int _unifLocEmitterTransform;
+    glm::mat4 _emitterTransform;
+
+    // every emitter's position, velocity, and share of the frame's resets
+    ParticleEmitterSsbo _emitterBuffer;
 
     // all the updating heavy lifting goes on in the compute shader, so CPU cache coherency is 
     // not a concern for emitter storage on the CPU side and a std::vector<...> is acceptable
     // Note: The compute shader has no concept of inheritance.  Rather than store a single 
     // collection of IParticleEmitter pointers and cast them to either point or bar emitters on 
-    // every update, just store them separately.
+    // every update, just store them separately (the emitter SSBO flattens them).
     static const int MAX_EMITTERS = 4;
     std::vector<const ParticleEmitterPoint *> _pointEmitters;
     std::vector<const ParticleEmitterBar *> _barEmitters;
@@ -0,0 +1,239 @@
+#include "ComputeParticleResetAndUpdate.h"
+
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+#include "glm/matrix.hpp"     // for glm::inverse(...)
+#include "glm/gtc/type_ptr.hpp"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the atomic counters and the emitter SSBO for use in the "particle reset and
+    update" compute shader.  Looks up all uniforms in the compute shader.
+
+    Note: This constructor takes a string key for the compute shader instead of a program ID
+    because the shader storage object, which is responsible for finding uniforms, takes a shader
+    key instead of a direct program ID.
+Parameters:
+    numParticles        Used to tell a shader uniform how big the "all particles" buffer is.
+    numFaces            Used to tell a shader uniform how many polygon faces are in play.
+    computeShaderKey    Used to look up (1) the compute shader ID and (2) uniform locations.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleResetAndUpdate::ComputeParticleResetAndUpdate(unsigned int numParticles,
+    unsigned int numFaces, const std::string &computeShaderKey) :
+    _spawnBudget(0),
+    _frameNumber(0)
+{
+    _totalParticleCount = numParticles;
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+
+    _unifLocParticleCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleCount");
+    _unifLocPolygonFaceCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uPolygonFaceCount");
+    _unifLocDeltaTimeSec = shaderStorageRef.GetUniformLocation(computeShaderKey, "uDeltaTimeSec");
+    _unifLocNumSubSteps = shaderStorageRef.GetUniformLocation(computeShaderKey, "uNumSubSteps");
+    _unifLocMaxParticleEmitCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleEmitCount");
+    _unifLocNumEmitters = shaderStorageRef.GetUniformLocation(computeShaderKey, "uNumEmitters");
+    _unifLocFrameNumber = shaderStorageRef.GetUniformLocation(computeShaderKey, "uFrameNumber");
+
+    _computeProgramId = shaderStorageRef.GetShaderProgram(computeShaderKey);
+
+    // only there with GPU transforms (see ComputeParticleUpdate's constructor)
+    _unifLocEmitterTransform = glGetUniformLocation(_computeProgramId, "uEmitterTransform");
+    _unifLocInverseRegionTransform = glGetUniformLocation(_computeProgramId, "uInverseRegionTransform");
+
+    glUseProgram(_computeProgramId);
+
+    // the program in which this uniform is located must be bound in order to set the value
+    glUniform1ui(_unifLocParticleCount, numParticles);
+    glUniform1ui(_unifLocPolygonFaceCount, numFaces);
+    // everything else is set per frame
+
+    // the emitters are uploaded on every call to ResetParticles(...)
+    _emitterBuffer.Init();
+    _emitterBuffer.ConfigureCompute(_computeProgramId);
+
+    // the atomic counters
+    // Note: Don't bother giving them initial values.  They are all set on every call to
+    // Update(...).
+    glGenBuffers(1, &_acCountersBufferId);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCountersBufferId);
+    glBufferData(GL_ATOMIC_COUNTER_BUFFER, 2 * sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+    _activeCountReadback.Init();
+
+    // cleanup
+    glUseProgram(0);
+
+    // Note: MUST be the same binding as declared in the shader.
+    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 2, _acCountersBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up buffers that were allocated in this object.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleResetAndUpdate::~ComputeParticleResetAndUpdate()
+{
+    glDeleteBuffers(1, &_acCountersBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ComputeParticleReset::AddEmitter(...).
+Parameters:
+    pEmitter    A pointer to a "particle emitter" interface.
+Returns:
+    True if the emitter was added, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputeParticleResetAndUpdate::AddEmitter(const IParticleEmitter *pEmitter)
+{
+    const ParticleEmitterPoint *pointEmitter =
+        dynamic_cast<const ParticleEmitterPoint *>(pEmitter);
+    const ParticleEmitterBar *barEmitter =
+        dynamic_cast<const ParticleEmitterBar *>(pEmitter);
+
+    if (pointEmitter != 0 && (_pointEmitters.size() < MAX_EMITTERS))
+    {
+        _pointEmitters.push_back(pointEmitter);
+        return true;
+    }
+    else if (barEmitter != 0 && (_barEmitters.size() < MAX_EMITTERS))
+    {
+        _barEmitters.push_back(barEmitter);
+        return true;
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ComputeParticleReset::SetEmitterTransform(...).
+Parameters:
+    emitterTransform    Where the emitters are this frame.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdate::SetEmitterTransform(const glm::mat4 &emitterTransform)
+{
+    _emitterTransform = emitterTransform;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as ComputeParticleUpdate::SetRegionTransform(...).
+Parameters:
+    regionTransform     Where the region is this frame.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdate::SetRegionTransform(const glm::mat4 &regionTransform)
+{
+    _inverseRegionTransform = glm::inverse(regionTransform);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Uploads every emitter and sets the spawn budget for the next Update(...), which is where
+    the particles are actually reset.  Particles are spread between the emitters the same way
+    as in ComputeParticleReset::ResetParticles(...).
+Parameters:
+    particlesPerEmitterPerFrame        Limits the number of particles that are reset per frame so
+    that they don't all spawn at once.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdate::ResetParticles(unsigned int particlesPerEmitterPerFrame)
+{
+    if (_pointEmitters.empty() && _barEmitters.empty())
+    {
+        // nothing to do
+        return;
+    }
+
+    _spawnBudget = _emitterBuffer.UpdateValues(_pointEmitters, _barEmitters,
+        particlesPerEmitterPerFrame);
+
+    glUseProgram(_computeProgramId);
+    glUniform1ui(_unifLocNumEmitters, (GLuint)(_pointEmitters.size() + _barEmitters.size()));
+
+    // every frame gets different random numbers
+    _frameNumber++;
+    glUniform1ui(_unifLocFrameNumber, _frameNumber);
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Examines all particles and:
+    (1) resets inactive particles (up to the spawn budget from ResetParticles(...))
+    (2) updates their position based on velocity and delta time
+    (3) checks if they have gone outside the polygon bounds, and if so, deactives them
+
+    Several fixed-size steps can be taken in one call, same as ComputeParticleUpdate::Update(...).  
+    The resets all happen before the first step.
+Parameters:
+    deltaTimeSec    The time of each step.
+    numSubSteps     How many steps to take.  If 0, nothing moves (but the resets still happen 
+                    and the particles are still counted and listed for drawing).
+Returns:
+    The number of active particles from the most recent update that the GPU has finished, 
+    which is ActiveCountLatencyFrames() updates ago.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleResetAndUpdate::Update(const float deltaTimeSec, 
+    unsigned int numSubSteps)
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    glUseProgram(_computeProgramId);
+
+    glUniform1f(_unifLocDeltaTimeSec, deltaTimeSec);
+    glUniform1ui(_unifLocNumSubSteps, numSubSteps);
+    glUniform1ui(_unifLocMaxParticleEmitCount, _spawnBudget);
+    glUniformMatrix4fv(_unifLocEmitterTransform, 1, GL_FALSE, glm::value_ptr(_emitterTransform));
+    glUniformMatrix4fv(_unifLocInverseRegionTransform, 1, GL_FALSE, glm::value_ptr(_inverseRegionTransform));
+
+    // the active particle and spawn slot counters start at 0
+    GLuint acCounterValues[2] = { 0, 0 };
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acCountersBufferId);
+    glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(acCounterValues), (void *)acCounterValues);
+    glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    // the budget has been spent
+    _spawnBudget = 0;
+
+    // cleanup
+    glUseProgram(0);
+
+    // the active particle counter is first in the counter buffer (see 
+    // ComputeParticleUpdate::Update(...))
+    _activeCountReadback.Capture(_acCountersBufferId, 0);
+    return _activeCountReadback.LatestValue();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How many updates old the count from the last Update(...) is.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleResetAndUpdate::ActiveCountLatencyFrames() const
+{
+    return _activeCountReadback.LatencyFrames();
+}
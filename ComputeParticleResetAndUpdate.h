@@ -0,0 +1,86 @@
+#pragma once
+
+#include "IParticleEmitter.h"
+#include "ParticleEmitterPoint.h"
+#include "ParticleEmitterBar.h"
+#include "ParticleEmitterSsbo.h"
+#include "CounterReadbackRing.h"
+#include "glm/mat4x4.hpp"
+#include <string>
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the fused "particle reset and update" compute shader
+    (particleResetAndUpdate.comp).  It has the same interface as ComputeParticleReset and
+    ComputeParticleUpdate put together and can be used in place of both of them.
+
+    The separate shaders each go through the particle buffer, so every particle is read at
+    least twice per frame.  The fused shader resets and updates a particle in the same
+    invocation, so each particle is read and written at most once per frame and there is one
+    dispatch and one memory barrier instead of two.
+
+    ResetParticles(...) only uploads the emitters and sets this frame's spawn budget.  The
+    resets themselves happen during the next Update(...).
+
+    Note: This class is not concerned with the particle SSBO or the polygon SSBO.  Those must be
+    configured for this compute shader by their own objects.
+
+    Note: When this class goes "poof", it won't delete the emitter pointers.  This is ensured by
+    only using const pointers.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleResetAndUpdate
+{
+public:
+    ComputeParticleResetAndUpdate(unsigned int numParticles, unsigned int numFaces,
+        const std::string &computeShaderKey);
+    ~ComputeParticleResetAndUpdate();
+
+    bool AddEmitter(const IParticleEmitter *pEmitter);
+    void SetEmitterTransform(const glm::mat4 &emitterTransform);
+    void SetRegionTransform(const glm::mat4 &regionTransform);
+
+    void ResetParticles(unsigned int particlesPerEmitterPerFrame);
+    unsigned int Update(const float deltaTimeSec, unsigned int numSubSteps = 1);
+    unsigned int ActiveCountLatencyFrames() const;
+
+private:
+    unsigned int _totalParticleCount;
+    unsigned int _computeProgramId;
+
+    // the number of resets that the next Update(...) may do (0 after every update)
+    unsigned int _spawnBudget;
+
+    // see ComputeParticleReset
+    unsigned int _frameNumber;
+
+    // both atomic counters (active particles and spawn slots) live in this one buffer
+    // Note: The readback ring is for reading back the active particle count without stalling
+    // the pipeline (see ComputeParticleUpdate).
+    unsigned int _acCountersBufferId;
+    CounterReadbackRing _activeCountReadback;
+
+    // unlike most OpenGL IDs, uniform locations are GLint
+    int _unifLocParticleCount;
+    int _unifLocPolygonFaceCount;
+    int _unifLocDeltaTimeSec;
+    int _unifLocNumSubSteps;
+    int _unifLocMaxParticleEmitCount;
+    int _unifLocNumEmitters;
+    int _unifLocFrameNumber;
+
+    // see ComputeParticleReset and ComputeParticleUpdate (-1 without GPU transforms)
+    int _unifLocEmitterTransform;
+    int _unifLocInverseRegionTransform;
+    glm::mat4 _emitterTransform;
+    glm::mat4 _inverseRegionTransform;
+
+    // every emitter's position, velocity, and share of the frame's resets
+    ParticleEmitterSsbo _emitterBuffer;
+
+    // see ComputeParticleReset
+    static const int MAX_EMITTERS = 4;
+    std::vector<const ParticleEmitterPoint *> _pointEmitters;
+    std::vector<const ParticleEmitterBar *> _barEmitters;
+};
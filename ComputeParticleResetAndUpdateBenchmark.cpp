@@ -0,0 +1,217 @@
+#include "ComputeParticleResetAndUpdateBenchmark.h"
+
+#include <stdio.h>
+
+#include "ComputeParticleReset.h"
+#include "ComputeParticleUpdate.h"
+#include "ComputeParticleResetAndUpdate.h"
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps the shader keys for Run() and generates the particle copies and the timer query.
+Parameters:
+    layoutInfo              The live particle buffer's layout.
+    particleBufferId        The live particle buffer.
+    numFaces                Used to tell the update shaders how many polygon faces are in play.
+    resetShaderKey          particleReset.comp, built without the dead list.
+    updateShaderKey         particleUpdate.comp, built without the live list.
+    resetAndUpdateShaderKey particleResetAndUpdate.comp, built the same way as the other two.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleResetAndUpdateBenchmark::ComputeParticleResetAndUpdateBenchmark(
+    const ParticleLayoutInfo &layoutInfo, unsigned int particleBufferId, unsigned int numFaces,
+    const std::string &resetShaderKey, const std::string &updateShaderKey,
+    const std::string &resetAndUpdateShaderKey) :
+    _layoutInfo(layoutInfo),
+    _particleBufferId(particleBufferId),
+    _numFaces(numFaces),
+    _resetShaderKey(resetShaderKey),
+    _updateShaderKey(updateShaderKey),
+    _resetAndUpdateShaderKey(resetAndUpdateShaderKey)
+{
+    // Note: Don't bother giving them initial values.  They are copied from the particle buffer.
+    glGenBuffers(1, &_startingParticlesBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _startingParticlesBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, _layoutInfo.BufferSizeBytes(), 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_warmParticlesBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _warmParticlesBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, _layoutInfo.BufferSizeBytes(), 0, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glGenQueries(1, &_timerQueryId);
+
+    printf("particle reset and update benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the particle copies and the timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleResetAndUpdateBenchmark::~ComputeParticleResetAndUpdateBenchmark()
+{
+    glDeleteBuffers(1, &_startingParticlesBufferId);
+    glDeleteBuffers(1, &_warmParticlesBufferId);
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Both ways get this emitter.
+Parameters:
+    pEmitter    A pointer to a "particle emitter" interface.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdateBenchmark::AddEmitter(const IParticleEmitter *pEmitter)
+{
+    _emitters.push_back(pEmitter);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Where the region and the emitters are.  Only used if the shaders were built with
+    "#define GPU_TRANSFORMS".
+Parameters:
+    transform   Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdateBenchmark::SetTransform(const glm::mat4 &transform)
+{
+    _transform = transform;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does all of the steps in the class description and prints the results on one line.
+Parameters:
+    particlesPerEmitterPerFrame     Self-explanatory
+    deltaTimeSec                    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdateBenchmark::Run(unsigned int particlesPerEmitterPerFrame,
+    float deltaTimeSec) const
+{
+    unsigned int numParticles = _layoutInfo.NumParticles();
+    CopyParticles(_particleBufferId, _startingParticlesBufferId);
+
+    // the separate passes fill the region and then are timed from there
+    // Note: Scoped so that they are gone (and their bindings with them) before the fused pass
+    // binds its own.
+    GLuint64 separateNs = 0;
+    {
+        ComputeParticleReset reseter(numParticles, _resetShaderKey);
+        ComputeParticleUpdate updater(numParticles, _numFaces, _updateShaderKey);
+        for (size_t emitterIndex = 0; emitterIndex < _emitters.size(); emitterIndex++)
+        {
+            reseter.AddEmitter(_emitters[emitterIndex]);
+        }
+        reseter.SetEmitterTransform(_transform);
+        updater.SetRegionTransform(_transform);
+
+        for (unsigned int frame = 0; frame < NUM_WARMUP_FRAMES; frame++)
+        {
+            reseter.ResetParticles(particlesPerEmitterPerFrame);
+            updater.Update(deltaTimeSec);
+        }
+        CopyParticles(_particleBufferId, _warmParticlesBufferId);
+
+        glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+        for (unsigned int frame = 0; frame < NUM_TIMED_FRAMES; frame++)
+        {
+            reseter.ResetParticles(particlesPerEmitterPerFrame);
+            updater.Update(deltaTimeSec);
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+
+        // asking for the result waits until the GPU is done
+        glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &separateNs);
+    }
+
+    // same particles for the fused pass
+    CopyParticles(_warmParticlesBufferId, _particleBufferId);
+    GLuint64 fusedNs = 0;
+    {
+        ComputeParticleResetAndUpdate resetAndUpdater(numParticles, _numFaces,
+            _resetAndUpdateShaderKey);
+        for (size_t emitterIndex = 0; emitterIndex < _emitters.size(); emitterIndex++)
+        {
+            resetAndUpdater.AddEmitter(_emitters[emitterIndex]);
+        }
+        resetAndUpdater.SetEmitterTransform(_transform);
+        resetAndUpdater.SetRegionTransform(_transform);
+
+        glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+        for (unsigned int frame = 0; frame < NUM_TIMED_FRAMES; frame++)
+        {
+            resetAndUpdater.ResetParticles(particlesPerEmitterPerFrame);
+            resetAndUpdater.Update(deltaTimeSec);
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &fusedNs);
+    }
+
+    // leave the particle buffer the way the demo left it
+    CopyParticles(_startingParticlesBufferId, _particleBufferId);
+
+    double separateMs = ((double)separateNs / 1000000.0) / NUM_TIMED_FRAMES;
+    double fusedMs = ((double)fusedNs / 1000000.0) / NUM_TIMED_FRAMES;
+    printf("particle reset and update (%s, %u of %u active): separate = %.3f ms, fused = %.3f ms per frame\n",
+        _layoutInfo.Name(), CountActiveParticles(_warmParticlesBufferId), numParticles,
+        separateMs, fusedMs);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Copies a whole particle buffer's worth of bytes on the GPU.
+Parameters:
+    sourceBufferId          Self-explanatory
+    destinationBufferId     Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleResetAndUpdateBenchmark::CopyParticles(unsigned int sourceBufferId,
+    unsigned int destinationBufferId) const
+{
+    // the particles may have just been written by a shader
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_COPY_READ_BUFFER, sourceBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, destinationBufferId);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+        _layoutInfo.BufferSizeBytes());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads a copy of the particle buffer back to the CPU and counts the active particles in it.
+Parameters:
+    bufferId    One of the particle copies.
+Returns:
+    Self-explanatory
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleResetAndUpdateBenchmark::CountActiveParticles(
+    unsigned int bufferId) const
+{
+    unsigned int numBytes = _layoutInfo.BufferSizeBytes();
+    std::vector<unsigned int> words((numBytes + sizeof(unsigned int) - 1) / sizeof(unsigned int));
+    glBindBuffer(GL_COPY_READ_BUFFER, bufferId);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, numBytes, (void *)words.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    unsigned int numActive = 0;
+    for (unsigned int particleIndex = 0; particleIndex < _layoutInfo.NumParticles(); particleIndex++)
+    {
+        numActive += (_layoutInfo.Read(words.data(), particleIndex)._isActive != 0) ? 1 : 0;
+    }
+    return numActive;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IParticleEmitter.h"
+#include "ParticleLayout.h"
+#include "glm/mat4x4.hpp"
+#include <string>
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times a frame of particle resetting and updating two ways: the separate "particle reset"
+    and "particle update" passes (ComputeParticleReset and ComputeParticleUpdate, without the
+    dead list) and the fused pass (ComputeParticleResetAndUpdate).  Both run on the live
+    particle buffer from the same particle state.
+
+    Run() fills the region with the separate passes for a while, takes a copy of the
+    particles, times NUM_TIMED_FRAMES frames of the separate passes, puts the copy back, and
+    times the same number of frames of the fused pass.  It prints the GPU time per frame for
+    each way, measured with a GL_TIME_ELAPSED query, and how many particles were active at the
+    start.  The particle buffer is put back the way it was before Run() when it is done.  The
+    OpenGL renderer is printed on startup.
+
+    Note: The reset and update objects bind their atomic counters and emitter SSBOs to the
+    same binding points as the demo's, so Run() makes its own and must run before the demo
+    makes its own.
+
+    Note: This class is not concerned with the particle SSBO or the polygon SSBO.  Those must
+    be configured for all three compute shaders by their own objects.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleResetAndUpdateBenchmark
+{
+public:
+    ComputeParticleResetAndUpdateBenchmark(const ParticleLayoutInfo &layoutInfo,
+        unsigned int particleBufferId, unsigned int numFaces, const std::string &resetShaderKey,
+        const std::string &updateShaderKey, const std::string &resetAndUpdateShaderKey);
+    ~ComputeParticleResetAndUpdateBenchmark();
+
+    void AddEmitter(const IParticleEmitter *pEmitter);
+    void SetTransform(const glm::mat4 &transform);
+
+    void Run(unsigned int particlesPerEmitterPerFrame, float deltaTimeSec) const;
+
+private:
+    void CopyParticles(unsigned int sourceBufferId, unsigned int destinationBufferId) const;
+    unsigned int CountActiveParticles(unsigned int bufferId) const;
+
+    // long enough for the emitters to fill the region
+    static const unsigned int NUM_WARMUP_FRAMES = 300;
+
+    // each way is timed over this many frames
+    static const unsigned int NUM_TIMED_FRAMES = 100;
+
+    ParticleLayoutInfo _layoutInfo;
+    unsigned int _particleBufferId;
+    unsigned int _numFaces;
+    std::string _resetShaderKey;
+    std::string _updateShaderKey;
+    std::string _resetAndUpdateShaderKey;
+
+    // see ComputeParticleUpdate::SetRegionTransform(...) (only used with GPU transforms)
+    glm::mat4 _transform;
+    std::vector<const IParticleEmitter *> _emitters;
+
+    // the particles as they were before Run() and as they were after the warmup
+    unsigned int _startingParticlesBufferId;
+    unsigned int _warmParticlesBufferId;
+    unsigned int _timerQueryId;
+};
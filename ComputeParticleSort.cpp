@@ -0,0 +1,176 @@
+#include "ComputeParticleSort.h"
+
+#include "ComputePrimitives.h"
+#include "Particle.h"
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// Note: The shaders' buffers are pointed at these bindings in ConfigureCompute(...).
+static const unsigned int KEY_BUFFER_BINDING = 28;
+static const unsigned int INDEX_BUFFER_BINDING = 29;
+static const unsigned int SORTED_PARTICLES_BUFFER_BINDING = 30;
+static const unsigned int REMAP_BUFFER_BINDING = 31;
+
+// must match particleSort.glsl; 10 bits each for X and Y, and 1 more for the "inactive" key
+static const unsigned int NUM_KEY_BITS = 21;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives the sort shaders the particle count and the region, points them at the sort's 
+    buffers, and allocates the buffers.
+Parameters:
+    numParticles        The size of the "all particles" buffer.
+    regionMin           The Morton keys are spread over this box.  Particles outside of it 
+    regionMax           still sort, just not as well.
+    keysShaderKey       particleSortKeys.comp
+    gatherShaderKey     particleSortGather.comp
+    scatterShaderKey    particleSortScatter.comp
+    pPrimitives         Sorts the keys.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleSort::ComputeParticleSort(unsigned int numParticles, const glm::vec2 &regionMin,
+    const glm::vec2 &regionMax, const std::string &keysShaderKey, 
+    const std::string &gatherShaderKey, const std::string &scatterShaderKey, 
+    ComputePrimitives *pPrimitives)
+{
+    _totalParticleCount = numParticles;
+    _pPrimitives = pPrimitives;
+
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    _keysProgramId = shaderStorageRef.GetShaderProgram(keysShaderKey);
+    _gatherProgramId = shaderStorageRef.GetShaderProgram(gatherShaderKey);
+    _scatterProgramId = shaderStorageRef.GetShaderProgram(scatterShaderKey);
+
+    // these never change, so set them once
+    // Note: Not looked up through the shader storage because that complains when a uniform is 
+    // missing, and only the keys shader uses the region.
+    glm::vec2 regionSize = regionMax - regionMin;
+    unsigned int programIds[] = { _keysProgramId, _gatherProgramId, _scatterProgramId };
+    for (size_t programCount = 0; programCount < 3; programCount++)
+    {
+        unsigned int programId = programIds[programCount];
+        ConfigureCompute(programId);
+        glUseProgram(programId);
+        glUniform1ui(glGetUniformLocation(programId, "uMaxParticleCount"), numParticles);
+        glUniform2f(glGetUniformLocation(programId, "uSortRegionMin"), regionMin.x, regionMin.y);
+        glUniform2f(glGetUniformLocation(programId, "uSortRegionSize"), regionSize.x, 
+            regionSize.y);
+    }
+    glUseProgram(0);
+
+    // Note: Don't bother giving them initial values.  They are all written by every sort.
+    glGenBuffers(1, &_keysBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _keysBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_indicesBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _indicesBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_sortedParticlesBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _sortedParticlesBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Particle) * numParticles, 0, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &_remapBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _remapBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * numParticles, 0, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the sort buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleSort::~ComputeParticleSort()
+{
+    glDeleteBuffers(1, &_keysBufferId);
+    glDeleteBuffers(1, &_indicesBufferId);
+    glDeleteBuffers(1, &_sortedParticlesBufferId);
+    glDeleteBuffers(1, &_remapBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does all of the steps in the class description.  The particle buffer is in Z order 
+    afterwards (active particles first), and there is a memory barrier at the end so that the 
+    next pass or draw can just use it.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleSort::Sort() const
+{
+    // spread out the particles between lots of work items, but keep it 1-dimensional for easy
+    // navigation through a 1-dimensional particle buffer
+    GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
+    GLuint numWorkGroupsY = 1;
+    GLuint numWorkGroupsZ = 1;
+
+    BindBuffers();
+    glUseProgram(_keysProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    _pPrimitives->SortKeyValue(_keysBufferId, _indicesBufferId, _totalParticleCount, 
+        NUM_KEY_BITS);
+
+    BindBuffers();
+    glUseProgram(_gatherProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glUseProgram(_scatterProgramId);
+    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points whichever of the sort buffers the given program has at their bindings.
+Parameters:
+    computeProgramId    Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleSort::ConfigureCompute(unsigned int computeProgramId) const
+{
+    const char *blockNames[] = 
+    {
+        "ParticleSortKeyBuffer", "ParticleSortIndexBuffer", "ParticleSortedBuffer", 
+        "ParticleRemapBuffer"
+    };
+    unsigned int blockBindings[] = 
+    {
+        KEY_BUFFER_BINDING, INDEX_BUFFER_BINDING, SORTED_PARTICLES_BUFFER_BINDING, 
+        REMAP_BUFFER_BINDING
+    };
+    for (size_t blockCount = 0; blockCount < 4; blockCount++)
+    {
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(computeProgramId, 
+            GL_SHADER_STORAGE_BLOCK, blockNames[blockCount]);
+        if (ssboBlockIndex != GL_INVALID_INDEX)
+        {
+            glShaderStorageBlockBinding(computeProgramId, ssboBlockIndex, 
+                blockBindings[blockCount]);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points the sort bindings at this object's buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleSort::BindBuffers() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, KEY_BUFFER_BINDING, _keysBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INDEX_BUFFER_BINDING, _indicesBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORTED_PARTICLES_BUFFER_BINDING, 
+        _sortedParticlesBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, REMAP_BUFFER_BINDING, _remapBufferId);
+}
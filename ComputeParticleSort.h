@@ -0,0 +1,63 @@
+#pragma once
+
+#include "glm/vec2.hpp"
+#include <string>
+
+class ComputePrimitives;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Re-sorts the particle buffer so that particles that are near each other in the region are 
+    near each other in memory.  The reset shader puts new particles in whatever inactive spot 
+    comes off of the dead list first, so after a while neighbors are scattered all over the 
+    buffer, and anything that looks at a particle's neighbors (collisions, and to some degree 
+    drawing) ends up reading from all over memory.  Sorting them by their Z order (Morton) key 
+    fixes that for a while.  Each Sort():
+    (1) particleSortKeys.comp: every particle gets its Morton key, and inactive particles get a 
+    key that puts them at the back
+    (2) the keys are radix sorted with the particles' indices as values (see 
+    ComputePrimitives::SortKeyValue(...))
+    (3) particleSortGather.comp: the particles are copied out in sorted order, and each 
+    particle's new index is recorded by its old index
+    (4) particleSortScatter.comp: the sorted particles are written back into the particle 
+    buffer, and the dead list's indices are remapped to match
+    This works for every particle layout because the particles are copied out whole and 
+    written back with the layout's own functions.
+
+    Note: Particles only drift a little each frame, so this doesn't need to run every frame.  
+    Call it before the reset, when the dead list is the only thing holding on to particle 
+    indices, and only on a frame that goes on to update the particles.  The update rebuilds 
+    the draw list, but a frame that skips the update draws with the last one, whose indices 
+    the sort would have made stale.
+
+    Note: Like the other compute classes, this class is not concerned with the particle SSBO 
+    or the dead list SSBO.  They must be configured for the sort shaders by their own objects.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleSort
+{
+public:
+    ComputeParticleSort(unsigned int numParticles, const glm::vec2 &regionMin, 
+        const glm::vec2 &regionMax, const std::string &keysShaderKey, 
+        const std::string &gatherShaderKey, const std::string &scatterShaderKey, 
+        ComputePrimitives *pPrimitives);
+    ~ComputeParticleSort();
+
+    void Sort() const;
+
+private:
+    void ConfigureCompute(unsigned int computeProgramId) const;
+    void BindBuffers() const;
+
+    unsigned int _totalParticleCount;
+    ComputePrimitives *_pPrimitives;
+
+    unsigned int _keysProgramId;
+    unsigned int _gatherProgramId;
+    unsigned int _scatterProgramId;
+
+    unsigned int _keysBufferId;
+    unsigned int _indicesBufferId;
+    unsigned int _sortedParticlesBufferId;
+    unsigned int _remapBufferId;
+};
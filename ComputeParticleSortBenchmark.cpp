@@ -0,0 +1,146 @@
+#include "ComputeParticleSortBenchmark.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "ComputeParticleSort.h"
+#include "ComputeParticleCollisions.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// one warp's worth of particles
+static const unsigned int PARTICLES_PER_WARP = 32;
+static const unsigned int CACHE_LINE_BYTES = 128;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the timer query.
+Parameters:
+    layoutInfo      The live particle buffer's layout, for finding where particles are.
+    pParticleSort   Sorts the live particle buffer.
+    pCollisions     Must be configured for the live particle buffer.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleSortBenchmark::ComputeParticleSortBenchmark(const ParticleLayoutInfo &layoutInfo,
+    const ComputeParticleSort *pParticleSort, const ComputeParticleCollisions *pCollisions) :
+    _layoutInfo(layoutInfo),
+    _pParticleSort(pParticleSort),
+    _pCollisions(pCollisions)
+{
+    glGenQueries(1, &_timerQueryId);
+
+    printf("particle sort benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputeParticleSortBenchmark::~ComputeParticleSortBenchmark()
+{
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Measures, sorts the particle buffer, measures again, and prints the results.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleSortBenchmark::Run() const
+{
+    double beforeMs = TimeBuilds();
+    double beforeLines = CacheLinesPerWarp();
+
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    _pParticleSort->Sort();
+    glEndQuery(GL_TIME_ELAPSED);
+    GLuint64 sortNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &sortNs);
+
+    double afterMs = TimeBuilds();
+    double afterLines = CacheLinesPerWarp();
+
+    printf("particle sort (%s, %.3f ms): neighbor gather before = %.3f ms (%.1f cache lines per warp), after = %.3f ms (%.1f cache lines per warp)\n",
+        _layoutInfo.Name(), (double)sortNs / 1000000.0, beforeMs, beforeLines, afterMs, 
+        afterLines);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Builds the collision cell table NUM_BUILDS times in a row and waits for the GPU to finish.  
+    Building doesn't change the particles.
+Parameters: None
+Returns:
+    The average GPU time of one build, in milliseconds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeParticleSortBenchmark::TimeBuilds() const
+{
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int buildCount = 0; buildCount < NUM_BUILDS; buildCount++)
+    {
+        _pCollisions->BuildCellTable();
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+
+    // asking for the result waits until the GPU is done
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &elapsedNs);
+    return ((double)elapsedNs / 1000000.0) / NUM_BUILDS;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads back the order that the last cell table build gathered the active particles in and 
+    counts how many different cache lines each warp's worth of their positions are in (see 
+    the class description).
+Parameters: None
+Returns:
+    The average over all full warps (0 if there aren't any).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double ComputeParticleSortBenchmark::CacheLinesPerWarp() const
+{
+    unsigned int numParticles = _layoutInfo.NumParticles();
+    std::vector<unsigned int> keys(numParticles);
+    std::vector<unsigned int> indices(numParticles);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _pCollisions->KeyBufferId());
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * numParticles, keys.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _pCollisions->IndexBufferId());
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * numParticles, 
+        indices.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // inactive particles are sorted to the back
+    unsigned int numActive = 0;
+    while (numActive < numParticles && keys[numActive] != _pCollisions->TableSize())
+    {
+        numActive++;
+    }
+
+    unsigned int numWarps = numActive / PARTICLES_PER_WARP;
+    unsigned long long totalLines = 0;
+    std::vector<unsigned int> warpLines(PARTICLES_PER_WARP);
+    for (unsigned int warpCount = 0; warpCount < numWarps; warpCount++)
+    {
+        for (unsigned int laneCount = 0; laneCount < PARTICLES_PER_WARP; laneCount++)
+        {
+            unsigned int particleIndex = indices[(warpCount * PARTICLES_PER_WARP) + laneCount];
+            unsigned int byteOffset = 
+                4 * _layoutInfo.WordIndex(particleIndex, PARTICLE_FIELD_POS_X);
+            warpLines[laneCount] = byteOffset / CACHE_LINE_BYTES;
+        }
+        std::sort(warpLines.begin(), warpLines.end());
+        totalLines += std::unique(warpLines.begin(), warpLines.end()) - warpLines.begin();
+    }
+
+    return (numWarps == 0) ? 0.0 : (double)totalLines / numWarps;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ParticleLayout.h"
+
+class ComputeParticleSort;
+class ComputeParticleCollisions;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Measures how much the Z order re-sort (see ComputeParticleSort) helps the memory traffic 
+    of a neighbor query.  OpenGL can't read the GPU's cache counters, so "cache misses" are 
+    measured two ways, on the live particle buffer, before and after one sort:
+    - the GPU time to build the collision cell table (see ComputeParticleCollisions), whose 
+    gather reads every active particle in cell order, measured with a GL_TIME_ELAPSED query
+    - an estimate of the memory transactions that gather needs: for every 32 active particles 
+    in a row in cell order (one warp's worth), the number of different 128-byte cache lines 
+    that their positions are in, using the particle buffer's layout.  32 particles that are 
+    all in one spot in memory take 1 or a few lines, and 32 that are scattered take 32.
+    Run() prints both, plus the time that the sort itself took.
+
+    Note: The update shader walks the particle buffer from front to back no matter what order 
+    the particles are in, so its reads are already as cache friendly as they get.  Sorting 
+    helps it only by putting the active particles together at the front.
+
+    Note: Run() waits for the GPU to finish and reads buffers back, so it will make a dent in 
+    the frame rate.  Only use it for measuring.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputeParticleSortBenchmark
+{
+public:
+    ComputeParticleSortBenchmark(const ParticleLayoutInfo &layoutInfo, 
+        const ComputeParticleSort *pParticleSort, const ComputeParticleCollisions *pCollisions);
+    ~ComputeParticleSortBenchmark();
+
+    void Run() const;
+
+private:
+    double TimeBuilds() const;
+    double CacheLinesPerWarp() const;
+
+    // the cell table build is timed over this many builds
+    static const unsigned int NUM_BUILDS = 5;
+
+    ParticleLayoutInfo _layoutInfo;
+    const ComputeParticleSort *_pParticleSort;
+    const ComputeParticleCollisions *_pCollisions;
+    unsigned int _timerQueryId;
+};
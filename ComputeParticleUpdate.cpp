@@ -1,7 +1,10 @@
 #include "ComputeParticleUpdate.h"
 
+#include "ComputeParticleLiveList.h"
 #include "ShaderStorage.h"
 #include "glload/include/glload/gl_4_4.h"
+#include "glm/matrix.hpp"     // for glm::inverse(...)
+#include "glm/gtc/type_ptr.hpp"
 
 /*-----------------------------------------------------------------------------------------------
 Description:
@@ -15,10 +18,13 @@ Parameters:
     numParticles        Used to tell a shader uniform how big the "all particles" buffer is.
     numFaces            Used to tell a shader uniform how many polygon faces are in play.
     computeShaderKey    Used to look up (1) the compute shader ID and (2) uniform locations.
+    pLiveList           Optional.  If provided, only the particles in it are updated.
 Returns:    None
 Creator:    John Cox (11-24-2016)
 -----------------------------------------------------------------------------------------------*/
-ComputeParticleUpdate::ComputeParticleUpdate(unsigned int numParticles, unsigned int numFaces, const std::string &computeShaderKey)
+ComputeParticleUpdate::ComputeParticleUpdate(unsigned int numParticles, unsigned int numFaces, const std::string &computeShaderKey,
+    const ComputeParticleLiveList *pLiveList) :
+    _pLiveList(pLiveList)
 {
     _totalParticleCount = numParticles;
     ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
@@ -26,15 +32,20 @@ ComputeParticleUpdate::ComputeParticleUpdate(unsigned int numParticles, unsigned
     _unifLocParticleCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uMaxParticleCount");
     _unifLocPolygonFaceCount = shaderStorageRef.GetUniformLocation(computeShaderKey, "uPolygonFaceCount");
     _unifLocDeltaTimeSec = shaderStorageRef.GetUniformLocation(computeShaderKey, "uDeltaTimeSec");
+    _unifLocNumSubSteps = shaderStorageRef.GetUniformLocation(computeShaderKey, "uNumSubSteps");
 
     _computeProgramId = shaderStorageRef.GetShaderProgram(computeShaderKey);
 
+    // not looked up through the shader storage because that complains when a uniform is 
+    // missing, and this one is only there with GPU transforms
+    _unifLocInverseRegionTransform = glGetUniformLocation(_computeProgramId, "uInverseRegionTransform");
+
     glUseProgram(_computeProgramId);
 
     // the program in which this uniform is located must be bound in order to set the value
     glUniform1ui(_unifLocParticleCount, numParticles);
     glUniform1ui(_unifLocPolygonFaceCount, numFaces);
-    // delta time set in Update(...)
+    // delta time, sub-steps, and region transform set in Update(...)
 
     // atomic counter initialization courtesy of geeks3D (and my use of glBufferData(...) 
     // instead of glMapBuffer(...)
@@ -47,11 +58,8 @@ ComputeParticleUpdate::ComputeParticleUpdate(unsigned int numParticles, unsigned
     glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), (void *)&atomicCounterResetVal, GL_DYNAMIC_DRAW);
     glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
 
-    // the atomic counter copy buffer follows suit
-    glGenBuffers(1, &_acParticleCounterCopyBufferId);
-    glBindBuffer(GL_COPY_WRITE_BUFFER, _acParticleCounterCopyBufferId);
-    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(GLuint), 0, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    // the atomic counter's values are copied out of the pipeline into here
+    _activeCountReadback.Init();
 
     // cleanup
     glUseProgram(0);
@@ -77,7 +85,27 @@ Creator:    John Cox (10-10-2016)    (created prior to this class in an earlier
 ComputeParticleUpdate::~ComputeParticleUpdate()
 {
     glDeleteBuffers(1, &_acParticleCounterBufferId);
-    glDeleteBuffers(1, &_acParticleCounterCopyBufferId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    For a shader built with "#define GPU_TRANSFORMS".  The polygon faces are uploaded once, 
+    untransformed, and this is the only thing that changes when the region moves, so the 
+    per-frame upload is one matrix no matter how many faces there are.
+
+    The shader moves each particle into the region's space with the inverse instead of moving 
+    every face to the particle, so it is one matrix multiply per particle instead of one per 
+    face.  That gives the same answer as transforming the faces (ParticleRegionPolygon::
+    SetTransform(...)) for rotations, translations, and uniform scales, which is what the 
+    faces' normals are transformed for anyway.
+Parameters:
+    regionTransform     Where the region is this frame.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputeParticleUpdate::SetRegionTransform(const glm::mat4 &regionTransform)
+{
+    _inverseRegionTransform = glm::inverse(regionTransform);
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -85,16 +113,28 @@ Description:
     Examines all active particles and:
     (1) updates their position based on velocity and delta time
     (2) checks if they have gone outside the polygon bounds, and if so, deactives them
+
+    With a live list, only the listed particles are examined, and the list is compacted 
+    afterwards so that the next update skips the ones that were deactivated.
+
+    Several fixed-size steps (see FixedTimestepScheduler) can be taken in one call.  The 
+    shader loops over them, so each particle is only read and written once no matter how 
+    many steps there are.
 Parameters:    
-    deltaTimeSec    Self-explanatory
-Returns:    None
+    deltaTimeSec    The time of each step.
+    numSubSteps     How many steps to take.  If 0, nothing moves (but the particles are still 
+                    counted and listed for drawing).
+Returns:    
+    The number of active particles from the most recent update that the GPU has finished, 
+    which is ActiveCountLatencyFrames() updates ago.
 Creator:    John Cox (10-10-2016)
             (created in an earlier class, but later split into a dedicated class)
 -----------------------------------------------------------------------------------------------*/
-unsigned int ComputeParticleUpdate::Update(const float deltaTimeSec) const
+unsigned int ComputeParticleUpdate::Update(const float deltaTimeSec, unsigned int numSubSteps)
 {
     // spread out the particles between lots of work items, but keep it 1-dimensional for easy 
-    // navigation through a 1-dimensional particle buffer
+    // navigation through a 1-dimensional particle buffer (unless there is a live list, in 
+    // which case this is ignored and the dispatch is sized on the GPU)
     GLuint numWorkGroupsX = (_totalParticleCount / 256) + 1;
     GLuint numWorkGroupsY = 1;
     GLuint numWorkGroupsZ = 1;
@@ -102,31 +142,49 @@ unsigned int ComputeParticleUpdate::Update(const float deltaTimeSec) const
     glUseProgram(_computeProgramId);
 
     glUniform1f(_unifLocDeltaTimeSec, deltaTimeSec);
+    glUniform1ui(_unifLocNumSubSteps, numSubSteps);
+    glUniformMatrix4fv(_unifLocInverseRegionTransform, 1, GL_FALSE, glm::value_ptr(_inverseRegionTransform));
     glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, _acParticleCounterBufferId);
     unsigned int atomicCounterResetValue = 0;
     glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), (void *)&atomicCounterResetValue);
-    glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    if (_pLiveList != 0)
+    {
+        _pLiveList->DispatchIndirect();
+    }
+    else
+    {
+        glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    }
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 
     // cleanup
     glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
     glUseProgram(0);
 
-    // now that all active particles have updated, check how many active particles exist 
+    if (_pLiveList != 0)
+    {
+        // take this update's dead particles out and put the rest back in order
+        _pLiveList->Compact();
+    }
+
+    // copy this update's count of active particles out of the pipeline and pick up the most 
+    // recent one that the GPU has finished without waiting on this one
     // Note: Thanks to this post for prompting me to learn about buffer copying to solve this 
     // "extract atomic counter from compute shader" issue.
     // (http://gamedev.stackexchange.com/questions/93726/what-is-the-fastest-way-of-reading-an-atomic-counter) 
-    glBindBuffer(GL_COPY_READ_BUFFER, _acParticleCounterBufferId);
-    glBindBuffer(GL_COPY_WRITE_BUFFER, _acParticleCounterCopyBufferId);
-    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(GLuint));
-    unsigned int *ptr = (GLuint*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT);
-    unsigned int numActiveParticles = *ptr;
-    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
-
-    // cleanup
-    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
-    glBindBuffer(GL_COPY_READ_BUFFER, 0);
-
-    return numActiveParticles;
+    _activeCountReadback.Capture(_acParticleCounterBufferId, 0);
+    return _activeCountReadback.LatestValue();
+}
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How many updates old the count from the last Update(...) is.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputeParticleUpdate::ActiveCountLatencyFrames() const
+{
+    return _activeCountReadback.LatencyFrames();
 }
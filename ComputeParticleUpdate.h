@@ -3,9 +3,13 @@
 #include "IParticleEmitter.h"
 #include "ParticleEmitterPoint.h"
 #include "ParticleEmitterBar.h"
+#include "CounterReadbackRing.h"
+#include "glm/mat4x4.hpp"
 #include <string>
 #include <vector>
 
+class ComputeParticleLiveList;
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Encapsulates particle updating via compute shader.  Particle updating includes particle 
@@ -16,20 +20,31 @@ Description:
     Note: This class is not concerned with the particle SSBO.  It is concerned with uniforms and
     summoning the shader.  SSBO setup is performed in the appropriate SSBO object.
 
+    If given a live list (see ComputeParticleLiveList), the shader is only summoned for the 
+    particles in it (with an indirect dispatch), and the list is compacted after each update.  
+    Otherwise the shader runs over every particle to find the active ones.  The update shader 
+    must be built with "#define PARTICLE_LIVE_LIST" to match.
+
 Creator:    John Cox (11-24-2016)
 -----------------------------------------------------------------------------------------------*/
 class ComputeParticleUpdate
 {
 public:
-    ComputeParticleUpdate(unsigned int numParticles, unsigned int numFaces, const std::string &computeShaderKey);
+    ComputeParticleUpdate(unsigned int numParticles, unsigned int numFaces, const std::string &computeShaderKey,
+        const ComputeParticleLiveList *pLiveList = 0);
     ~ComputeParticleUpdate();
 
-    unsigned int Update(const float deltaTimeSec) const;
+    void SetRegionTransform(const glm::mat4 &regionTransform);
+    unsigned int Update(const float deltaTimeSec, unsigned int numSubSteps = 1);
+    unsigned int ActiveCountLatencyFrames() const;
 
 private:
     unsigned int _totalParticleCount;
     unsigned int _computeProgramId;
 
+    // 0 if there is no live list
+    const ComputeParticleLiveList *_pLiveList;
+
     // the atomic counter is used to count the total number of active particles after this 
     // update
     // Also Note: The copy buffer is necessary to avoid trashing OpenGL's beautifully 
@@ -38,11 +53,20 @@ private:
     // I've learned about buffer copying, so now the buffer mapping happens on a buffer that is 
     // not part of the compute shader's pipeline, and frame rates are back up to ~60fps.  
     // Lovely :)
+    // Also Also Note: Even mapping the copy made the CPU wait for the GPU to finish the frame, 
+    // so the copies now go into a ring of persistently mapped slots that are only read once 
+    // the GPU is done with them (see CounterReadbackRing).
     unsigned int _acParticleCounterBufferId;
-    unsigned int _acParticleCounterCopyBufferId;
+    CounterReadbackRing _activeCountReadback;
 
     // unlike most OpeGL IDs, uniform locations are GLint
     int _unifLocParticleCount;
     int _unifLocPolygonFaceCount;
     int _unifLocDeltaTimeSec;
+    int _unifLocNumSubSteps;
+
+    // only in the shader if it was built with "#define GPU_TRANSFORMS" (otherwise -1, and 
+    // OpenGL ignores uniform values for location -1)
+    int _unifLocInverseRegionTransform;
+    glm::mat4 _inverseRegionTransform;
 };
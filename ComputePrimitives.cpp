@@ -0,0 +1,514 @@
+#include "ComputePrimitives.h"
+
+#include <stdio.h>
+#include <string>
+
+#include "ShaderStorage.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// the primitives' bindings; every call binds its own buffers to them before each dispatch
+// Note: Different shaders use the same bindings for different things.  That's fine because 
+// only one of them runs at a time.
+static const char *BUFFER_BLOCK_NAMES[] = 
+{
+    "ScanInBuffer", "ScanOutBuffer", "ScanBlockSumBuffer",
+    "CompactInBuffer", "CompactFlagBuffer", "CompactOffsetBuffer", "CompactOutBuffer", 
+    "CompactCountBuffer",
+    "RadixSortKeysIn", "RadixSortValuesIn", "RadixSortKeysOut", "RadixSortValuesOut", 
+    "RadixSortBlockCounts"
+};
+static const unsigned int BUFFER_BLOCK_BINDINGS[] = 
+{
+    18, 19, 20,
+    18, 19, 20, 21, 22,
+    18, 19, 20, 21, 22
+};
+static const unsigned int SCAN_IN_BINDING = 18;
+static const unsigned int SCAN_OUT_BINDING = 19;
+static const unsigned int SCAN_BLOCK_SUMS_BINDING = 20;
+static const unsigned int COMPACT_IN_BINDING = 18;
+static const unsigned int COMPACT_FLAGS_BINDING = 19;
+static const unsigned int COMPACT_OFFSETS_BINDING = 20;
+static const unsigned int COMPACT_OUT_BINDING = 21;
+static const unsigned int COMPACT_COUNT_BINDING = 22;
+static const unsigned int SORT_KEYS_IN_BINDING = 18;
+static const unsigned int SORT_VALUES_IN_BINDING = 19;
+static const unsigned int SORT_KEYS_OUT_BINDING = 20;
+static const unsigned int SORT_VALUES_OUT_BINDING = 21;
+static const unsigned int SORT_DIGIT_COUNTS_BINDING = 22;
+
+// must match radixSort.glsl
+static const unsigned int DIGIT_BITS = 4;
+static const unsigned int NUM_DIGITS = 1 << DIGIT_BITS;
+
+// the most work groups that every OpenGL implementation must allow in one dispatch; the 
+// shaders loop over the blocks when there are more than this
+static const unsigned int MAX_WORK_GROUPS = 65535;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Builds one of the primitives' compute shaders and points its buffers at their bindings.
+Parameters:
+    shaderKey   Self-explanatory.
+    filePath    Self-explanatory.
+Returns:
+    The program's ID.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static unsigned int BuildComputeShader(const std::string &shaderKey, 
+    const std::string &filePath)
+{
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    shaderStorageRef.NewShader(shaderKey);
+    shaderStorageRef.AddShaderFile(shaderKey, filePath, GL_COMPUTE_SHADER);
+    GLuint programId = shaderStorageRef.LinkShader(shaderKey);
+
+    // each shader only has some of the buffers
+    size_t numBlocks = sizeof(BUFFER_BLOCK_BINDINGS) / sizeof(BUFFER_BLOCK_BINDINGS[0]);
+    for (size_t blockCount = 0; blockCount < numBlocks; blockCount++)
+    {
+        GLuint ssboBlockIndex = glGetProgramResourceIndex(programId, GL_SHADER_STORAGE_BLOCK, 
+            BUFFER_BLOCK_NAMES[blockCount]);
+        if (ssboBlockIndex != GL_INVALID_INDEX)
+        {
+            glShaderStorageBlockBinding(programId, ssboBlockIndex, 
+                BUFFER_BLOCK_BINDINGS[blockCount]);
+        }
+    }
+
+    return programId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    numBlocks   How many blocks of BLOCK_SIZE elements there are.
+Returns:
+    How many work groups to dispatch for them.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static unsigned int NumWorkGroups(unsigned int numBlocks)
+{
+    return (numBlocks < MAX_WORK_GROUPS) ? numBlocks : MAX_WORK_GROUPS;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Builds the primitives' shaders and looks up their uniforms.  The scratch buffers are made 
+    by the first call that needs them.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputePrimitives::ComputePrimitives() :
+    _compactOffsetsBufferId(0),
+    _compactOffsetsNumWords(0),
+    _sortKeysBufferId(0),
+    _sortKeysNumWords(0),
+    _sortValuesBufferId(0),
+    _sortValuesNumWords(0),
+    _sortDigitCountsBufferId(0),
+    _sortDigitCountsNumWords(0)
+{
+    std::string scanBlocksKey = "compute primitives scan blocks";
+    std::string scanAddKey = "compute primitives scan add block sums";
+    std::string compactKey = "compute primitives compact";
+    std::string histogramKey = "compute primitives radix sort histogram";
+    std::string scatterKey = "compute primitives radix sort scatter";
+    _scanBlocksProgramId = BuildComputeShader(scanBlocksKey, "scanBlocks.comp");
+    _scanAddProgramId = BuildComputeShader(scanAddKey, "scanAddBlockSums.comp");
+    _compactProgramId = BuildComputeShader(compactKey, "compactScatter.comp");
+    _histogramProgramId = BuildComputeShader(histogramKey, "radixSortHistogram.comp");
+    _scatterProgramId = BuildComputeShader(scatterKey, "radixSortScatter.comp");
+
+    ShaderStorage &shaderStorageRef = ShaderStorage::GetInstance();
+    _unifLocScanBlocksNumElements = shaderStorageRef.GetUniformLocation(scanBlocksKey, 
+        "uNumElements");
+    _unifLocScanBlocksNumBlocks = shaderStorageRef.GetUniformLocation(scanBlocksKey, 
+        "uNumBlocks");
+    _unifLocScanBlocksInclusive = shaderStorageRef.GetUniformLocation(scanBlocksKey, 
+        "uInclusive");
+    _unifLocScanBlocksCountNonZero = shaderStorageRef.GetUniformLocation(scanBlocksKey, 
+        "uCountNonZero");
+    _unifLocScanAddNumElements = shaderStorageRef.GetUniformLocation(scanAddKey, 
+        "uNumElements");
+    _unifLocScanAddNumBlocks = shaderStorageRef.GetUniformLocation(scanAddKey, "uNumBlocks");
+    _unifLocCompactNumElements = shaderStorageRef.GetUniformLocation(compactKey, 
+        "uNumElements");
+    _unifLocCompactWriteIndices = shaderStorageRef.GetUniformLocation(compactKey, 
+        "uWriteIndices");
+    _unifLocHistogramNumElements = shaderStorageRef.GetUniformLocation(histogramKey, 
+        "uNumElements");
+    _unifLocHistogramNumBlocks = shaderStorageRef.GetUniformLocation(histogramKey, 
+        "uNumBlocks");
+    _unifLocHistogramDigitShift = shaderStorageRef.GetUniformLocation(histogramKey, 
+        "uDigitShift");
+    _unifLocScatterNumElements = shaderStorageRef.GetUniformLocation(scatterKey, 
+        "uNumElements");
+    _unifLocScatterNumBlocks = shaderStorageRef.GetUniformLocation(scatterKey, "uNumBlocks");
+    _unifLocScatterDigitShift = shaderStorageRef.GetUniformLocation(scatterKey, 
+        "uDigitShift");
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the scratch buffers.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputePrimitives::~ComputePrimitives()
+{
+    ReleaseScratchBuffers();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Writes the exclusive prefix sum of the input to the output: out[i] = in[0] + ... + 
+    in[i - 1], and out[0] = 0.  The sums wrap around at 2^32.
+Parameters:
+    inBufferId      Holds at least numElements uints.
+    outBufferId     Same.  Can be the same buffer as the input.
+    numElements     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::ExclusiveScan(unsigned int inBufferId, unsigned int outBufferId,
+    unsigned int numElements)
+{
+    Scan(inBufferId, outBufferId, numElements, false, false, 0);
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Writes the inclusive prefix sum of the input to the output: out[i] = in[0] + ... + in[i].  
+    The sums wrap around at 2^32.
+Parameters:
+    inBufferId      Holds at least numElements uints.
+    outBufferId     Same.  Can be the same buffer as the input.
+    numElements     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::InclusiveScan(unsigned int inBufferId, unsigned int outBufferId,
+    unsigned int numElements)
+{
+    Scan(inBufferId, outBufferId, numElements, true, false, 0);
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stream compaction.  Copies every input element whose flag isn't 0 to the front of the 
+    output, in their original order, and writes how many there were to the count buffer.
+Parameters:
+    inBufferId      Holds at least numElements uints.
+    flagsBufferId   Same.  One per input element.
+    outBufferId     Has room for as many elements as could be kept (up to numElements).  Must 
+                    not be the input or the flags.
+    countBufferId   The number kept is written to its first uint.
+    numElements     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::Compact(unsigned int inBufferId, unsigned int flagsBufferId, 
+    unsigned int outBufferId, unsigned int countBufferId, unsigned int numElements)
+{
+    CompactElements(inBufferId, flagsBufferId, outBufferId, countBufferId, numElements, false);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The same as Compact(...), but writes the kept elements' indices instead of their values, 
+    which makes a dense list of the flagged elements (ex: every active particle) without 
+    needing an input buffer of indices.
+Parameters:
+    flagsBufferId   Holds at least numElements uints.
+    outBufferId     Has room for as many indices as could be kept (up to numElements).  Must 
+                    not be the flags.
+    countBufferId   The number kept is written to its first uint.
+    numElements     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::CompactIndices(unsigned int flagsBufferId, unsigned int outBufferId,
+    unsigned int countBufferId, unsigned int numElements)
+{
+    CompactElements(0, flagsBufferId, outBufferId, countBufferId, numElements, true);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sorts the first numElements keys in the keys buffer, smallest first, and moves the values 
+    with them.  Keys that are equal keep the order that they came in.  The results are in the 
+    same buffers.
+
+    This is a least-significant-digit radix sort with 4-bit digits (see radixSort.glsl).  
+    Each pass reads one pair of buffers and writes the other, so the number of passes is 
+    rounded up to an even number so that the results end up back in the caller's buffers.  
+    Sorting fewer key bits is fewer passes, so callers should only ask for the bits that their 
+    keys use.
+Parameters:
+    keysBufferId    Holds at least numElements uints.
+    valuesBufferId  Same.
+    numElements     Self-explanatory.
+    numKeyBits      How many bits the keys use, 1 to 32.  Every key must fit in them (the sort 
+                    works on whole digits, so higher bits can still change the order).
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::SortKeyValue(unsigned int keysBufferId, unsigned int valuesBufferId,
+    unsigned int numElements, unsigned int numKeyBits)
+{
+    if (numElements == 0 || numKeyBits == 0 || numKeyBits > 32)
+    {
+        return;
+    }
+
+    // an even number of passes ends in the caller's buffers (an extra pass on bits that are 
+    // all 0 leaves the order alone)
+    unsigned int numPasses = (numKeyBits + DIGIT_BITS - 1) / DIGIT_BITS;
+    numPasses += (numPasses % 2);
+
+    unsigned int numBlocks = (numElements + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    unsigned int numDigitCounts = NUM_DIGITS * numBlocks;
+    unsigned int scratchKeysId = ScratchBuffer(&_sortKeysBufferId, &_sortKeysNumWords, 
+        numElements);
+    unsigned int scratchValuesId = ScratchBuffer(&_sortValuesBufferId, &_sortValuesNumWords, 
+        numElements);
+    unsigned int digitCountsId = ScratchBuffer(&_sortDigitCountsBufferId, 
+        &_sortDigitCountsNumWords, numDigitCounts);
+
+    glUseProgram(_histogramProgramId);
+    glUniform1ui(_unifLocHistogramNumElements, numElements);
+    glUniform1ui(_unifLocHistogramNumBlocks, numBlocks);
+    glUseProgram(_scatterProgramId);
+    glUniform1ui(_unifLocScatterNumElements, numElements);
+    glUniform1ui(_unifLocScatterNumBlocks, numBlocks);
+
+    for (unsigned int passCount = 0; passCount < numPasses; passCount++)
+    {
+        unsigned int digitShift = passCount * DIGIT_BITS;
+        unsigned int keysInId = ((passCount % 2) == 0) ? keysBufferId : scratchKeysId;
+        unsigned int valuesInId = ((passCount % 2) == 0) ? valuesBufferId : scratchValuesId;
+        unsigned int keysOutId = ((passCount % 2) == 0) ? scratchKeysId : keysBufferId;
+        unsigned int valuesOutId = ((passCount % 2) == 0) ? scratchValuesId : valuesBufferId;
+
+        BindSortBuffers(keysInId, valuesInId, keysOutId, valuesOutId);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_DIGIT_COUNTS_BINDING, digitCountsId);
+        glUseProgram(_histogramProgramId);
+        glUniform1ui(_unifLocHistogramDigitShift, digitShift);
+        glDispatchCompute(NumWorkGroups(numBlocks), 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        // the counts are digit-major, so scanning them in place gives each block's starting 
+        // spot for each digit
+        Scan(digitCountsId, digitCountsId, numDigitCounts, false, false, 0);
+
+        // the scan used the same bindings
+        BindSortBuffers(keysInId, valuesInId, keysOutId, valuesOutId);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_DIGIT_COUNTS_BINDING, digitCountsId);
+        glUseProgram(_scatterProgramId);
+        glUniform1ui(_unifLocScatterDigitShift, digitShift);
+        glDispatchCompute(NumWorkGroups(numBlocks), 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Deletes the scratch buffers.  The next call that needs them makes them again.  Useful 
+    after a very big call (ex: a benchmark) so that its scratch space doesn't stick around.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::ReleaseScratchBuffers()
+{
+    for (size_t level = 0; level < _scanBlockSumBufferIds.size(); level++)
+    {
+        glDeleteBuffers(1, &_scanBlockSumBufferIds[level]);
+    }
+    _scanBlockSumBufferIds.clear();
+    _scanBlockSumNumWords.clear();
+
+    glDeleteBuffers(1, &_compactOffsetsBufferId);
+    glDeleteBuffers(1, &_sortKeysBufferId);
+    glDeleteBuffers(1, &_sortValuesBufferId);
+    glDeleteBuffers(1, &_sortDigitCountsBufferId);
+    _compactOffsetsBufferId = 0;
+    _compactOffsetsNumWords = 0;
+    _sortKeysBufferId = 0;
+    _sortKeysNumWords = 0;
+    _sortValuesBufferId = 0;
+    _sortValuesNumWords = 0;
+    _sortDigitCountsBufferId = 0;
+    _sortDigitCountsNumWords = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Scans each block on its own (scanBlocks.comp).  If there is more than one block, then the 
+    block sums are scanned the same way (one level down) and added back in 
+    (scanAddBlockSums.comp).  Each level has 256 times fewer elements, so 100 million elements 
+    is only 4 levels.
+Parameters:
+    inBufferId      See ExclusiveScan(...).
+    outBufferId     See ExclusiveScan(...).
+    numElements     Self-explanatory.
+    inclusive       True for an inclusive scan, false for exclusive.
+    countNonZero    If true, every input that isn't 0 counts as 1.
+    level           How many levels of block sums down this scan is.  Start at 0.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::Scan(unsigned int inBufferId, unsigned int outBufferId, 
+    unsigned int numElements, bool inclusive, bool countNonZero, unsigned int level)
+{
+    if (numElements == 0)
+    {
+        return;
+    }
+
+    unsigned int numBlocks = (numElements + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    while (_scanBlockSumBufferIds.size() <= level)
+    {
+        _scanBlockSumBufferIds.push_back(0);
+        _scanBlockSumNumWords.push_back(0);
+    }
+    unsigned int blockSumsId = ScratchBuffer(&_scanBlockSumBufferIds[level], 
+        &_scanBlockSumNumWords[level], numBlocks);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SCAN_IN_BINDING, inBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SCAN_OUT_BINDING, outBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SCAN_BLOCK_SUMS_BINDING, blockSumsId);
+    glUseProgram(_scanBlocksProgramId);
+    glUniform1ui(_unifLocScanBlocksNumElements, numElements);
+    glUniform1ui(_unifLocScanBlocksNumBlocks, numBlocks);
+    glUniform1ui(_unifLocScanBlocksInclusive, inclusive ? 1 : 0);
+    glUniform1ui(_unifLocScanBlocksCountNonZero, countNonZero ? 1 : 0);
+    glDispatchCompute(NumWorkGroups(numBlocks), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    if (numBlocks > 1)
+    {
+        Scan(blockSumsId, blockSumsId, numBlocks, false, false, level + 1);
+
+        // the level below used the same bindings
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SCAN_OUT_BINDING, outBufferId);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SCAN_BLOCK_SUMS_BINDING, blockSumsId);
+        glUseProgram(_scanAddProgramId);
+        glUniform1ui(_unifLocScanAddNumElements, numElements);
+        glUniform1ui(_unifLocScanAddNumBlocks, numBlocks);
+        glDispatchCompute(NumWorkGroups(numBlocks), 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Both kinds of compaction: scans "flag isn't 0" into the offsets scratch buffer, then moves 
+    every kept element (or its index) to its offset (compactScatter.comp).
+Parameters:
+    inBufferId      See Compact(...).  Not used if writing indices.
+    flagsBufferId   See Compact(...).
+    outBufferId     See Compact(...).
+    countBufferId   See Compact(...).
+    numElements     Self-explanatory.
+    writeIndices    True to write the kept elements' indices instead of their values.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::CompactElements(unsigned int inBufferId, unsigned int flagsBufferId,
+    unsigned int outBufferId, unsigned int countBufferId, unsigned int numElements, 
+    bool writeIndices)
+{
+    if (numElements == 0)
+    {
+        // nothing is kept, and there's no last element to say so
+        GLuint zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBufferId);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        return;
+    }
+
+    unsigned int offsetsId = ScratchBuffer(&_compactOffsetsBufferId, &_compactOffsetsNumWords,
+        numElements);
+    Scan(flagsBufferId, offsetsId, numElements, false, true, 0);
+
+    // the input isn't read when writing indices, but give its binding something anyway
+    unsigned int numBlocks = (numElements + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMPACT_IN_BINDING, 
+        writeIndices ? flagsBufferId : inBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMPACT_FLAGS_BINDING, flagsBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMPACT_OFFSETS_BINDING, offsetsId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMPACT_OUT_BINDING, outBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMPACT_COUNT_BINDING, countBufferId);
+    glUseProgram(_compactProgramId);
+    glUniform1ui(_unifLocCompactNumElements, numElements);
+    glUniform1ui(_unifLocCompactWriteIndices, writeIndices ? 1 : 0);
+    glDispatchCompute(NumWorkGroups(numBlocks), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    glUseProgram(0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Points the sort's "in" and "out" bindings at one pass's buffers.
+Parameters:
+    keysInId        Self-explanatory.
+    valuesInId      Self-explanatory.
+    keysOutId       Self-explanatory.
+    valuesOutId     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitives::BindSortBuffers(unsigned int keysInId, unsigned int valuesInId,
+    unsigned int keysOutId, unsigned int valuesOutId) const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_KEYS_IN_BINDING, keysInId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_VALUES_IN_BINDING, valuesInId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_KEYS_OUT_BINDING, keysOutId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SORT_VALUES_OUT_BINDING, valuesOutId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes sure that a scratch buffer exists and has room for the given number of uints.  It 
+    only ever grows, and its contents are thrown away when it does.
+Parameters:
+    pBufferId       The buffer's ID (0 if it hasn't been made yet).
+    pNumWords       How many uints it has room for now.
+    numWordsNeeded  Self-explanatory.
+Returns:
+    The buffer's ID.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ComputePrimitives::ScratchBuffer(unsigned int *pBufferId, unsigned int *pNumWords,
+    unsigned int numWordsNeeded)
+{
+    if (*pBufferId == 0)
+    {
+        glGenBuffers(1, pBufferId);
+        *pNumWords = 0;
+    }
+
+    if (*pNumWords < numWordsNeeded)
+    {
+        // Note: Don't bother giving it an initial value.  Every primitive writes all of the 
+        // scratch space that it reads.
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, *pBufferId);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * (GLsizeiptr)numWordsNeeded, 0, 
+            GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        *pNumWords = numWordsNeeded;
+    }
+
+    return *pBufferId;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The parallel building blocks that several of the GPU passes need, as compute shaders that 
+    work on plain buffers of uints:
+    - ExclusiveScan(...)/InclusiveScan(...): prefix sums
+    - Compact(...)/CompactIndices(...): stream compaction (keep only the flagged elements, in 
+    order, and count them)
+    - SortKeyValue(...): a stable radix sort of keys, with values that move with them
+    CpuPrimitives has a CPU version of each one to check them against (see 
+    ComputePrimitivesBenchmark).
+
+    The shaders don't depend on anything else in the program (particle layout, etc.), so this 
+    class builds them itself.  Only make one of these.
+
+    Each primitive needs some scratch space on the GPU (the scan's block sums, the sort's 
+    second pair of buffers, ...).  The scratch buffers grow to fit the biggest call so far and 
+    are kept until ReleaseScratchBuffers().
+
+    Every call binds its buffers to bindings 18-22, which belong to the primitives, so callers 
+    don't need to configure anything, but anything else that uses those bindings has to bind 
+    its own buffers again before its next dispatch.  Every call ends with a memory barrier, so 
+    later shaders can just read the results.
+
+    Note: The buffers can hold more than numElements, but only the first numElements are used.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputePrimitives
+{
+public:
+    ComputePrimitives();
+    ~ComputePrimitives();
+
+    void ExclusiveScan(unsigned int inBufferId, unsigned int outBufferId, 
+        unsigned int numElements);
+    void InclusiveScan(unsigned int inBufferId, unsigned int outBufferId, 
+        unsigned int numElements);
+    void Compact(unsigned int inBufferId, unsigned int flagsBufferId, unsigned int outBufferId,
+        unsigned int countBufferId, unsigned int numElements);
+    void CompactIndices(unsigned int flagsBufferId, unsigned int outBufferId, 
+        unsigned int countBufferId, unsigned int numElements);
+    void SortKeyValue(unsigned int keysBufferId, unsigned int valuesBufferId, 
+        unsigned int numElements, unsigned int numKeyBits);
+
+    void ReleaseScratchBuffers();
+
+    // must match local_size_x in the primitives' shaders
+    static const unsigned int BLOCK_SIZE = 256;
+
+private:
+    void Scan(unsigned int inBufferId, unsigned int outBufferId, unsigned int numElements,
+        bool inclusive, bool countNonZero, unsigned int level);
+    void CompactElements(unsigned int inBufferId, unsigned int flagsBufferId, 
+        unsigned int outBufferId, unsigned int countBufferId, unsigned int numElements, 
+        bool writeIndices);
+    void BindSortBuffers(unsigned int keysInId, unsigned int valuesInId,
+        unsigned int keysOutId, unsigned int valuesOutId) const;
+    static unsigned int ScratchBuffer(unsigned int *pBufferId, unsigned int *pNumWords, 
+        unsigned int numWordsNeeded);
+
+    unsigned int _scanBlocksProgramId;
+    unsigned int _scanAddProgramId;
+    unsigned int _compactProgramId;
+    unsigned int _histogramProgramId;
+    unsigned int _scatterProgramId;
+
+    // unlike most OpeGL IDs, uniform locations are GLint
+    int _unifLocScanBlocksNumElements;
+    int _unifLocScanBlocksNumBlocks;
+    int _unifLocScanBlocksInclusive;
+    int _unifLocScanBlocksCountNonZero;
+    int _unifLocScanAddNumElements;
+    int _unifLocScanAddNumBlocks;
+    int _unifLocCompactNumElements;
+    int _unifLocCompactWriteIndices;
+    int _unifLocHistogramNumElements;
+    int _unifLocHistogramNumBlocks;
+    int _unifLocHistogramDigitShift;
+    int _unifLocScatterNumElements;
+    int _unifLocScatterNumBlocks;
+    int _unifLocScatterDigitShift;
+
+    // scratch buffers and how many words each one has room for
+    // Note: A scan of more than one block scans its block sums, which can have more than one 
+    // block too, so there is a block sum buffer for each level.
+    std::vector<unsigned int> _scanBlockSumBufferIds;
+    std::vector<unsigned int> _scanBlockSumNumWords;
+    unsigned int _compactOffsetsBufferId;
+    unsigned int _compactOffsetsNumWords;
+    unsigned int _sortKeysBufferId;
+    unsigned int _sortKeysNumWords;
+    unsigned int _sortValuesBufferId;
+    unsigned int _sortValuesNumWords;
+    unsigned int _sortDigitCountsBufferId;
+    unsigned int _sortDigitCountsNumWords;
+};
@@ -0,0 +1,502 @@
+#include "ComputePrimitivesBenchmark.h"
+
+#include <stdio.h>
+
+#include "ComputePrimitives.h"
+#include "CpuPrimitives.h"
+#include "RandomStream.h"
+#include "glload/include/glload/gl_4_4.h"
+
+// 1 element, one under/at/over a block, several blocks, enough blocks that the scan's block 
+// sums need another level of block sums (over 65536 elements), and more blocks than one 
+// dispatch can have work groups (65535), which the shaders have to loop over
+static const unsigned int CHECK_SIZES[] = { 1, 255, 256, 257, 1000, 65537, 300000, 17000000 };
+
+// 1 thousand to 100 million
+static const unsigned int BENCHMARK_SIZES[] = 
+{ 
+    1000, 10000, 100000, 1000000, 10000000, 100000000 
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes a buffer with the given contents.
+Parameters:
+    data        Self-explanatory.
+    numWords    How big to make it.  If more than the data, the rest isn't given a value.
+Returns:
+    The buffer's ID, or 0 if there wasn't room for it on the GPU.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static unsigned int MakeBuffer(const std::vector<unsigned int> &data, unsigned int numWords)
+{
+    // clear any earlier error so that an out of memory error is this buffer's
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    GLuint bufferId = 0;
+    glGenBuffers(1, &bufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * (GLsizeiptr)numWords, 0, 
+        GL_DYNAMIC_COPY);
+    if (glGetError() == GL_OUT_OF_MEMORY)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glDeleteBuffers(1, &bufferId);
+        return 0;
+    }
+    if (!data.empty())
+    {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * data.size(), data.data());
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    return bufferId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    bufferId    Self-explanatory.
+    numWords    Self-explanatory.
+    pData       Resized to fit.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void ReadBuffer(unsigned int bufferId, unsigned int numWords, 
+    std::vector<unsigned int> *pData)
+{
+    pData->resize(numWords);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferId);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * numWords, pData->data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    numWords    Self-explanatory.
+    mask        Every number is and-ed with this.
+    seed        Each seed gives different numbers.
+    pData       Resized to fit.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void RandomWords(unsigned int numWords, unsigned int mask, unsigned int seed,
+    std::vector<unsigned int> *pData)
+{
+    RandomStream random(seed);
+    pData->resize(numWords);
+    for (unsigned int index = 0; index < numWords; index++)
+    {
+        (*pData)[index] = random.NextUint() & mask;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the timer query.
+Parameters:
+    pPrimitives     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputePrimitivesBenchmark::ComputePrimitivesBenchmark(ComputePrimitives *pPrimitives) :
+    _pPrimitives(pPrimitives)
+{
+    glGenQueries(1, &_timerQueryId);
+
+    printf("compute primitives benchmark renderer: %s (%s)\n",
+        (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the timer query.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ComputePrimitivesBenchmark::~ComputePrimitivesBenchmark()
+{
+    glDeleteQueries(1, &_timerQueryId);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs every primitive on every one of CHECK_SIZES and compares the results with 
+    CpuPrimitives'.  Prints a line for each size.
+Parameters: None
+Returns:
+    True if every result matched, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputePrimitivesBenchmark::CheckCorrectness() const
+{
+    bool allPassed = true;
+    size_t numSizes = sizeof(CHECK_SIZES) / sizeof(CHECK_SIZES[0]);
+    for (size_t sizeCount = 0; sizeCount < numSizes; sizeCount++)
+    {
+        unsigned int numElements = CHECK_SIZES[sizeCount];
+        bool scansPassed = CheckScans(numElements);
+        bool compactionPassed = CheckCompaction(numElements);
+
+        // 4 bits is a single digit (lots of equal keys, so stability matters), 21 bits is the 
+        // particle sort's Morton keys (not a whole number of digits), and 32 is everything
+        bool sortPassed = CheckSort(numElements, 4) && CheckSort(numElements, 21) && 
+            CheckSort(numElements, 32);
+
+        printf("compute primitives check (%u elements): scan %s, compact %s, sort %s\n",
+            numElements, scansPassed ? "PASSED" : "FAILED", 
+            compactionPassed ? "PASSED" : "FAILED", sortPassed ? "PASSED" : "FAILED");
+        allPassed = allPassed && scansPassed && compactionPassed && sortPassed;
+    }
+
+    _pPrimitives->ReleaseScratchBuffers();
+    return allPassed;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times every primitive on every one of BENCHMARK_SIZES and prints the results.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitivesBenchmark::Run() const
+{
+    GLint maxBlockBytes = 0;
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxBlockBytes);
+
+    size_t numSizes = sizeof(BENCHMARK_SIZES) / sizeof(BENCHMARK_SIZES[0]);
+    for (size_t sizeCount = 0; sizeCount < numSizes; sizeCount++)
+    {
+        unsigned int numElements = BENCHMARK_SIZES[sizeCount];
+        if ((unsigned long long)numElements * sizeof(GLuint) > (unsigned int)maxBlockBytes)
+        {
+            printf("compute primitives (%u elements): skipped (more than the %d byte shader storage block limit)\n",
+                numElements, maxBlockBytes);
+            continue;
+        }
+        RunOnce(numElements);
+
+        // don't let the biggest size's scratch space stick around
+        _pPrimitives->ReleaseScratchBuffers();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks both scans with random numbers that use all 32 bits, so the sums wrap around.
+Parameters:
+    numElements     Self-explanatory.
+Returns:
+    True if both scans matched CpuPrimitives, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputePrimitivesBenchmark::CheckScans(unsigned int numElements) const
+{
+    std::vector<unsigned int> in;
+    RandomWords(numElements, 0xFFFFFFFF, 1, &in);
+    unsigned int inBufferId = MakeBuffer(in, numElements);
+    unsigned int outBufferId = MakeBuffer(std::vector<unsigned int>(), numElements);
+    if (inBufferId == 0 || outBufferId == 0)
+    {
+        fprintf(stderr, "ComputePrimitivesBenchmark::CheckScans(...) error: out of GPU memory for %u elements\n",
+            numElements);
+        glDeleteBuffers(1, &inBufferId);
+        glDeleteBuffers(1, &outBufferId);
+        return false;
+    }
+
+    std::vector<unsigned int> expected;
+    std::vector<unsigned int> actual;
+    CpuPrimitives::ExclusiveScan(in, &expected);
+    _pPrimitives->ExclusiveScan(inBufferId, outBufferId, numElements);
+    ReadBuffer(outBufferId, numElements, &actual);
+    bool passed = (actual == expected);
+
+    // in place, which is how the radix sort uses it
+    CpuPrimitives::InclusiveScan(in, &expected);
+    _pPrimitives->InclusiveScan(inBufferId, inBufferId, numElements);
+    ReadBuffer(inBufferId, numElements, &actual);
+    passed = passed && (actual == expected);
+
+    glDeleteBuffers(1, &inBufferId);
+    glDeleteBuffers(1, &outBufferId);
+    return passed;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks both kinds of compaction, and their counts, with random flags (some of which are 
+    bigger than 1, which still count as "keep").
+Parameters:
+    numElements     Self-explanatory.
+Returns:
+    True if both matched CpuPrimitives, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputePrimitivesBenchmark::CheckCompaction(unsigned int numElements) const
+{
+    std::vector<unsigned int> in;
+    std::vector<unsigned int> flags;
+    RandomWords(numElements, 0xFFFFFFFF, 2, &in);
+    RandomWords(numElements, 0x3, 3, &flags);
+    unsigned int inBufferId = MakeBuffer(in, numElements);
+    unsigned int flagsBufferId = MakeBuffer(flags, numElements);
+    unsigned int outBufferId = MakeBuffer(std::vector<unsigned int>(), numElements);
+    unsigned int countBufferId = MakeBuffer(std::vector<unsigned int>(1, 0xFFFFFFFF), 1);
+    if (inBufferId == 0 || flagsBufferId == 0 || outBufferId == 0 || countBufferId == 0)
+    {
+        fprintf(stderr, "ComputePrimitivesBenchmark::CheckCompaction(...) error: out of GPU memory for %u elements\n",
+            numElements);
+        glDeleteBuffers(1, &inBufferId);
+        glDeleteBuffers(1, &flagsBufferId);
+        glDeleteBuffers(1, &outBufferId);
+        glDeleteBuffers(1, &countBufferId);
+        return false;
+    }
+
+    bool passed = true;
+    for (unsigned int writeIndices = 0; writeIndices < 2; writeIndices++)
+    {
+        std::vector<unsigned int> expected;
+        if (writeIndices == 0)
+        {
+            CpuPrimitives::Compact(in, flags, &expected);
+            _pPrimitives->Compact(inBufferId, flagsBufferId, outBufferId, countBufferId, 
+                numElements);
+        }
+        else
+        {
+            CpuPrimitives::Compact(std::vector<unsigned int>(), flags, &expected);
+            _pPrimitives->CompactIndices(flagsBufferId, outBufferId, countBufferId, 
+                numElements);
+        }
+
+        std::vector<unsigned int> count;
+        std::vector<unsigned int> actual;
+        ReadBuffer(countBufferId, 1, &count);
+        if (count[0] != expected.size())
+        {
+            passed = false;
+            continue;
+        }
+        ReadBuffer(outBufferId, count[0], &actual);
+        passed = passed && (actual == expected);
+    }
+
+    glDeleteBuffers(1, &inBufferId);
+    glDeleteBuffers(1, &flagsBufferId);
+    glDeleteBuffers(1, &outBufferId);
+    glDeleteBuffers(1, &countBufferId);
+    return passed;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks the sort with random keys that fit in the given number of bits.  The values are 
+    random too, so a value that ends up with the wrong key or out of order shows up.
+Parameters:
+    numElements     Self-explanatory.
+    numKeyBits      Self-explanatory.
+Returns:
+    True if both the keys and the values matched CpuPrimitives, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ComputePrimitivesBenchmark::CheckSort(unsigned int numElements, 
+    unsigned int numKeyBits) const
+{
+    unsigned int keyMask = (numKeyBits >= 32) ? 0xFFFFFFFF : ((1u << numKeyBits) - 1);
+    std::vector<unsigned int> keys;
+    std::vector<unsigned int> values;
+    RandomWords(numElements, keyMask, 4 + numKeyBits, &keys);
+    RandomWords(numElements, 0xFFFFFFFF, 5, &values);
+    unsigned int keysBufferId = MakeBuffer(keys, numElements);
+    unsigned int valuesBufferId = MakeBuffer(values, numElements);
+    if (keysBufferId == 0 || valuesBufferId == 0)
+    {
+        fprintf(stderr, "ComputePrimitivesBenchmark::CheckSort(...) error: out of GPU memory for %u elements\n",
+            numElements);
+        glDeleteBuffers(1, &keysBufferId);
+        glDeleteBuffers(1, &valuesBufferId);
+        return false;
+    }
+
+    CpuPrimitives::SortKeyValue(&keys, &values, numKeyBits);
+    _pPrimitives->SortKeyValue(keysBufferId, valuesBufferId, numElements, numKeyBits);
+    std::vector<unsigned int> actualKeys;
+    std::vector<unsigned int> actualValues;
+    ReadBuffer(keysBufferId, numElements, &actualKeys);
+    ReadBuffer(valuesBufferId, numElements, &actualValues);
+
+    glDeleteBuffers(1, &keysBufferId);
+    glDeleteBuffers(1, &valuesBufferId);
+    return (actualKeys == keys) && (actualValues == values);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the exclusive scan, compaction, and a 32-bit key-value sort on one size, checks each 
+    result in a single pass over it, and prints a line for each one.
+Parameters:
+    numElements     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ComputePrimitivesBenchmark::RunOnce(unsigned int numElements) const
+{
+    // small numbers, so that some of them are 0 (not kept by the compaction) and the scan 
+    // doesn't wrap (not that it matters)
+    std::vector<unsigned int> in;
+    RandomWords(numElements, 0xF, 6, &in);
+    unsigned int inBufferId = MakeBuffer(in, numElements);
+    unsigned int outBufferId = MakeBuffer(std::vector<unsigned int>(), numElements);
+    unsigned int countBufferId = MakeBuffer(std::vector<unsigned int>(), 1);
+    if (inBufferId == 0 || outBufferId == 0 || countBufferId == 0)
+    {
+        printf("compute primitives (%u elements): skipped (out of GPU memory)\n", numElements);
+        glDeleteBuffers(1, &inBufferId);
+        glDeleteBuffers(1, &outBufferId);
+        glDeleteBuffers(1, &countBufferId);
+        return;
+    }
+
+    // the first call of each makes the scratch buffers, so it isn't timed
+    std::vector<unsigned int> out;
+    _pPrimitives->ExclusiveScan(inBufferId, outBufferId, numElements);
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int callCount = 0; callCount < NUM_TIMED_CALLS; callCount++)
+    {
+        _pPrimitives->ExclusiveScan(inBufferId, outBufferId, numElements);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    GLuint64 scanNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &scanNs);
+    ReadBuffer(outBufferId, numElements, &out);
+    bool scanPassed = true;
+    unsigned int sum = 0;
+    for (unsigned int index = 0; index < numElements && scanPassed; index++)
+    {
+        scanPassed = (out[index] == sum);
+        sum += in[index];
+    }
+
+    // the numbers are their own flags (keep everything that isn't 0)
+    _pPrimitives->Compact(inBufferId, inBufferId, outBufferId, countBufferId, numElements);
+    glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+    for (unsigned int callCount = 0; callCount < NUM_TIMED_CALLS; callCount++)
+    {
+        _pPrimitives->Compact(inBufferId, inBufferId, outBufferId, countBufferId, numElements);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    GLuint64 compactNs = 0;
+    glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &compactNs);
+    std::vector<unsigned int> count;
+    ReadBuffer(countBufferId, 1, &count);
+    ReadBuffer(outBufferId, numElements, &out);
+    unsigned int numKept = 0;
+    bool compactPassed = true;
+    for (unsigned int index = 0; index < numElements && compactPassed; index++)
+    {
+        if (in[index] != 0)
+        {
+            compactPassed = (out[numKept] == in[index]);
+            numKept++;
+        }
+    }
+    compactPassed = compactPassed && (count[0] == numKept);
+
+    // the sort works in place, so each timed call starts from a fresh copy of the keys
+    // Note: The values are the keys' original indices, so the output can be checked against 
+    // the input without a CPU sort.
+    RandomWords(numElements, 0xFFFFFFFF, 7, &in);
+    std::vector<unsigned int> indices(numElements);
+    for (unsigned int index = 0; index < numElements; index++)
+    {
+        indices[index] = index;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, inBufferId);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * numElements, in.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    unsigned int keysBufferId = MakeBuffer(in, numElements);
+    unsigned int valuesBufferId = MakeBuffer(indices, numElements);
+    if (keysBufferId == 0 || valuesBufferId == 0)
+    {
+        printf("compute primitives (%u elements): exclusive scan %.1f M/s (%s), compact %.1f M/s (%s), sort skipped (out of GPU memory)\n",
+            numElements, 
+            ((double)numElements * NUM_TIMED_CALLS * 1000.0) / (double)scanNs, 
+            scanPassed ? "PASSED" : "FAILED",
+            ((double)numElements * NUM_TIMED_CALLS * 1000.0) / (double)compactNs, 
+            compactPassed ? "PASSED" : "FAILED");
+        glDeleteBuffers(1, &inBufferId);
+        glDeleteBuffers(1, &outBufferId);
+        glDeleteBuffers(1, &countBufferId);
+        glDeleteBuffers(1, &keysBufferId);
+        glDeleteBuffers(1, &valuesBufferId);
+        return;
+    }
+
+    _pPrimitives->SortKeyValue(keysBufferId, valuesBufferId, numElements, 32);
+    GLuint64 sortNs = 0;
+    for (unsigned int callCount = 0; callCount < NUM_TIMED_CALLS; callCount++)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, inBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, keysBufferId);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, 
+            sizeof(GLuint) * numElements);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, valuesBufferId);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(GLuint) * numElements, 
+            indices.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        glBeginQuery(GL_TIME_ELAPSED, _timerQueryId);
+        _pPrimitives->SortKeyValue(keysBufferId, valuesBufferId, numElements, 32);
+        glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(_timerQueryId, GL_QUERY_RESULT, &elapsedNs);
+        sortNs += elapsedNs;
+    }
+
+    // sorted, every key came from where its value says, every value shows up once (so 
+    // nothing was lost or duplicated), and equal keys kept their order
+    std::vector<unsigned int> sortedValues;
+    ReadBuffer(keysBufferId, numElements, &out);
+    ReadBuffer(valuesBufferId, numElements, &sortedValues);
+    std::vector<bool> isValueSeen(numElements, false);
+    bool sortPassed = true;
+    for (unsigned int index = 0; index < numElements && sortPassed; index++)
+    {
+        unsigned int value = sortedValues[index];
+        sortPassed = (value < numElements) && !isValueSeen[value] && (out[index] == in[value]);
+        if (sortPassed && index > 0)
+        {
+            sortPassed = (out[index - 1] < out[index]) || 
+                ((out[index - 1] == out[index]) && (sortedValues[index - 1] < value));
+        }
+        if (sortPassed)
+        {
+            isValueSeen[value] = true;
+        }
+    }
+
+    printf("compute primitives (%u elements): exclusive scan %.1f M/s (%s), compact %.1f M/s (%s), sort %.1f M/s (%s)\n",
+        numElements, 
+        ((double)numElements * NUM_TIMED_CALLS * 1000.0) / (double)scanNs, 
+        scanPassed ? "PASSED" : "FAILED",
+        ((double)numElements * NUM_TIMED_CALLS * 1000.0) / (double)compactNs, 
+        compactPassed ? "PASSED" : "FAILED",
+        ((double)numElements * NUM_TIMED_CALLS * 1000.0) / (double)sortNs, 
+        sortPassed ? "PASSED" : "FAILED");
+
+    glDeleteBuffers(1, &inBufferId);
+    glDeleteBuffers(1, &outBufferId);
+    glDeleteBuffers(1, &countBufferId);
+    glDeleteBuffers(1, &keysBufferId);
+    glDeleteBuffers(1, &valuesBufferId);
+}
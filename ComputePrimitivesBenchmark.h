@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+class ComputePrimitives;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks ComputePrimitives against CpuPrimitives and measures how fast it is.
+    - CheckCorrectness() runs every primitive on the sizes where block-based code usually goes 
+    wrong (1 element, one under/at/over a block, more blocks than one dispatch can have, ...) 
+    and compares every element with the CPU's answer.
+    - Run() times the exclusive scan, compaction, and a full 32-bit key-value sort on 1 
+    thousand to 100 million elements with GL_TIME_ELAPSED queries and prints millions of 
+    elements per second.  Each result is also checked in a single pass over it (a CPU sort of 
+    100 million would take longer than the rest put together), so the timings can't come from 
+    a broken primitive.  Sizes that the driver can't fit in one buffer are skipped.
+
+    Note: Both wait for the GPU and read buffers back, so only use this at startup.  The 
+    numbers only mean something on real hardware; on a software renderer (ex: Mesa's llvmpipe) 
+    this checks correctness and little else.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ComputePrimitivesBenchmark
+{
+public:
+    ComputePrimitivesBenchmark(ComputePrimitives *pPrimitives);
+    ~ComputePrimitivesBenchmark();
+
+    bool CheckCorrectness() const;
+    void Run() const;
+
+private:
+    bool CheckScans(unsigned int numElements) const;
+    bool CheckCompaction(unsigned int numElements) const;
+    bool CheckSort(unsigned int numElements, unsigned int numKeyBits) const;
+    void RunOnce(unsigned int numElements) const;
+
+    // each size is timed over this many calls (after one to make the scratch buffers)
+    static const unsigned int NUM_TIMED_CALLS = 3;
+
+    ComputePrimitives *_pPrimitives;
+    unsigned int _timerQueryId;
+};
@@ -0,0 +1,207 @@
+#include "CounterReadbackRing.h"
+
+#include <stdio.h>
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values (zeros).  Does not make any OpenGL calls (see Init()).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+CounterReadbackRing::CounterReadbackRing() :
+    _bufferId(0),
+    _pMappedSlots(0),
+    _nextSlot(0),
+    _numCaptures(0),
+    _latestValue(0),
+    _latestValueCaptureNumber(0)
+{
+    for (unsigned int slot = 0; slot < RING_DEPTH; slot++)
+    {
+        _slotFences[slot] = 0;
+        _slotCaptureNumbers[slot] = 0;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cleans up the fences and the buffer (which is unmapped first).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+CounterReadbackRing::~CounterReadbackRing()
+{
+    for (unsigned int slot = 0; slot < RING_DEPTH; slot++)
+    {
+        if (_slotFences[slot] != 0)
+        {
+            glDeleteSync((GLsync)_slotFences[slot]);
+        }
+    }
+
+    if (_bufferId != 0)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _bufferId);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glDeleteBuffers(1, &_bufferId);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the ring's buffer and maps it for the life of this object.
+
+    The buffer is immutable storage (glBufferStorage(...)) so that it can stay mapped while the
+    GPU copies into it ("persistent"), and "coherent" so that the GPU's writes are visible to
+    the CPU as soon as the fence after them signals without any extra barrier.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CounterReadbackRing::Init()
+{
+    if (_bufferId != 0)
+    {
+        // already initialized
+        return;
+    }
+
+    GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLsizeiptr bufferSizeBytes = RING_DEPTH * sizeof(GLuint);
+
+    glGenBuffers(1, &_bufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _bufferId);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, bufferSizeBytes, 0, flags);
+    _pMappedSlots = (const GLuint *)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, bufferSizeBytes, flags);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (_pMappedSlots == 0)
+    {
+        fprintf(stderr, "CounterReadbackRing::Init() error: could not map the readback buffer\n");
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Picks up every capture that the GPU has finished since the last call, then queues up a GPU
+    copy of the counter into the next slot, followed by a fence.
+
+    Call it once per frame, right after the shader that writes the counter has been summoned.
+    A shader's writes to a buffer are incoherent, so the copy waits on a 
+    GL_BUFFER_UPDATE_BARRIER_BIT memory barrier before it reads the counter.
+Parameters:
+    sourceBufferId      The buffer with the counter in it (ex: an atomic counter buffer).
+    sourceOffsetBytes   Where the counter is in that buffer.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CounterReadbackRing::Capture(unsigned int sourceBufferId, unsigned int sourceOffsetBytes)
+{
+    if (_pMappedSlots == 0)
+    {
+        // not initialized or couldn't map, so there is nowhere to read back to
+        return;
+    }
+
+    // fences signal in the order that they were put in, so go from oldest to newest and stop
+    // at the first one that the GPU hasn't gotten to yet
+    // Note: A timeout of 0 only asks; it never waits.  The commands are flushed every frame by
+    // the buffer swap, so the fences will eventually signal.
+    for (unsigned int count = 0; count < RING_DEPTH; count++)
+    {
+        unsigned int slot = (_nextSlot + count) % RING_DEPTH;
+        if (_slotFences[slot] == 0)
+        {
+            continue;
+        }
+
+        GLenum waitResult = glClientWaitSync((GLsync)_slotFences[slot], 0, 0);
+        if (waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+        HarvestSlot(slot);
+    }
+
+    // if the GPU is so far behind that the slot to reuse is still pending, then there is no
+    // choice but to wait for it
+    if (_slotFences[_nextSlot] != 0)
+    {
+        GLuint64 oneSecondNs = 1000000000;
+        GLenum waitResult = GL_TIMEOUT_EXPIRED;
+        while (waitResult == GL_TIMEOUT_EXPIRED)
+        {
+            waitResult = glClientWaitSync((GLsync)_slotFences[_nextSlot],
+                GL_SYNC_FLUSH_COMMANDS_BIT, oneSecondNs);
+        }
+        HarvestSlot(_nextSlot);
+    }
+
+    // the counter was just written by a shader
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_COPY_READ_BUFFER, sourceBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _bufferId);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffsetBytes,
+        _nextSlot * sizeof(GLuint), sizeof(GLuint));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    _slotFences[_nextSlot] = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _slotCaptureNumbers[_nextSlot] = _numCaptures;
+    _numCaptures++;
+    _nextSlot = (_nextSlot + 1) % RING_DEPTH;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    The value from the most recent capture that the GPU has finished.  0 until the first one
+    finishes.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int CounterReadbackRing::LatestValue() const
+{
+    return _latestValue;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How many captures ago LatestValue() was captured (0 would mean "this frame's").  Usually 1
+    or 2, and never more than RING_DEPTH.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int CounterReadbackRing::LatencyFrames() const
+{
+    if (_numCaptures == 0)
+    {
+        return 0;
+    }
+
+    return (_numCaptures - 1) - _latestValueCaptureNumber;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads a slot whose fence has signaled and frees the slot.
+Parameters:
+    slot    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CounterReadbackRing::HarvestSlot(unsigned int slot)
+{
+    _latestValue = _pMappedSlots[slot];
+    _latestValueCaptureNumber = _slotCaptureNumbers[slot];
+    glDeleteSync((GLsync)_slotFences[slot]);
+    _slotFences[slot] = 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads a GPU counter (ex: the number of active particles from an atomic counter buffer)
+    back to the CPU without making the CPU wait for the GPU.
+
+    Mapping a buffer that the GPU is still writing to forces the CPU to wait until the GPU has
+    drained everything that came before it, which throws away the CPU/GPU overlap every frame.
+    Instead, each frame's value is copied (on the GPU) into the next slot of a small ring of
+    slots in a persistently mapped buffer and a fence is put in after the copy.  The CPU only
+    reads a slot after its fence has signaled, so reading never stalls.  The price is that the
+    value is a few frames old (see LatencyFrames()).
+
+    If the GPU falls more than RING_DEPTH frames behind, Capture(...) has to wait on the oldest
+    slot before reusing it, which is no worse than the old "copy and map every frame".
+
+    Note: Like the SSBOs, Init() must be called after OpenGL's context is initialized.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class CounterReadbackRing
+{
+public:
+    CounterReadbackRing();
+    ~CounterReadbackRing();
+
+    void Init();
+    void Capture(unsigned int sourceBufferId, unsigned int sourceOffsetBytes);
+
+    unsigned int LatestValue() const;
+    unsigned int LatencyFrames() const;
+
+private:
+    void HarvestSlot(unsigned int slot);
+
+    static const unsigned int RING_DEPTH = 3;
+
+    // one unsigned int per slot
+    unsigned int _bufferId;
+    const unsigned int *_pMappedSlots;
+
+    // 0 if the slot has nothing pending
+    // Note: These are GLsync, but write out the type as void * to save on the large header
+    // inclusion of OpenGL (same as SsboBase's IDs).
+    void *_slotFences[RING_DEPTH];
+    unsigned int _slotCaptureNumbers[RING_DEPTH];
+
+    // the slot that the next capture goes into, which is also the oldest pending one
+    unsigned int _nextSlot;
+    unsigned int _numCaptures;
+
+    unsigned int _latestValue;
+    unsigned int _latestValueCaptureNumber;
+};
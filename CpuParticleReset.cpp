@@ -0,0 +1,296 @@
+#include "CpuParticleReset.h"
+
+#include "ThreadPool.h"
+#include "ParticleRandom.h"
+#include "glm/detail/func_geometric.hpp" // for normalizing glm vectors
+
+#include <stdio.h>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of LinearMix(...) in particleEmitter.glsl.
+Parameters:
+    v1              The start of the linear blend.
+    v2              The end of the linear blend.
+    between0And1    Some fraction of the difference between v1 and v2.
+Returns:
+    A vec4 that is linearly blended according to between0And1.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline glm::vec4 LinearMix(const glm::vec4 &v1, const glm::vec4 &v2, float between0And1)
+{
+    return (v1 * (1.0f - between0And1)) + (v2 * between0And1);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of PointEmitterResetPos(...) in particleEmitter.glsl.  The math is kept
+    exactly the same as the compute shader so that both paths spawn the same cloud.
+Parameters:
+    emitter     The point emitter to spawn at.
+    random      The particle's random numbers (the same ones that the compute shader uses).
+    p           The particle to reset.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void PointEmitterResetPos(const ParticleEmitterPoint &emitter, ParticleRandom &random, 
+    Particle &p)
+{
+    glm::vec4 basePosition = emitter.GetPos();
+    float posX = random.NextOnRangeNeg1ToPos1();
+    float posY = random.NextOnRangeNeg1ToPos1();
+    glm::vec4 outerPosLimit = 0.1f * glm::normalize(glm::vec4(posX, posY, 0.0f, 0.0f));
+    glm::vec4 posVariance = LinearMix(basePosition, outerPosLimit,
+        random.NextOnRange0To1());
+    p._position = basePosition + posVariance;
+
+    float velX = random.NextOnRangeNeg1ToPos1();
+    float velY = random.NextOnRangeNeg1ToPos1();
+    glm::vec4 randomVelocityVector = glm::normalize(glm::vec4(velX, velY, 0.0f, 0.0f));
+    float velocityMagnitude = emitter.GetMinVelocity() +
+        (random.NextOnRange0To1() * emitter.GetDeltaVelocity());
+    p._velocity = randomVelocityVector * velocityMagnitude;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of BarEmitterResetPos(...) in particleEmitter.glsl.
+Parameters:
+    emitter     The bar emitter to spawn along.
+    random      The particle's random numbers (the same ones that the compute shader uses).
+    p           The particle to reset.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void BarEmitterResetPos(const ParticleEmitterBar &emitter, ParticleRandom &random, 
+    Particle &p)
+{
+    glm::vec4 start = emitter.GetBarStart();
+    glm::vec4 startToEnd = emitter.GetBarEnd() - start;
+    p._position = start + (random.NextOnRange0To1() * startToEnd);
+
+    glm::vec4 velocityDir = glm::normalize(emitter.GetEmitDir());
+    float velocityMagnitude = emitter.GetMinVelocity() +
+        (random.NextOnRange0To1() * emitter.GetDeltaVelocity());
+    p._velocity = velocityDir * velocityMagnitude;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters:
+    layoutInfo      How the particles are arranged in the storage that will be given to
+                    SetParticleStorage(...), and how many there are.
+    pThreadPool     Optional.  If provided, the reset is split across the pool's threads.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+CpuParticleReset::CpuParticleReset(const ParticleLayoutInfo &layoutInfo, 
+    ThreadPool *pThreadPool) :
+    _layoutInfo(layoutInfo),
+    _pParticleStorage(0),
+    _pThreadPool(pThreadPool),
+    _particlesPerChunk(layoutInfo.ParticlesPerCacheSizedChunk()),
+    _frameCounter(0)
+{
+    unsigned int numParticles = layoutInfo.NumParticles();
+    unsigned int numChunks = ((numParticles + _particlesPerChunk) - 1) / _particlesPerChunk;
+    _inactiveCountPerChunk.resize(numChunks);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds an emitter to internal storage.  Same rules as ComputeParticleReset::AddEmitter(...).
+Parameters:
+    pEmitter    A pointer to a "particle emitter" interface.
+Returns:
+    True if the emitter was added, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool CpuParticleReset::AddEmitter(const IParticleEmitter *pEmitter)
+{
+    const ParticleEmitterPoint *pointEmitter =
+        dynamic_cast<const ParticleEmitterPoint *>(pEmitter);
+    const ParticleEmitterBar *barEmitter =
+        dynamic_cast<const ParticleEmitterBar *>(pEmitter);
+
+    if (pointEmitter != 0 && (_pointEmitters.size() < MAX_EMITTERS))
+    {
+        _pointEmitters.push_back(pointEmitter);
+        return true;
+    }
+    else if (barEmitter != 0 && (_barEmitters.size() < MAX_EMITTERS))
+    {
+        _barEmitters.push_back(barEmitter);
+        return true;
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells this object where the particles are.  See CpuParticleUpdate::SetParticleStorage(...).
+Parameters:
+    pParticleStorage    The start of a particle buffer that is arranged according to the 
+                        layout that was given to the constructor.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuParticleReset::SetParticleStorage(void *pParticleStorage)
+{
+    _pParticleStorage = pParticleStorage;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    All the particle emitters reset particles to that emitter's location (up to a limit).  See
+    the class description for how this is split up between threads.
+Parameters:
+    particlesPerEmitterPerFrame     Limits the number of particles that are reset per frame so
+                                    that they don't all spawn at once.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuParticleReset::ResetParticles(unsigned int particlesPerEmitterPerFrame)
+{
+    if (_pParticleStorage == 0)
+    {
+        fprintf(stderr, "CpuParticleReset::ResetParticles(...) error: no particle storage\n");
+        return;
+    }
+
+    unsigned int numEmitters = (unsigned int)(_pointEmitters.size() + _barEmitters.size());
+    if (numEmitters == 0 || particlesPerEmitterPerFrame == 0)
+    {
+        // nothing to do
+        return;
+    }
+    _frameCounter++;
+
+    // pass 1: count
+    if (_pThreadPool != 0)
+    {
+        _pThreadPool->ParallelFor(_layoutInfo.NumParticles(), _particlesPerChunk,
+            [this](unsigned int begin, unsigned int end, unsigned int)
+        {
+            CountInactive(begin, end);
+        });
+    }
+    else
+    {
+        CountInactive(0, _layoutInfo.NumParticles());
+    }
+
+    // exclusive prefix sum so that each chunk knows how many inactive particles come before it
+    // Note: There are only a few dozen chunks per 100,000 particles, so this is not worth
+    // spreading out over threads.
+    unsigned int inactiveSoFar = 0;
+    for (size_t chunkIndex = 0; chunkIndex < _inactiveCountPerChunk.size(); chunkIndex++)
+    {
+        unsigned int inactiveInChunk = _inactiveCountPerChunk[chunkIndex];
+        _inactiveCountPerChunk[chunkIndex] = inactiveSoFar;
+        inactiveSoFar += inactiveInChunk;
+    }
+
+    // pass 2: reset
+    if (_pThreadPool != 0)
+    {
+        _pThreadPool->ParallelFor(_layoutInfo.NumParticles(), _particlesPerChunk,
+            [this, particlesPerEmitterPerFrame](unsigned int begin, unsigned int end, unsigned int)
+        {
+            ResetRange(begin, end, particlesPerEmitterPerFrame);
+        });
+    }
+    else
+    {
+        ResetRange(0, _layoutInfo.NumParticles(), particlesPerEmitterPerFrame);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Counts the inactive particles in every chunk within [startIndex, endIndex) and stores the
+    counts in the chunks' slots.
+Parameters:
+    startIndex  The first particle.  Must be the start of a chunk.
+    endIndex    One past the last particle.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuParticleReset::CountInactive(unsigned int startIndex, unsigned int endIndex)
+{
+    for (unsigned int chunkStart = startIndex; chunkStart < endIndex; chunkStart += _particlesPerChunk)
+    {
+        unsigned int chunkEnd = (chunkStart + _particlesPerChunk < endIndex) ?
+            (chunkStart + _particlesPerChunk) : endIndex;
+
+        unsigned int inactiveCount = 0;
+        for (unsigned int particleIndex = chunkStart; particleIndex < chunkEnd; particleIndex++)
+        {
+            int isActive = _layoutInfo.ReadIsActive(_pParticleStorage, particleIndex);
+            inactiveCount += (isActive == 0) ? 1 : 0;
+        }
+        _inactiveCountPerChunk[chunkStart / _particlesPerChunk] = inactiveCount;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Resets the inactive particles in every chunk within [startIndex, endIndex) whose place in
+    the overall "inactive particle" order falls under the emission limit.  Inactive particle
+    number N goes to emitter number (N / particlesPerEmitterPerFrame).
+Parameters:
+    startIndex                      The first particle.  Must be the start of a chunk.
+    endIndex                        One past the last particle.
+    particlesPerEmitterPerFrame     Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuParticleReset::ResetRange(unsigned int startIndex, unsigned int endIndex,
+    unsigned int particlesPerEmitterPerFrame)
+{
+    unsigned int numPointEmitters = (unsigned int)_pointEmitters.size();
+    unsigned int numEmitters = numPointEmitters + (unsigned int)_barEmitters.size();
+    unsigned int maxToEmit = numEmitters * particlesPerEmitterPerFrame;
+
+    for (unsigned int chunkStart = startIndex; chunkStart < endIndex; chunkStart += _particlesPerChunk)
+    {
+        unsigned int chunkIndex = chunkStart / _particlesPerChunk;
+        unsigned int inactiveRank = _inactiveCountPerChunk[chunkIndex];
+        if (inactiveRank >= maxToEmit)
+        {
+            // earlier chunks already used up the limit
+            continue;
+        }
+
+        unsigned int chunkEnd = (chunkStart + _particlesPerChunk < endIndex) ?
+            (chunkStart + _particlesPerChunk) : endIndex;
+        for (unsigned int particleIndex = chunkStart;
+            particleIndex < chunkEnd && inactiveRank < maxToEmit; particleIndex++)
+        {
+            if (_layoutInfo.ReadIsActive(_pParticleStorage, particleIndex) != 0)
+            {
+                continue;
+            }
+
+            // every member is about to be overwritten, so don't bother reading the old one
+            Particle p;
+
+            // same random numbers as the compute shader would use for this particle
+            unsigned int emitterIndex = inactiveRank / particlesPerEmitterPerFrame;
+            ParticleRandom random(_frameCounter, emitterIndex, particleIndex);
+            if (emitterIndex < numPointEmitters)
+            {
+                PointEmitterResetPos(*_pointEmitters[emitterIndex], random, p);
+            }
+            else
+            {
+                BarEmitterResetPos(*_barEmitters[emitterIndex - numPointEmitters], random, p);
+            }
+            p._isActive = 1;
+            _layoutInfo.Write(_pParticleStorage, particleIndex, p);
+            inactiveRank++;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IParticleEmitter.h"
+#include "ParticleEmitterPoint.h"
+#include "ParticleEmitterBar.h"
+#include "ParticleLayout.h"
+#include <vector>
+
+class ThreadPool;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A CPU-side mirror of the "particle reset" compute shader (particleReset.comp) with the same
+    interface as ComputeParticleReset.  Inactive particles are given a new position near an
+    emitter and a new velocity, up to "particles per emitter per frame" for each emitter.
+
+    The compute shader lets each emitter grab inactive particles with an atomic counter.  That
+    doesn't scale across CPU threads, so instead each frame does two passes over cache-sized
+    chunks of the particle array:
+    (1) count the inactive particles in every chunk (in parallel; each chunk writes its own
+    slot)
+    (2) a prefix sum over the chunk counts tells every chunk where its inactive particles fall
+    in the overall "inactive particle" order, so each chunk knows which of its particles to
+    reset and with which emitter without talking to any other chunk (in parallel, and only the
+    chunks that have something to emit do any work)
+
+    Like the compute shader, the first emitter gets first dibs at the inactive particles, then
+    the second emitter, etc.  Point emitters come before bar emitters.
+
+    The particles are read and written according to the particle buffer's layout (see 
+    ParticleLayoutInfo).
+
+    Note: This class does not own the particles, the emitters, or the thread pool.  If no
+    thread pool is provided, everything runs on the calling thread.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class CpuParticleReset
+{
+public:
+    CpuParticleReset(const ParticleLayoutInfo &layoutInfo, ThreadPool *pThreadPool = 0);
+
+    bool AddEmitter(const IParticleEmitter *pEmitter);
+    void SetParticleStorage(void *pParticleStorage);
+
+    void ResetParticles(unsigned int particlesPerEmitterPerFrame);
+
+private:
+    void CountInactive(unsigned int startIndex, unsigned int endIndex);
+    void ResetRange(unsigned int startIndex, unsigned int endIndex,
+        unsigned int particlesPerEmitterPerFrame);
+
+    ParticleLayoutInfo _layoutInfo;
+    void *_pParticleStorage;
+    ThreadPool *_pThreadPool;
+
+    // one entry per chunk; first the number of inactive particles in the chunk, then (after the
+    // prefix sum) the number of inactive particles before the chunk
+    unsigned int _particlesPerChunk;
+    std::vector<unsigned int> _inactiveCountPerChunk;
+
+    // part of the key for the random numbers (see ParticleRandom); counted the same way as 
+    // ComputeParticleReset's so that both make the same particles
+    unsigned int _frameCounter;
+
+    // same limit and storage reasoning as ComputeParticleReset
+    static const int MAX_EMITTERS = 4;
+    std::vector<const ParticleEmitterPoint *> _pointEmitters;
+    std::vector<const ParticleEmitterBar *> _barEmitters;
+};
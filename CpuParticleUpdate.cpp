@@ -0,0 +1,572 @@
+#include "CpuParticleUpdate.h"
+
+#include "ThreadPool.h"
+#include "PolygonFaceGrid.h"
+#include "PolygonWindingTable.h"
+
+// SSE2 is always available on x64, and the AVX2 path is only compiled if the compiler was told
+// that it can use it (the project's x64 configurations build with /arch:AVX2)
+#include <immintrin.h>
+
+#include <stdio.h>
+
+#ifdef __AVX2__
+static const unsigned int PARTICLES_PER_BATCH = 8;
+#else
+static const unsigned int PARTICLES_PER_BATCH = 4;
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Counts the number of set bits in a SIMD comparison mask.  There are at most 8 bits, so a
+    simple loop is fast enough and avoids compiler-specific popcount intrinsics.
+Parameters:
+    mask    The result of _mm_movemask_ps(...) or _mm256_movemask_ps(...).
+Returns:
+    The number of set bits.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline unsigned int CountBits(int mask)
+{
+    unsigned int count = 0;
+    while (mask != 0)
+    {
+        count += (mask & 1);
+        mask >>= 1;
+    }
+    return count;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Where each member that the update needs starts for one batch of particles.  Particle N of 
+    the batch is "stride * N" words after the start (see ParticleLayoutInfo::FieldStride()).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct BatchPointers
+{
+    BatchPointers(void *pParticleStorage, const ParticleLayoutInfo &layoutInfo, 
+        unsigned int firstParticleIndex) :
+        _pIsActive(0),
+        _pActiveBits(0),
+        _activeBitShift(0)
+    {
+        float *pFloats = static_cast<float *>(pParticleStorage);
+        _pPosX = pFloats + layoutInfo.WordIndex(firstParticleIndex, PARTICLE_FIELD_POS_X);
+        _pPosY = pFloats + layoutInfo.WordIndex(firstParticleIndex, PARTICLE_FIELD_POS_Y);
+        _pVelX = pFloats + layoutInfo.WordIndex(firstParticleIndex, PARTICLE_FIELD_VEL_X);
+        _pVelY = pFloats + layoutInfo.WordIndex(firstParticleIndex, PARTICLE_FIELD_VEL_Y);
+        if (layoutInfo.HasActiveBits())
+        {
+            // batches start on a multiple of the batch size, so the whole batch's bits are in 
+            // the same word
+            _pActiveBits = static_cast<unsigned int *>(pParticleStorage) + 
+                layoutInfo.ActiveWordIndex(firstParticleIndex);
+            _activeBitShift = firstParticleIndex % 32;
+        }
+        else
+        {
+            _pIsActive = static_cast<int *>(pParticleStorage) + 
+                layoutInfo.ActiveWordIndex(firstParticleIndex);
+        }
+    }
+
+    float *_pPosX;
+    float *_pPosY;
+    float *_pVelX;
+    float *_pVelY;
+
+    // one or the other, depending on whether the "is active" flag is a word or a bit
+    int *_pIsActive;
+    unsigned int *_pActiveBits;
+    unsigned int _activeBitShift;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Writes the results of a SIMD batch back into the particles.  Only particles that were active
+    are written back, just like the compute shader.
+
+    Note: There is no scatter instruction in SSE or AVX2, so this is done one lane at a time 
+    (except for "is active" bits, which are all in the same word).
+Parameters:
+    batch               Where the batch's members are.
+    stride              The distance between the same member of neighboring particles.
+    newPosX             The integrated X positions of the batch.
+    newPosY             The integrated Y positions of the batch.
+    activeBits          Bit N is set if particle N was active.
+    outOfBoundsBits     Bit N is set if particle N went out of bounds.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline void WriteBackBatch(const BatchPointers &batch, unsigned int stride, 
+    const float *newPosX, const float *newPosY, int activeBits, int outOfBoundsBits)
+{
+    for (unsigned int lane = 0; lane < PARTICLES_PER_BATCH; lane++)
+    {
+        if (activeBits & (1 << lane))
+        {
+            batch._pPosX[lane * stride] = newPosX[lane];
+            batch._pPosY[lane * stride] = newPosY[lane];
+            if ((outOfBoundsBits & (1 << lane)) && batch._pIsActive != 0)
+            {
+                batch._pIsActive[lane * stride] = 0;
+            }
+        }
+    }
+
+    if (batch._pActiveBits != 0)
+    {
+        // the whole batch is deactivated in one go
+        unsigned int deactivatedBits = (unsigned int)(activeBits & outOfBoundsBits);
+        *batch._pActiveBits &= ~(deactivatedBits << batch._activeBitShift);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The scalar equivalent of ParticleOutOfBoundsPolygon(...) in polygonBoundsCheck.glsl.  Used
+    for the leftover particles that don't fill a SIMD batch.
+
+    Note: Like the compute shader, the faces alone only work on convex polygons (see 
+    ParticleRegionPolygon::IsConvex()).  Anything else needs the winding table.  The normals' 
+    Z and W are always 0, so only X and Y matter.
+Parameters:
+    posX            The X position of the particle to check.
+    posY            The Y position of the particle to check.
+    faces           The polygon faces that the particle must stay within.
+    pFaceGrid       Optional.  If provided, only the faces near the particle are checked.
+    pWindingTable   Optional.  If provided, it decides instead of the faces (see 
+                    PolygonWindingTable).
+Returns:
+    True if the particle is on the outside of any face, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool ParticleOutOfBoundsPolygon(float posX, float posY, 
+    const std::vector<PolygonFace> &faces, const PolygonFaceGrid *pFaceGrid,
+    const PolygonWindingTable *pWindingTable)
+{
+    if (pWindingTable != 0)
+    {
+        return pWindingTable->ParticleOutOfBounds(posX, posY);
+    }
+    if (pFaceGrid != 0)
+    {
+        return pFaceGrid->ParticleOutOfBounds(posX, posY, faces);
+    }
+
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        const PolygonFace &f = faces[faceIndex];
+        float faceToParticleX = posX - f._start._position.x;
+        float faceToParticleY = posY - f._start._position.y;
+        float dot = (faceToParticleX * f._start._normal.x) + 
+            (faceToParticleY * f._start._normal.y);
+        if (dot > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks a SIMD batch of particles with a face grid or a winding table.  Each particle is in 
+    its own cell or row, so they are looked up one at a time.
+Parameters:
+    faces           The faces that the grid or table was built from.
+    pFaceGrid       Used if there isn't a winding table.
+    pWindingTable   Optional.
+    pPosX           The batch's X positions.
+    pPosY           The batch's Y positions.
+    activeBits      Which particles in the batch are active.  The rest aren't checked.
+Returns:
+    A mask like _mm_movemask_ps(...) of the particles that are out of bounds.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static int LookupOutOfBoundsBits(const std::vector<PolygonFace> &faces, 
+    const PolygonFaceGrid *pFaceGrid, const PolygonWindingTable *pWindingTable, 
+    const float *pPosX, const float *pPosY, int activeBits)
+{
+    int outOfBoundsBits = 0;
+    for (unsigned int lane = 0; lane < PARTICLES_PER_BATCH; lane++)
+    {
+        if ((activeBits & (1 << lane)) != 0 && ParticleOutOfBoundsPolygon(pPosX[lane], 
+            pPosY[lane], faces, pFaceGrid, pWindingTable))
+        {
+            outOfBoundsBits |= (1 << lane);
+        }
+    }
+
+    return outOfBoundsBits;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Ensures that the object starts object with initialized values.
+Parameters:
+    layoutInfo      How the particles are arranged in the storage that will be given to
+                    SetParticleStorage(...), and how many there are.
+    faces           The polygon faces that particles are checked against.  Must outlive this
+                    object.
+    pThreadPool     Optional.  If provided, the update is split across the pool's threads.
+    pFaceGrid       Optional.  A grid built from the faces.  Must outlive this object.
+    pWindingTable   Optional.  A winding table built from the faces.  Must outlive this 
+                    object.  Takes the place of the grid.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+CpuParticleUpdate::CpuParticleUpdate(const ParticleLayoutInfo &layoutInfo,
+    const std::vector<PolygonFace> &faces, ThreadPool *pThreadPool, 
+    const PolygonFaceGrid *pFaceGrid, const PolygonWindingTable *pWindingTable) :
+    _layoutInfo(layoutInfo),
+    _pParticleStorage(0),
+    _pThreadPool(pThreadPool),
+    _particlesPerChunk(layoutInfo.ParticlesPerCacheSizedChunk()),
+    _faces(faces),
+    _pFaceGrid(pFaceGrid),
+    _pWindingTable(pWindingTable)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells this object where the particles are.  If the particles are in a mapped GPU buffer,
+    then this must be called every time that the buffer is mapped because the driver may give
+    back a different pointer.
+Parameters:
+    pParticleStorage    The start of a particle buffer that is arranged according to the 
+                        layout that was given to the constructor.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuParticleUpdate::SetParticleStorage(void *pParticleStorage)
+{
+    _pParticleStorage = pParticleStorage;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Examines all active particles and:
+    (1) updates their position based on velocity and delta time
+    (2) checks if they have gone outside the polygon bounds, and if so, deactives them
+
+    Same contract as ComputeParticleUpdate::Update(...).
+Parameters:
+    deltaTimeSec    Self-explanatory
+Returns:
+    The number of particles that were active at the start of the update (the compute shader
+    counts active particles before checking bounds, so this does too).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int CpuParticleUpdate::Update(const float deltaTimeSec) const
+{
+    if (_pParticleStorage == 0)
+    {
+        fprintf(stderr, "CpuParticleUpdate::Update(...) error: no particle storage\n");
+        return 0;
+    }
+
+    if (_pThreadPool == 0)
+    {
+        return UpdateRange(0, _layoutInfo.NumParticles(), deltaTimeSec);
+    }
+
+    // each thread only ever touches its own counter, so no atomics are necessary
+    std::vector<PerThreadCounter> activeCountPerThread(_pThreadPool->NumThreads());
+    _pThreadPool->ParallelFor(_layoutInfo.NumParticles(), _particlesPerChunk,
+        [this, deltaTimeSec, &activeCountPerThread](unsigned int begin, unsigned int end,
+        unsigned int threadIndex)
+    {
+        activeCountPerThread[threadIndex]._count += UpdateRange(begin, end, deltaTimeSec);
+    });
+
+    unsigned int numActiveParticles = 0;
+    for (size_t threadIndex = 0; threadIndex < activeCountPerThread.size(); threadIndex++)
+    {
+        numActiveParticles += activeCountPerThread[threadIndex]._count;
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does the work of Update(...) on the particles in the range [startIndex, endIndex).
+
+    Particles are loaded in batches and transposed into "all X positions", "all Y positions",
+    etc. so that each SIMD instruction works on a whole batch at once.  Then each face is
+    broadcast to all lanes and tested against the whole batch (or, with a face grid, each 
+    particle is checked against its cell's faces).  Only the particles that were
+    active are written back, just like the compute shader.
+
+    Note: Positions are only integrated and checked on X and Y.  This is a 2D demo.  The face
+    normals' Z and W are always 0 (see MyVertex), so they don't contribute to the "out of
+    bounds" dot product, and nothing reads the particle's Z or W.
+Parameters:
+    startIndex      The first particle to update.
+    endIndex        One past the last particle to update.
+    deltaTimeSec    Self-explanatory
+Returns:
+    The number of particles in the range that were active at the start of the update.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int CpuParticleUpdate::UpdateRange(unsigned int startIndex, unsigned int endIndex,
+    const float deltaTimeSec) const
+{
+    if (_layoutInfo.IsQuantized())
+    {
+        return UpdateRangeQuantized(startIndex, endIndex, deltaTimeSec);
+    }
+
+    unsigned int numActiveParticles = 0;
+    unsigned int particleIndex = startIndex;
+    unsigned int numFaces = (unsigned int)_faces.size();
+
+    // AoS => gather, SoA/AoSoA => each member of a batch is one contiguous load
+    const unsigned int stride = _layoutInfo.FieldStride();
+    const bool isContiguous = (stride == 1);
+
+#ifdef __AVX2__
+    // gather indices for 8 consecutive particles
+    const __m256i particleOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32((int)stride));
+    const __m256 deltaTime = _mm256_set1_ps(deltaTimeSec);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i one = _mm256_set1_epi32(1);
+
+    for (; particleIndex + PARTICLES_PER_BATCH <= endIndex; particleIndex += PARTICLES_PER_BATCH)
+    {
+        BatchPointers batch(_pParticleStorage, _layoutInfo, particleIndex);
+
+        int activeBits = 0;
+        if (batch._pActiveBits != 0)
+        {
+            // the "is active" bits are already a mask
+            activeBits = (int)((*batch._pActiveBits >> batch._activeBitShift) & 0xFF);
+        }
+        else
+        {
+            __m256i isActive = isContiguous ?
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(batch._pIsActive)) :
+                _mm256_i32gather_epi32(batch._pIsActive, particleOffsets, 4);
+            __m256 activeMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(isActive, one));
+            activeBits = _mm256_movemask_ps(activeMask);
+        }
+        if (activeBits == 0)
+        {
+            // nothing to do in this batch
+            continue;
+        }
+        numActiveParticles += CountBits(activeBits);
+
+        __m256 posX;
+        __m256 posY;
+        __m256 velX;
+        __m256 velY;
+        if (isContiguous)
+        {
+            posX = _mm256_loadu_ps(batch._pPosX);
+            posY = _mm256_loadu_ps(batch._pPosY);
+            velX = _mm256_loadu_ps(batch._pVelX);
+            velY = _mm256_loadu_ps(batch._pVelY);
+        }
+        else
+        {
+            posX = _mm256_i32gather_ps(batch._pPosX, particleOffsets, 4);
+            posY = _mm256_i32gather_ps(batch._pPosY, particleOffsets, 4);
+            velX = _mm256_i32gather_ps(batch._pVelX, particleOffsets, 4);
+            velY = _mm256_i32gather_ps(batch._pVelY, particleOffsets, 4);
+        }
+        posX = _mm256_add_ps(posX, _mm256_mul_ps(velX, deltaTime));
+        posY = _mm256_add_ps(posY, _mm256_mul_ps(velY, deltaTime));
+
+        float newPosX[PARTICLES_PER_BATCH];
+        float newPosY[PARTICLES_PER_BATCH];
+        _mm256_storeu_ps(newPosX, posX);
+        _mm256_storeu_ps(newPosY, posY);
+        if (_pFaceGrid != 0 || _pWindingTable != 0)
+        {
+            WriteBackBatch(batch, stride, newPosX, newPosY, activeBits, LookupOutOfBoundsBits(
+                _faces, _pFaceGrid, _pWindingTable, newPosX, newPosY, activeBits));
+            continue;
+        }
+
+        __m256 outOfBounds = zero;
+        for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+        {
+            const PolygonFace &f = _faces[faceIndex];
+            __m256 faceToParticleX = _mm256_sub_ps(posX, _mm256_set1_ps(f._start._position.x));
+            __m256 faceToParticleY = _mm256_sub_ps(posY, _mm256_set1_ps(f._start._position.y));
+            __m256 dot = _mm256_add_ps(
+                _mm256_mul_ps(faceToParticleX, _mm256_set1_ps(f._start._normal.x)),
+                _mm256_mul_ps(faceToParticleY, _mm256_set1_ps(f._start._normal.y)));
+            outOfBounds = _mm256_or_ps(outOfBounds, _mm256_cmp_ps(dot, zero, _CMP_GT_OQ));
+        }
+
+        WriteBackBatch(batch, stride, newPosX, newPosY, activeBits, 
+            _mm256_movemask_ps(outOfBounds));
+    }
+#else
+    const __m128 deltaTime = _mm_set1_ps(deltaTimeSec);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; particleIndex + PARTICLES_PER_BATCH <= endIndex; particleIndex += PARTICLES_PER_BATCH)
+    {
+        BatchPointers batch(_pParticleStorage, _layoutInfo, particleIndex);
+
+        // SSE has no gather, so AoS is loaded lane by lane (_mm_set_ps(...) takes the highest 
+        // lane first)
+        int activeBits = 0;
+        if (batch._pActiveBits != 0)
+        {
+            // the "is active" bits are already a mask
+            activeBits = (int)((*batch._pActiveBits >> batch._activeBitShift) & 0xF);
+        }
+        else
+        {
+            __m128i isActive = isContiguous ?
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(batch._pIsActive)) :
+                _mm_set_epi32(batch._pIsActive[3 * stride], batch._pIsActive[2 * stride],
+                    batch._pIsActive[stride], batch._pIsActive[0]);
+            __m128 activeMask = _mm_castsi128_ps(_mm_cmpeq_epi32(isActive, _mm_set1_epi32(1)));
+            activeBits = _mm_movemask_ps(activeMask);
+        }
+        if (activeBits == 0)
+        {
+            // nothing to do in this batch
+            continue;
+        }
+        numActiveParticles += CountBits(activeBits);
+
+        __m128 posX;
+        __m128 posY;
+        __m128 velX;
+        __m128 velY;
+        if (isContiguous)
+        {
+            posX = _mm_loadu_ps(batch._pPosX);
+            posY = _mm_loadu_ps(batch._pPosY);
+            velX = _mm_loadu_ps(batch._pVelX);
+            velY = _mm_loadu_ps(batch._pVelY);
+        }
+        else
+        {
+            posX = _mm_set_ps(batch._pPosX[3 * stride], batch._pPosX[2 * stride],
+                batch._pPosX[stride], batch._pPosX[0]);
+            posY = _mm_set_ps(batch._pPosY[3 * stride], batch._pPosY[2 * stride],
+                batch._pPosY[stride], batch._pPosY[0]);
+            velX = _mm_set_ps(batch._pVelX[3 * stride], batch._pVelX[2 * stride],
+                batch._pVelX[stride], batch._pVelX[0]);
+            velY = _mm_set_ps(batch._pVelY[3 * stride], batch._pVelY[2 * stride],
+                batch._pVelY[stride], batch._pVelY[0]);
+        }
+        posX = _mm_add_ps(posX, _mm_mul_ps(velX, deltaTime));
+        posY = _mm_add_ps(posY, _mm_mul_ps(velY, deltaTime));
+
+        float newPosX[PARTICLES_PER_BATCH];
+        float newPosY[PARTICLES_PER_BATCH];
+        _mm_storeu_ps(newPosX, posX);
+        _mm_storeu_ps(newPosY, posY);
+        if (_pFaceGrid != 0 || _pWindingTable != 0)
+        {
+            WriteBackBatch(batch, stride, newPosX, newPosY, activeBits, LookupOutOfBoundsBits(
+                _faces, _pFaceGrid, _pWindingTable, newPosX, newPosY, activeBits));
+            continue;
+        }
+
+        __m128 outOfBounds = zero;
+        for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+        {
+            const PolygonFace &f = _faces[faceIndex];
+            __m128 faceToParticleX = _mm_sub_ps(posX, _mm_set1_ps(f._start._position.x));
+            __m128 faceToParticleY = _mm_sub_ps(posY, _mm_set1_ps(f._start._position.y));
+            __m128 dot = _mm_add_ps(
+                _mm_mul_ps(faceToParticleX, _mm_set1_ps(f._start._normal.x)),
+                _mm_mul_ps(faceToParticleY, _mm_set1_ps(f._start._normal.y)));
+            outOfBounds = _mm_or_ps(outOfBounds, _mm_cmpgt_ps(dot, zero));
+        }
+
+        WriteBackBatch(batch, stride, newPosX, newPosY, activeBits, 
+            _mm_movemask_ps(outOfBounds));
+    }
+#endif
+
+    // leftovers that don't fill a batch
+    for (; particleIndex < endIndex; particleIndex++)
+    {
+        if (_layoutInfo.ReadIsActive(_pParticleStorage, particleIndex) == 1)
+        {
+            BatchPointers p(_pParticleStorage, _layoutInfo, particleIndex);
+            numActiveParticles++;
+            *p._pPosX += *p._pVelX * deltaTimeSec;
+            *p._pPosY += *p._pVelY * deltaTimeSec;
+            if (ParticleOutOfBoundsPolygon(*p._pPosX, *p._pPosY, _faces, _pFaceGrid, 
+                _pWindingTable))
+            {
+                _layoutInfo.WriteIsActive(_pParticleStorage, particleIndex, 0);
+            }
+        }
+    }
+
+    return numActiveParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    UpdateRange(...) for the quantized layout.  Each particle is decoded into floats, updated 
+    and bounds-checked exactly like the float layouts, and then the position is encoded again.
+
+    Note: The "out of bounds" check is made on the float position before it is encoded.  
+    Encoding clamps the position to the region's bounding box, and a particle that is clamped 
+    onto the edge of the box could otherwise land exactly on a face and not count as "out".
+
+    Also Note: There is no SIMD version of this.  Decoding is a handful of integer operations 
+    per particle and there is 1/6th the memory to go through, so it is memory that bounds the 
+    float version, not the arithmetic.  Whole groups of 32 inactive particles are skipped with 
+    a single read.
+Parameters:
+    startIndex      The first particle to update.  A multiple of 32 (see 
+                    ParticleLayoutInfo::ParticlesPerCacheSizedChunk()).
+    endIndex        One past the last particle to update.
+    deltaTimeSec    Self-explanatory
+Returns:
+    The number of particles in the range that were active at the start of the update.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int CpuParticleUpdate::UpdateRangeQuantized(unsigned int startIndex, 
+    unsigned int endIndex, const float deltaTimeSec) const
+{
+    unsigned int *pWords = static_cast<unsigned int *>(_pParticleStorage);
+    unsigned int numActiveParticles = 0;
+    for (unsigned int particleIndex = startIndex; particleIndex < endIndex; particleIndex++)
+    {
+        if ((particleIndex % 32) == 0 && 
+            pWords[_layoutInfo.ActiveWordIndex(particleIndex)] == 0)
+        {
+            // none of the next 32 are active
+            particleIndex += 31;
+            continue;
+        }
+        if (_layoutInfo.ReadIsActive(_pParticleStorage, particleIndex) == 0)
+        {
+            continue;
+        }
+
+        numActiveParticles++;
+        unsigned int &packedPos = pWords[_layoutInfo.WordIndex(particleIndex, PARTICLE_FIELD_POS_X)];
+        unsigned int packedVel = pWords[_layoutInfo.WordIndex(particleIndex, PARTICLE_FIELD_VEL_X)];
+        glm::vec2 pos = _layoutInfo.DecodePosition(packedPos);
+        glm::vec2 vel = ParticleLayoutInfo::DecodeVelocity(packedVel);
+        pos += vel * deltaTimeSec;
+        if (ParticleOutOfBoundsPolygon(pos.x, pos.y, _faces, _pFaceGrid, _pWindingTable))
+        {
+            _layoutInfo.WriteIsActive(_pParticleStorage, particleIndex, 0);
+        }
+        packedPos = _layoutInfo.EncodePosition(pos);
+    }
+
+    return numActiveParticles;
+}
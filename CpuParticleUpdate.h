@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ParticleLayout.h"
+#include "PolygonFace.h"
+#include <vector>
+
+class ThreadPool;
+class PolygonFaceGrid;
+class PolygonWindingTable;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A CPU-side mirror of the "particle update" compute shader (particleUpdate.comp).  It does
+    the same job as ComputeParticleUpdate:
+    (1) integrate the position of every active particle by its velocity and delta time
+    (2) test the new position against every polygon face and deactivate it if it went out of
+    bounds
+    (3) count the number of particles that were active at the start of the update
+
+    The heavy lifting is done with SSE/AVX2 intrinsics.  If the compiler was told that AVX2 is
+    available (/arch:AVX2 in VS, which defines __AVX2__; the x64 configurations turn it on), 
+    then 8 particles are processed per instruction, otherwise SSE2 does 4 at a time.  Any 
+    leftover particles at the end of the array are processed one at a time.
+
+    The kernel follows the particle buffer's layout (see ParticleLayoutInfo).  With AoS, each
+    member of a batch is gathered from particles that are a whole Particle apart.  With SoA and 
+    AoSoA, the same member of neighboring particles are next to each other, so each member of a 
+    batch is a single load and only the members that the update needs are ever touched.  The 
+    quantized layout is decoded and encoded one particle at a time.
+
+    If a face grid is provided (see PolygonFaceGrid), then each particle is only checked 
+    against the faces that its grid cell lists instead of all of them.  That is a lookup per 
+    particle instead of a SIMD test of the whole batch against each face, so it only pays off 
+    when the region has a lot of faces.
+
+    If a winding table is provided (see PolygonWindingTable), then the faces' winding number 
+    decides instead, one particle at a time, so that concave regions and regions with holes 
+    work too.
+
+    If a thread pool is provided, the particles are split into cache-sized chunks that are
+    spread across the pool's threads.  Each thread counts its active particles in its own slot
+    and the slots are added up at the end (the CPU equivalent of each compute shader invocation
+    incrementing the atomic counter, minus the contention).
+
+    This exists for machines that don't have a usable GPU and to compare throughput against
+    the compute shader.
+
+    Note: This class does not own the particles, the polygon faces, the face grid, the winding 
+    table, or the thread pool.  The particle storage can be host memory or a mapped pointer to 
+    the particle SSBO and must be provided before calling Update(...).  The faces are expected 
+    to be the (already transformed) faces of a ParticleRegionPolygon, which stay in the same 
+    place in memory for the life of the region.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class CpuParticleUpdate
+{
+public:
+    CpuParticleUpdate(const ParticleLayoutInfo &layoutInfo, 
+        const std::vector<PolygonFace> &faces, ThreadPool *pThreadPool = 0, 
+        const PolygonFaceGrid *pFaceGrid = 0, const PolygonWindingTable *pWindingTable = 0);
+
+    void SetParticleStorage(void *pParticleStorage);
+    unsigned int Update(const float deltaTimeSec) const;
+
+private:
+    unsigned int UpdateRange(unsigned int startIndex, unsigned int endIndex,
+        const float deltaTimeSec) const;
+    unsigned int UpdateRangeQuantized(unsigned int startIndex, unsigned int endIndex,
+        const float deltaTimeSec) const;
+
+    ParticleLayoutInfo _layoutInfo;
+    void *_pParticleStorage;
+    ThreadPool *_pThreadPool;
+    unsigned int _particlesPerChunk;
+
+    // a reference is safe because the region's collection of faces does not change size
+    const std::vector<PolygonFace> &_faces;
+
+    // optional; must be (re)built from _faces whenever they change
+    const PolygonFaceGrid *_pFaceGrid;
+    const PolygonWindingTable *_pWindingTable;
+};
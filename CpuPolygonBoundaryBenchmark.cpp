@@ -0,0 +1,156 @@
+#include "CpuPolygonBoundaryBenchmark.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+
+#include "PolygonFaceGrid.h"
+#include "PolygonDistanceField.h"
+#include "PolygonWindingTable.h"
+#include "RandomStream.h"
+#include "glm/geometric.hpp"
+
+const float CpuPolygonBoundaryBenchmark::REGION_RADIUS = 0.75f;
+
+// each region is timed with this many faces
+static const unsigned int FACE_COUNTS[] = { 4, 64, 1024, 16384 };
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps what Run() needs.
+Parameters:
+    distanceFieldTexelsPerSide  How big to bake the distance field (same as the demo's).
+    pThreadPool                 Spreads the distance field's bake across all cores.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+CpuPolygonBoundaryBenchmark::CpuPolygonBoundaryBenchmark(unsigned int distanceFieldTexelsPerSide,
+    ThreadPool *pThreadPool) :
+    _distanceFieldTexelsPerSide(distanceFieldTexelsPerSide),
+    _pThreadPool(pThreadPool)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times every check on every one of FACE_COUNTS and prints the results.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPolygonBoundaryBenchmark::Run() const
+{
+    // the region is a circle, so this covers it and a little around it (but stays within the
+    // distance field's margin; farther out, the shaders check every face)
+    float positionMin = -(REGION_RADIUS + 0.01f);
+    float positionRange = 2.0f * (REGION_RADIUS + 0.01f);
+    RandomStream random(1, 0);
+    std::vector<float> posX(NUM_POSITIONS);
+    std::vector<float> posY(NUM_POSITIONS);
+    random.FillBetween(posX.data(), NUM_POSITIONS, positionMin, positionRange);
+    random.FillBetween(posY.data(), NUM_POSITIONS, positionMin, positionRange);
+
+    typedef std::chrono::steady_clock Clock;
+    for (size_t countIndex = 0; countIndex < sizeof(FACE_COUNTS) / sizeof(FACE_COUNTS[0]); countIndex++)
+    {
+        unsigned int numFaces = FACE_COUNTS[countIndex];
+        std::vector<PolygonFace> faces;
+        MakeCircleRegion(numFaces, &faces);
+
+        std::vector<unsigned char> isOutEveryFace(NUM_POSITIONS);
+        Clock::time_point start = Clock::now();
+        for (unsigned int posIndex = 0; posIndex < NUM_POSITIONS; posIndex++)
+        {
+            bool isOut = false;
+            for (unsigned int faceIndex = 0; faceIndex < numFaces && !isOut; faceIndex++)
+            {
+                const PolygonFace &f = faces[faceIndex];
+                isOut = ((posX[posIndex] - f._start._position.x) * f._start._normal.x) +
+                    ((posY[posIndex] - f._start._position.y) * f._start._normal.y) > 0;
+            }
+            isOutEveryFace[posIndex] = isOut ? 1 : 0;
+        }
+        Clock::time_point end = Clock::now();
+        double everyFaceNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        PolygonFaceGrid faceGrid;
+        faceGrid.Build(faces);
+        unsigned int numGridOut = 0;
+        start = Clock::now();
+        for (unsigned int posIndex = 0; posIndex < NUM_POSITIONS; posIndex++)
+        {
+            numGridOut += faceGrid.ParticleOutOfBounds(posX[posIndex], posY[posIndex], faces) ? 1 : 0;
+        }
+        end = Clock::now();
+        double faceGridNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        PolygonDistanceField distanceField;
+        start = Clock::now();
+        distanceField.Bake(faces, _distanceFieldTexelsPerSide, _pThreadPool);
+        end = Clock::now();
+        double bakeMs = std::chrono::duration<double, std::milli>(end - start).count();
+        std::vector<unsigned char> isOutField(NUM_POSITIONS);
+        start = Clock::now();
+        for (unsigned int posIndex = 0; posIndex < NUM_POSITIONS; posIndex++)
+        {
+            float distance = 0.0f;
+            distanceField.Sample(posX[posIndex], posY[posIndex], &distance);
+            isOutField[posIndex] = (distance > 0.0f) ? 1 : 0;
+        }
+        end = Clock::now();
+        double fieldNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        PolygonWindingTable windingTable;
+        windingTable.Build(faces);
+        unsigned int numWindingOut = 0;
+        start = Clock::now();
+        for (unsigned int posIndex = 0; posIndex < NUM_POSITIONS; posIndex++)
+        {
+            numWindingOut += windingTable.ParticleOutOfBounds(posX[posIndex], posY[posIndex]) ? 1 : 0;
+        }
+        end = Clock::now();
+        double windingNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        unsigned int numFieldMismatches = 0;
+        unsigned int numEveryFaceOut = 0;
+        for (unsigned int posIndex = 0; posIndex < NUM_POSITIONS; posIndex++)
+        {
+            numFieldMismatches += (isOutField[posIndex] != isOutEveryFace[posIndex]) ? 1 : 0;
+            numEveryFaceOut += isOutEveryFace[posIndex];
+        }
+
+        printf("boundary test, %5u faces: every face %8.1f ns, face grid %5.1f ns (%u vs %u out), "
+            "distance field %5.1f ns (bake %.1f ms, %u of %u disagree), winding table %5.1f ns "
+            "(%u out) per particle\n",
+            numFaces, everyFaceNs / NUM_POSITIONS, faceGridNs / NUM_POSITIONS, numGridOut,
+            numEveryFaceOut, fieldNs / NUM_POSITIONS, bakeMs, numFieldMismatches, NUM_POSITIONS,
+            windingNs / NUM_POSITIONS, numWindingOut);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes a circle of REGION_RADIUS out of the given number of faces.  They go
+    counterclockwise, so the normals (rotated -90 degrees from each face) point out, just like
+    GeneratePolygonRegion(...) in main.cpp.
+Parameters:
+    numFaces    Self-explanatory.
+    pFaces      Cleared and filled with the faces.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPolygonBoundaryBenchmark::MakeCircleRegion(unsigned int numFaces,
+    std::vector<PolygonFace> *pFaces)
+{
+    pFaces->clear();
+    for (unsigned int faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+        float startAngle = 6.2831853f * (float)faceIndex / numFaces;
+        float endAngle = 6.2831853f * (float)(faceIndex + 1) / numFaces;
+        glm::vec2 faceStart(REGION_RADIUS * cosf(startAngle), REGION_RADIUS * sinf(startAngle));
+        glm::vec2 faceEnd(REGION_RADIUS * cosf(endAngle), REGION_RADIUS * sinf(endAngle));
+        glm::vec2 faceDirection = faceEnd - faceStart;
+        glm::vec2 normal(glm::normalize(glm::vec2(faceDirection.y, -faceDirection.x)));
+        pFaces->push_back(PolygonFace(MyVertex(faceStart, normal), MyVertex(faceEnd, normal)));
+    }
+}
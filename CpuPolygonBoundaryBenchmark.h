@@ -0,0 +1,43 @@
+#pragma once
+
+#include "PolygonFace.h"
+#include <vector>
+
+class ThreadPool;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Times the CPU "out of bounds" check for circular regions with more and more faces, four
+    ways:
+    - checking every face (the cost grows with the faces)
+    - the face grid (see PolygonFaceGrid)
+    - the distance field (see PolygonDistanceField; one sample, so the cost stays flat)
+    - the winding table (see PolygonWindingTable; it also handles regions that aren't convex)
+    The same random positions, in and around the region, are checked every time.  The distance
+    field's disagreements with checking every face are counted too (they are all right next to
+    the boundary; see the field's accuracy note).  Run() prints one line per face count.
+
+    Note: This only times the CPU.  The GPU versions of checking every face and of the distance
+    field are timed by BENCHMARK_FACE_TILES (see ComputeFaceTileBenchmark).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class CpuPolygonBoundaryBenchmark
+{
+public:
+    CpuPolygonBoundaryBenchmark(unsigned int distanceFieldTexelsPerSide,
+        ThreadPool *pThreadPool = 0);
+
+    void Run() const;
+
+private:
+    static void MakeCircleRegion(unsigned int numFaces, std::vector<PolygonFace> *pFaces);
+
+    // every region checks the same positions
+    static const unsigned int NUM_POSITIONS = 100000;
+
+    // the regions are circles with this radius
+    static const float REGION_RADIUS;
+
+    unsigned int _distanceFieldTexelsPerSide;
+    ThreadPool *_pThreadPool;
+};
@@ -0,0 +1,110 @@
+#include "CpuPrimitives.h"
+
+#include <algorithm>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    out[i] = in[0] + ... + in[i - 1], and out[0] = 0.
+Parameters:
+    in      Self-explanatory.
+    pOut    Resized to match the input.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPrimitives::ExclusiveScan(const std::vector<unsigned int> &in, 
+    std::vector<unsigned int> *pOut)
+{
+    pOut->resize(in.size());
+    unsigned int sum = 0;
+    for (size_t index = 0; index < in.size(); index++)
+    {
+        unsigned int value = in[index];
+        (*pOut)[index] = sum;
+        sum += value;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    out[i] = in[0] + ... + in[i].
+Parameters:
+    in      Self-explanatory.
+    pOut    Resized to match the input.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPrimitives::InclusiveScan(const std::vector<unsigned int> &in, 
+    std::vector<unsigned int> *pOut)
+{
+    pOut->resize(in.size());
+    unsigned int sum = 0;
+    for (size_t index = 0; index < in.size(); index++)
+    {
+        sum += in[index];
+        (*pOut)[index] = sum;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps the input elements whose flags aren't 0, in order.
+Parameters:
+    in      If empty, the kept elements' indices are kept instead (the same as 
+            ComputePrimitives::CompactIndices(...)).
+    flags   One per element.
+    pOut    Cleared, then gets the kept elements.  Its size is the count.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPrimitives::Compact(const std::vector<unsigned int> &in, 
+    const std::vector<unsigned int> &flags, std::vector<unsigned int> *pOut)
+{
+    pOut->clear();
+    for (size_t index = 0; index < flags.size(); index++)
+    {
+        if (flags[index] != 0)
+        {
+            pOut->push_back(in.empty() ? (unsigned int)index : in[index]);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stable sort by the lowest numKeyBits of the keys, smallest first.  The values move with 
+    their keys.  The keys keep all of their bits (only the order is decided by the low ones), 
+    which is also what the radix sort does.
+Parameters:
+    pKeys       Self-explanatory.
+    pValues     The same size as the keys.
+    numKeyBits  1 to 32.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void CpuPrimitives::SortKeyValue(std::vector<unsigned int> *pKeys, 
+    std::vector<unsigned int> *pValues, unsigned int numKeyBits)
+{
+    unsigned int keyMask = (numKeyBits >= 32) ? 0xFFFFFFFF : ((1u << numKeyBits) - 1);
+    const std::vector<unsigned int> &keys = *pKeys;
+
+    std::vector<unsigned int> order(keys.size());
+    for (size_t index = 0; index < order.size(); index++)
+    {
+        order[index] = (unsigned int)index;
+    }
+    std::stable_sort(order.begin(), order.end(), 
+        [&keys, keyMask](unsigned int a, unsigned int b)
+    {
+        return (keys[a] & keyMask) < (keys[b] & keyMask);
+    });
+
+    std::vector<unsigned int> sortedKeys(keys.size());
+    std::vector<unsigned int> sortedValues(keys.size());
+    for (size_t index = 0; index < order.size(); index++)
+    {
+        sortedKeys[index] = keys[order[index]];
+        sortedValues[index] = (*pValues)[order[index]];
+    }
+    pKeys->swap(sortedKeys);
+    pValues->swap(sortedValues);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Plain, single-threaded versions of ComputePrimitives' scan, compaction, and sort.  They 
+    are written to be obviously right rather than fast, and are what the compute versions are 
+    checked against (see ComputePrimitivesBenchmark).
+
+    Like the compute versions, sums wrap around at 2^32 and the sort is stable.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class CpuPrimitives
+{
+public:
+    static void ExclusiveScan(const std::vector<unsigned int> &in, 
+        std::vector<unsigned int> *pOut);
+    static void InclusiveScan(const std::vector<unsigned int> &in, 
+        std::vector<unsigned int> *pOut);
+    static void Compact(const std::vector<unsigned int> &in, 
+        const std::vector<unsigned int> &flags, std::vector<unsigned int> *pOut);
+    static void SortKeyValue(std::vector<unsigned int> *pKeys, 
+        std::vector<unsigned int> *pValues, unsigned int numKeyBits);
+};
@@ -0,0 +1,126 @@
+#include "FixedTimestepScheduler.h"
+
+#include "Stopwatch.h"
+
+#include <stdio.h>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values.  Nothing is scheduled until Start(...) is called.
+Parameters:
+    stepSec             The simulated time of every step.
+    maxStepsPerFrame    The spiral of death guard (see the class description).  At least 1.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+FixedTimestepScheduler::FixedTimestepScheduler(float stepSec, unsigned int maxStepsPerFrame) :
+    _pStopwatch(0),
+    _stepSec(stepSec),
+    _maxStepsPerFrame(maxStepsPerFrame),
+    _lastTimeSec(0.0),
+    _accumulatedSec(0.0),
+    _droppedSec(0.0),
+    _numStepsThisFrame(0),
+    _emissionCarry(0.0)
+{
+    if (_maxStepsPerFrame == 0)
+    {
+        fprintf(stderr, "FixedTimestepScheduler::FixedTimestepScheduler(...) error: max steps per frame must be at least 1\n");
+        _maxStepsPerFrame = 1;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Starts counting time from now.
+Parameters:
+    pStopwatch  Must already be started.  Only its TotalTime() is used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void FixedTimestepScheduler::Start(Stopwatch *pStopwatch)
+{
+    _pStopwatch = pStopwatch;
+    _lastTimeSec = _pStopwatch->TotalTime();
+    _accumulatedSec = 0.0;
+    _droppedSec = 0.0;
+    _numStepsThisFrame = 0;
+    _emissionCarry = 0.0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Call once per rendered frame.  Adds the time since the last call and takes out as many 
+    whole steps as fit, up to the maximum.
+Parameters: None
+Returns:
+    How many steps of StepSec() to run this frame.  Can be 0.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int FixedTimestepScheduler::Advance()
+{
+    if (_pStopwatch == 0)
+    {
+        fprintf(stderr, "FixedTimestepScheduler::Advance() error: not started\n");
+        return 0;
+    }
+
+    double nowSec = _pStopwatch->TotalTime();
+    _accumulatedSec += nowSec - _lastTimeSec;
+    _lastTimeSec = nowSec;
+
+    // spiral of death guard: never keep more than a frame's worth of steps
+    double maxAccumulatedSec = (double)_stepSec * _maxStepsPerFrame;
+    if (_accumulatedSec > maxAccumulatedSec)
+    {
+        _droppedSec += _accumulatedSec - maxAccumulatedSec;
+        _accumulatedSec = maxAccumulatedSec;
+    }
+
+    _numStepsThisFrame = (unsigned int)(_accumulatedSec / _stepSec);
+    _accumulatedSec -= (double)_stepSec * _numStepsThisFrame;
+    return _numStepsThisFrame;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.  Call after Advance().
+Parameters:
+    particlesPerSec     The rate, in particles per simulated second.
+Returns:
+    How many particles to emit during the steps that the last Advance() handed out.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int FixedTimestepScheduler::TakeEmission(float particlesPerSec)
+{
+    _emissionCarry += (double)particlesPerSec * _stepSec * _numStepsThisFrame;
+    unsigned int numToEmit = (unsigned int)_emissionCarry;
+    _emissionCarry -= numToEmit;
+    return numToEmit;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    The simulated time of every step.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float FixedTimestepScheduler::StepSec() const
+{
+    return _stepSec;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How much real time the spiral of death guard has thrown away since Start(...).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+double FixedTimestepScheduler::DroppedTimeSec() const
+{
+    return _droppedSec;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+class Stopwatch;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Decides how many fixed-size simulation steps each rendered frame runs.  The simulation 
+    then moves at the same speed in real time no matter how fast the frames are drawn, and 
+    every step is the same size, so the particles take the same paths at any frame rate.
+
+    Each frame, Advance() adds the real time since the last frame to an accumulator and takes 
+    as many whole steps out of it as fit.  The leftover carries into the next frame.  At 
+    high frame rates some frames get 0 steps; at low frame rates a frame gets several, and 
+    the caller runs them together (ex: the update shader loops over them in one dispatch).
+
+    Spiral of death guard: if a frame takes too long, catching up would need more steps, 
+    which would make the next frame take longer still.  So no frame runs more than the 
+    maximum number of steps, and any real time beyond that is dropped (the simulation slows 
+    down instead of falling further behind).  DroppedTimeSec() says how much has been 
+    dropped.
+
+    Emission is a rate too.  TakeEmission(...) turns a "particles per second" rate into the 
+    number of particles to emit for the steps that this frame runs, and carries the fraction 
+    that is left over so that low rates still emit on average.
+
+    Note: The time comes from the stopwatch's TotalTime(), which doesn't change the stopwatch, 
+    so it can share the frame rate counter's stopwatch without disturbing its Lap().  Every 
+    Stopwatch shares its counters (see Stopwatch.cpp), so don't make a second one for this.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class FixedTimestepScheduler
+{
+public:
+    FixedTimestepScheduler(float stepSec, unsigned int maxStepsPerFrame);
+
+    void Start(Stopwatch *pStopwatch);
+    unsigned int Advance();
+    unsigned int TakeEmission(float particlesPerSec);
+
+    float StepSec() const;
+    double DroppedTimeSec() const;
+
+private:
+    Stopwatch *_pStopwatch;
+    float _stepSec;
+    unsigned int _maxStepsPerFrame;
+
+    double _lastTimeSec;
+    double _accumulatedSec;
+    double _droppedSec;
+
+    // how many steps the last Advance() handed out, for TakeEmission(...)
+    unsigned int _numStepsThisFrame;
+
+    // the fraction of a particle that couldn't be emitted yet
+    double _emissionCarry;
+};
@@ -1,7 +1,7 @@
 #include "MinMaxVelocity.h"
 
 #include "glm/detail/func_geometric.hpp" // for normalizing glm vectors
-#include "RandomToast.h"
+#include "RandomStream.h"
 
 
 /*-----------------------------------------------------------------------------------------------
@@ -67,31 +67,60 @@ Description:
     Generates a new velocity vector between the previously provided minimum and maximum values
     (or 0 if nothing was set after this object was instatiated) and in the provided direction 
     (or a random direction if no direction was set).
-Parameters: None
+Parameters: 
+    random  The calling thread's random numbers.
 Returns:    
     A 2D vector whose magnitude is between the initialized "min" and "max" values and whose 
     direction is random.
 Creator:    John Cox (7-2-2016)
 -----------------------------------------------------------------------------------------------*/
-glm::vec4 MinMaxVelocity::GetNew() const
+glm::vec4 MinMaxVelocity::GetNew(RandomStream &random) const
 {
-    //float velocityVariation = ((float)rand() * INVERSE_RAND_MAX) * _velocityDelta;
-    float velocityVariation = RandomOnRange0to1() * _velocityDelta;
-    float velocityMagnitude = _min + velocityVariation;
-    
-    if (_useRandomDir)
-    {
-        // create a normalized random vector, then multiple all items by the magnitude
-        // Note: The hard-coded mod100 is just to prevent the random axis magnitudes from 
-        // getting too crazy different from each other.
-        float newX = (float)(RandomPosAndNeg() % 100);
-        float newY = (float)(RandomPosAndNeg() % 100);
-        glm::vec4 randomVelocityVector = glm::normalize(glm::vec4(newX, newY, 0.0f, 0.0f));
-        return (randomVelocityVector * velocityMagnitude);
-    }
-    else  // read, "don't use random direction"
+    glm::vec4 velocity;
+    GetNew(random, &velocity, 1);
+    return velocity;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Like GetNew(...), but for lots of velocities at once.  The magnitudes and directions are 
+    made in batches (see RandomStream) on the stack, so this doesn't allocate anything.
+Parameters: 
+    random      The calling thread's random numbers.
+    pVelocities Where to put the new velocities.
+    count       How many.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void MinMaxVelocity::GetNew(RandomStream &random, glm::vec4 *pVelocities, 
+    unsigned int count) const
+{
+    const unsigned int BATCH_SIZE = 256;
+    float magnitudes[BATCH_SIZE];
+    glm::vec2 directions[BATCH_SIZE];
+
+    for (unsigned int batchStart = 0; batchStart < count; batchStart += BATCH_SIZE)
     {
-        return (_dir * velocityMagnitude);
+        unsigned int batchCount = (count - batchStart < BATCH_SIZE) ? 
+            (count - batchStart) : BATCH_SIZE;
+        random.FillBetween(magnitudes, batchCount, _min, _velocityDelta);
+
+        if (_useRandomDir)
+        {
+            random.FillDirections(directions, batchCount);
+            for (unsigned int index = 0; index < batchCount; index++)
+            {
+                pVelocities[batchStart + index] = 
+                    glm::vec4(directions[index], 0.0f, 0.0f) * magnitudes[index];
+            }
+        }
+        else  // read, "don't use random direction"
+        {
+            for (unsigned int index = 0; index < batchCount; index++)
+            {
+                pVelocities[batchStart + index] = _dir * magnitudes[index];
+            }
+        }
     }
 }
 
@@ -3,6 +3,8 @@
 #include "glm/vec2.hpp"
 #include "glm/vec4.hpp"
 
+class RandomStream;
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Each particle emitter needs be able to generate a velocity direction and magnitude within
@@ -22,7 +24,8 @@ public:
     void SetDir(const glm::vec2 &dir);
     void UseRandomDir();
 
-    glm::vec4 GetNew() const;
+    glm::vec4 GetNew(RandomStream &random) const;
+    void GetNew(RandomStream &random, glm::vec4 *pVelocities, unsigned int count) const;
     float GetMinVelocity() const;
     float GetDeltaVelocity() const;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "glm/vec2.hpp"
 #include "glm/vec4.hpp"
 
 /*-----------------------------------------------------------------------------------------------
@@ -44,3 +45,45 @@ struct Particle
     int _isActive; 
     float integerBuffer[3]; // pads out the integer to 16 bytes to match the GPU's version
 };
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The compact version of a Particle that is stored in the particle buffer when the 
+    PARTICLE_LAYOUT_COMPACT_2D layout is used (see ParticleLayout.h).  This is a 2D demo, so 
+    only X and Y are kept, and the "is active" flag is moved out into a bit field (1 bit per 
+    particle) at the start of the buffer.  That is 16 bytes and 1 bit instead of 48 bytes.
+
+    Must match the CompactParticle structure in particleLayout.glsl.
+
+    Note: The rest of the program still works with Particle.  ParticleLayoutInfo converts 
+    between the two.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleCompact2D
+{
+    glm::vec2 _position;
+    glm::vec2 _velocity;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The quantized version of ParticleCompact2D that is stored in the particle buffer when the 
+    PARTICLE_LAYOUT_QUANTIZED_2D layout is used (see ParticleLayout.h).  
+    - position: X and Y are each a 16-bit unsigned normalized integer (0 to 65535) across the 
+    particle region's bounding box
+    - velocity: X and Y are each a 16-bit half float
+    That is 8 bytes and 1 bit instead of 48 bytes.
+
+    The particles never leave the region (they are deactivated when they do), so a float's 
+    range is wasted on position.  Across a bounding box that is ~2 window units wide, 16 bits 
+    is a step of ~0.00003, which is far less than a pixel.
+
+    Must match the packing in particleLayout.glsl, which uses the GLSL packUnorm2x16(...) and 
+    packHalf2x16(...) (glm has the same functions, so the CPU side matches bit for bit).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleQuantized2D
+{
+    unsigned int _packedPosition;
+    unsigned int _packedVelocity;
+};
@@ -0,0 +1,131 @@
+#include "ParticleDeadListSsbo.h"
+
+#include <stdio.h>
+#include <string.h>     // for memcpy
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls the base class to give members initial values (zeros).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleDeadListSsbo::ParticleDeadListSsbo() :
+    SsboBase()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Exists to be declared virtual so that the base class' destructor is called
+    upon object death.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleDeadListSsbo::~ParticleDeadListSsbo()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the buffer and fills the list with the index of every inactive particle (at 
+    startup, that is all of them).  Same restrictions as ParticleSsbo::Init(...).
+Parameters: 
+    allParticles    The same particles that were given to the particle SSBO.  The buffer has 
+                    room for the index of every one of them.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDeadListSsbo::Init(const std::vector<Particle> &allParticles)
+{
+    if (_bufferId != 0)
+    {
+        // only let the buffer size be set once
+        return;
+    }
+
+    ParticleDeadListHeader header;
+    header._numWorkGroupsX = 0;
+    header._numWorkGroupsY = 1;
+    header._numWorkGroupsZ = 1;
+    header._numToReset = 0;
+    header._popStart = 0;
+    header._numDeadIndices = 0;
+
+    // pushed in reverse so that the first particles to come off the top are the first ones in 
+    // the particle buffer (not necessary, but it keeps the buffer's start dense)
+    std::vector<unsigned int> deadIndices;
+    deadIndices.reserve(allParticles.size());
+    for (size_t particleIndex = allParticles.size(); particleIndex > 0; particleIndex--)
+    {
+        if (allParticles[particleIndex - 1]._isActive == 0)
+        {
+            deadIndices.push_back((unsigned int)(particleIndex - 1));
+        }
+    }
+    header._numDeadIndices = (unsigned int)deadIndices.size();
+
+    // the header and then room for every particle's index
+    unsigned int headerWords = sizeof(ParticleDeadListHeader) / sizeof(unsigned int);
+    std::vector<unsigned int> bufferWords(headerWords + allParticles.size(), 0);
+    memcpy(bufferWords.data(), &header, sizeof(header));
+    if (!deadIndices.empty())
+    {
+        memcpy(bufferWords.data() + headerWords, deadIndices.data(), 
+            deadIndices.size() * sizeof(unsigned int));
+    }
+
+    glGenBuffers(1, &_bufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferWords.size() * sizeof(unsigned int), 
+        bufferWords.data(), GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    _hasBeenInitialized = true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+Parameters: 
+    computeProgramId    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDeadListSsbo::ConfigureCompute(unsigned int computeProgramId)
+{
+    if (!_hasBeenInitialized)
+    {
+        fprintf(stderr, "ParticleDeadListSsbo::ConfigureCompute(...) error: SSBO has not been initialized\n");
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+
+    // see the corresponding area in ParticleSsbo::Init(...) for explanation
+    // Note: MUST use the same binding point 
+    GLuint ssboBindingPointIndex = 5;   // not 3 (particles) or 13 (polygon faces)
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "DeadListBuffer");
+    glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  The dead list is never drawn.
+Parameters: 
+    renderProgramId     Not used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDeadListSsbo::ConfigureRender(unsigned int renderProgramId)
+{
+    // this statement is only to get rid of an "unreferenced parameter" warning
+    (void)renderProgramId;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "SsboBase.h"
+#include "Particle.h"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The front of the "dead list" buffer.  The first three members double as the arguments for 
+    glDispatchComputeIndirect(...), so they must stay first and in this order.  Must match the 
+    DeadListBuffer in particleDeadList.glsl.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleDeadListHeader
+{
+    // indirect dispatch arguments for the "particle reset" shader
+    unsigned int _numWorkGroupsX;
+    unsigned int _numWorkGroupsY;
+    unsigned int _numWorkGroupsZ;
+
+    // how many indices the current reset pass pops and where they start in the list
+    unsigned int _numToReset;
+    unsigned int _popStart;
+
+    // how many indices are in the list
+    unsigned int _numDeadIndices;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that keeps a stack of the indices of inactive ("dead") particles.  
+
+    The "particle update" shader pushes a particle's index when the particle goes out of 
+    bounds.  Before each "particle reset" pass, the "dead list pop" shader takes up to the 
+    frame's spawn budget off the top of the stack and writes the indirect dispatch 
+    arguments, so the reset shader is only summoned for the particles that it will actually 
+    reset instead of for every particle in the buffer (see ComputeParticleReset).
+
+    Note: The stack can never hold more than every particle.  A particle is pushed once when 
+    it goes inactive and can't be pushed again until it has been popped and reset.  This only 
+    holds if the reset and update both happen on the GPU.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleDeadListSsbo : public SsboBase
+{
+public:
+    ParticleDeadListSsbo();
+    virtual ~ParticleDeadListSsbo();
+
+    void Init(const std::vector<Particle> &allParticles);
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+};
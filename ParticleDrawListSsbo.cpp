@@ -0,0 +1,141 @@
+#include "ParticleDrawListSsbo.h"
+
+#include <stdio.h>
+#include <string.h>     // for memcpy
+#include <vector>
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A header with a count of 0 and the rest of the draw command filled out.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static ParticleDrawListHeader EmptyDrawListHeader()
+{
+    ParticleDrawListHeader header;
+    header._count = 0;
+    header._instanceCount = 1;
+    header._firstIndex = sizeof(ParticleDrawListHeader) / sizeof(unsigned int);
+    header._baseVertex = 0;
+    header._baseInstance = 0;
+    return header;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls the base class to give members initial values (zeros).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleDrawListSsbo::ParticleDrawListSsbo() :
+    SsboBase()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Exists to be declared virtual so that the base class' destructor is called
+    upon object death.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleDrawListSsbo::~ParticleDrawListSsbo()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the buffer with room for the header and the index of every particle.  The list
+    starts out empty.  Same restrictions as ParticleSsbo::Init(...).
+Parameters:
+    numParticles    How many particles are in the particle buffer.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDrawListSsbo::Init(unsigned int numParticles)
+{
+    if (_bufferId != 0)
+    {
+        // only let the buffer size be set once
+        return;
+    }
+
+    ParticleDrawListHeader header = EmptyDrawListHeader();
+    unsigned int headerWords = sizeof(ParticleDrawListHeader) / sizeof(unsigned int);
+    std::vector<unsigned int> bufferWords(headerWords + numParticles, 0);
+    memcpy(bufferWords.data(), &header, sizeof(header));
+
+    glGenBuffers(1, &_bufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferWords.size() * sizeof(unsigned int),
+        bufferWords.data(), GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    _hasBeenInitialized = true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+Parameters:
+    computeProgramId    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDrawListSsbo::ConfigureCompute(unsigned int computeProgramId)
+{
+    if (!_hasBeenInitialized)
+    {
+        fprintf(stderr, "ParticleDrawListSsbo::ConfigureCompute(...) error: SSBO has not been initialized\n");
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+
+    // see the corresponding area in ParticleSsbo::Init(...) for explanation
+    // Note: MUST use the same binding point
+    GLuint ssboBindingPointIndex = 7;   // not 3 (particles), 5 (dead list), 6 (emitters), or 13 (faces)
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "DrawListBuffer");
+    glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  The draw list isn't drawn on its own.  It is bound as the draw indirect and
+    element buffers alongside the particle VAO at draw time.
+Parameters:
+    renderProgramId     Not used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDrawListSsbo::ConfigureRender(unsigned int renderProgramId)
+{
+    // this statement is only to get rid of an "unreferenced parameter" warning
+    (void)renderProgramId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Empties the list before the compute shaders fill it again.  Only the header is uploaded;
+    the old indices past the new count are never read.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleDrawListSsbo::ClearCount()
+{
+    ParticleDrawListHeader header = EmptyDrawListHeader();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(header), (void *)&header);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
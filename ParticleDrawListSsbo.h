@@ -0,0 +1,53 @@
+#pragma once
+
+#include "SsboBase.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The front of the "draw list" buffer.  It is the command structure that
+    glDrawElementsIndirect(...) reads, so the members must stay in this order.  Must match the
+    DrawListBuffer in particleDrawList.glsl.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleDrawListHeader
+{
+    // the number of active particle indices that follow (written by the compute shaders)
+    unsigned int _count;
+
+    unsigned int _instanceCount;
+
+    // the indices start right after this header, and the "first index" is counted in indices
+    // from the start of the element buffer (which is this same buffer)
+    unsigned int _firstIndex;
+
+    int _baseVertex;
+    unsigned int _baseInstance;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that lists the indices of every particle that is still active after
+    the "particle update" (or the fused "particle reset and update") compute shader.  Each
+    active particle appends its own index and bumps the count in the header, so the header is
+    a ready-to-go indirect draw command and the rest of the buffer is its element buffer.
+
+    Drawing with it (glDrawElementsIndirect(...), see main.cpp's Display()) only sends the
+    active particles to the rasterizer, and the CPU never needs to know how many there are.
+    Each index is the particle's index in the particle buffer, so the particle VAO's vertex
+    attributes and gl_VertexID (vertex pulling) both still find the right particle.
+
+    Note: The count must be set back to 0 with ClearCount() before every update.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleDrawListSsbo : public SsboBase
+{
+public:
+    ParticleDrawListSsbo();
+    virtual ~ParticleDrawListSsbo();
+
+    void Init(unsigned int numParticles);
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+
+    void ClearCount();
+};
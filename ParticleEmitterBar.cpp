@@ -1,7 +1,5 @@
 #include "ParticleEmitterBar.h"
 
-#include "RandomToast.h"
-
 /*-----------------------------------------------------------------------------------------------
 Description:
     Ensures that the object starts object with initialized values.
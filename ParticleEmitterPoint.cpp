@@ -1,6 +1,5 @@
 #include "ParticleEmitterPoint.h"
 
-#include "RandomToast.h"
 #include "glm/detail/func_geometric.hpp" // for normalizing glm vectors
 
 /*-----------------------------------------------------------------------------------------------
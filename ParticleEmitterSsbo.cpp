@@ -0,0 +1,194 @@
+#include "ParticleEmitterSsbo.h"
+
+#include <stdio.h>
+#include <string.h>     // for memcmp(...)
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls the base class to give members initial values (zeros).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleEmitterSsbo::ParticleEmitterSsbo() :
+    SsboBase(),
+    _bufferSizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Exists to be declared virtual so that the base class' destructor is called
+    upon object death.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleEmitterSsbo::~ParticleEmitterSsbo()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the SSBO, but does not allocate space for it.  That happens in
+    UpdateValues(...).  Same restrictions as PolygonSsbo::Init().
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterSsbo::Init()
+{
+    if (_bufferId == 0)
+    {
+        glGenBuffers(1, &_bufferId);
+    }
+
+    _hasBeenInitialized = true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+Parameters:
+    computeProgramId    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterSsbo::ConfigureCompute(unsigned int computeProgramId)
+{
+    if (!_hasBeenInitialized)
+    {
+        fprintf(stderr, "ParticleEmitterSsbo::ConfigureCompute(...) error: SSBO has not been initialized\n");
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+
+    // see the corresponding area in ParticleSsbo::Init(...) for explanation
+    // Note: MUST use the same binding point
+    GLuint ssboBindingPointIndex = 6;   // not 3 (particles), 5 (dead list), or 13 (faces)
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "EmitterBuffer");
+    glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Emitters are never drawn.
+Parameters:
+    renderProgramId     Not used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterSsbo::ConfigureRender(unsigned int renderProgramId)
+{
+    // this statement is only to get rid of an "unreferenced parameter" warning
+    (void)renderProgramId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Dumps the given emitters into the SSBO.  The buffer only grows, so a frame with fewer
+    emitters than the last one reuses the existing space.  If the emitters are the same as 
+    what was uploaded last time, nothing is uploaded.
+
+    Note: Comparing the bytes is safe because every GpuParticleEmitter is value-initialized, 
+    so the padding is always 0.
+
+    Note: The buffer ID doesn't change when the buffer grows, so the binding from
+    ConfigureCompute(...) still holds.
+Parameters:
+    allEmitters     Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleEmitterSsbo::UpdateValues(const std::vector<GpuParticleEmitter> &allEmitters)
+{
+    if (allEmitters.empty())
+    {
+        return;
+    }
+
+    if (allEmitters.size() == _uploadedEmitters.size() &&
+        memcmp(allEmitters.data(), _uploadedEmitters.data(), sizeof(GpuParticleEmitter) * allEmitters.size()) == 0)
+    {
+        // already there
+        return;
+    }
+    _uploadedEmitters = allEmitters;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    unsigned int byteCounter = sizeof(GpuParticleEmitter) * allEmitters.size();
+    if (byteCounter > _bufferSizeBytes)
+    {
+        _bufferSizeBytes = byteCounter;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _bufferSizeBytes, allEmitters.data(), GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, byteCounter, allEmitters.data());
+    }
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Flattens the point and bar emitters into the form that the compute shaders use, lays their 
+    spawn slots end to end (an exclusive prefix sum of the spawn counts), and uploads them.
+
+    Note: Points come before bars, so the first point emitter gets first dibs at the inactive 
+    particles.
+Parameters:
+    pointEmitters           Self-explanatory
+    barEmitters             Self-explanatory
+    particlesPerEmitter     How many particles each emitter may reset this frame.
+Returns:
+    The total number of spawn slots (the frame's spawn budget across every emitter).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleEmitterSsbo::UpdateValues(
+    const std::vector<const ParticleEmitterPoint *> &pointEmitters,
+    const std::vector<const ParticleEmitterBar *> &barEmitters, 
+    unsigned int particlesPerEmitter)
+{
+    _flattenedEmitters.clear();
+    unsigned int spawnStart = 0;
+    for (size_t pointEmitterCount = 0; pointEmitterCount < pointEmitters.size(); pointEmitterCount++)
+    {
+        const ParticleEmitterPoint *emitter = pointEmitters[pointEmitterCount];
+        GpuParticleEmitter gpuEmitter = GpuParticleEmitter();
+        gpuEmitter._pos1 = emitter->GetPos();
+        gpuEmitter._minVelocity = emitter->GetMinVelocity();
+        gpuEmitter._deltaVelocity = emitter->GetDeltaVelocity();
+        gpuEmitter._isBar = 0;
+        gpuEmitter._spawnStart = spawnStart;
+        gpuEmitter._spawnCount = particlesPerEmitter;
+        spawnStart += particlesPerEmitter;
+        _flattenedEmitters.push_back(gpuEmitter);
+    }
+    for (size_t barEmitterCount = 0; barEmitterCount < barEmitters.size(); barEmitterCount++)
+    {
+        const ParticleEmitterBar *emitter = barEmitters[barEmitterCount];
+        GpuParticleEmitter gpuEmitter = GpuParticleEmitter();
+        gpuEmitter._pos1 = emitter->GetBarStart();
+        gpuEmitter._pos2 = emitter->GetBarEnd();
+        gpuEmitter._emitDir = emitter->GetEmitDir();
+        gpuEmitter._minVelocity = emitter->GetMinVelocity();
+        gpuEmitter._deltaVelocity = emitter->GetDeltaVelocity();
+        gpuEmitter._isBar = 1;
+        gpuEmitter._spawnStart = spawnStart;
+        gpuEmitter._spawnCount = particlesPerEmitter;
+        spawnStart += particlesPerEmitter;
+        _flattenedEmitters.push_back(gpuEmitter);
+    }
+
+    UpdateValues(_flattenedEmitters);
+    return spawnStart;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "SsboBase.h"
+#include "ParticleEmitterPoint.h"
+#include "ParticleEmitterBar.h"
+#include "glm/vec4.hpp"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One particle emitter as the compute shaders see it.  Point and bar emitters share
+    this structure, and _isBar says which one it is.  Must match the ParticleEmitter structure
+    in particleEmitter.glsl.
+
+    Each emitter gets a contiguous range of the frame's "spawn slots"
+    [_spawnStart, _spawnStart + _spawnCount).  The starts are an exclusive prefix sum of the
+    counts, so the shader can find which emitter owns a slot without any emitter waiting on
+    another one.
+
+    Note: std430 rounds the size of a structure up to its largest member (a vec4), so the
+    padding at the end is required to keep the CPU and GPU array strides the same (80 bytes).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct GpuParticleEmitter
+{
+    // point emitter: _pos1 is the center
+    // bar emitter: _pos1 and _pos2 are the ends of the bar
+    glm::vec4 _pos1;
+    glm::vec4 _pos2;
+
+    // bar emitter only
+    glm::vec4 _emitDir;
+
+    float _minVelocity;
+    float _deltaVelocity;
+    unsigned int _isBar;
+    unsigned int _spawnStart;
+    unsigned int _spawnCount;
+    unsigned int _padding[3];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that holds every particle emitter.  It is given the emitters once per 
+    frame (see ComputeParticleReset::ResetParticles(...)) so that all emitters can reset 
+    particles in a single dispatch of the "particle reset" shader, but it is only uploaded when 
+    they changed.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleEmitterSsbo : public SsboBase
+{
+public:
+    ParticleEmitterSsbo();
+    virtual ~ParticleEmitterSsbo();
+
+    void Init();
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+
+    void UpdateValues(const std::vector<GpuParticleEmitter> &allEmitters);
+    unsigned int UpdateValues(const std::vector<const ParticleEmitterPoint *> &pointEmitters,
+        const std::vector<const ParticleEmitterBar *> &barEmitters, 
+        unsigned int particlesPerEmitter);
+
+private:
+    unsigned int _bufferSizeBytes;
+
+    // reused every frame so that flattening the emitters doesn't allocate
+    std::vector<GpuParticleEmitter> _flattenedEmitters;
+
+    // what is in the buffer right now, so that a frame whose emitters haven't changed (ex: 
+    // when the shaders do the transforms) doesn't upload them again
+    std::vector<GpuParticleEmitter> _uploadedEmitters;
+};
@@ -0,0 +1,526 @@
+#include "ParticleLayout.h"
+
+#include "ThreadPool.h"
+#include <string.h>     // for memcpy
+#include <stdio.h>
+
+// GPUs (and CPUs, for that matter) don't read single words from memory; they read whole
+// "sectors" of a cache line, so the traffic estimate counts every sector that is touched
+// Note: 32 bytes is the sector size on most desktop GPUs.
+static const unsigned int MEMORY_SECTOR_BYTES = 32;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Figures out the block size and the words per block for the requested layout (see the class
+    description).
+Parameters:
+    layout          Self-explanatory.
+    numParticles    The total number of particles in the buffer.
+    quantizeMin     Only used by the quantized layout.  The lower left corner of the box that 
+                    particle positions are stored relative to.  Should be the particle region's 
+                    bounding box (see ParticleRegionPolygon::GetBoundingBox(...)).
+    quantizeMax     The upper right corner of the same.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleLayoutInfo::ParticleLayoutInfo(ParticleLayout layout, unsigned int numParticles,
+    const glm::vec2 &quantizeMin, const glm::vec2 &quantizeMax) :
+    _layout(layout),
+    _numParticles(numParticles),
+    _blockSize(1),
+    _wordsPerBlock(sizeof(Particle) / sizeof(unsigned int)),
+    _numBlocks(numParticles),
+    _hasActiveBits(false),
+    _firstParticleWord(0),
+    _quantizeMin(quantizeMin),
+    _quantizeExtent(quantizeMax - quantizeMin)
+{
+    for (int field = 0; field < PARTICLE_FIELD_COUNT; field++)
+    {
+        _fieldSlot[field] = field;
+    }
+
+    if (layout == PARTICLE_LAYOUT_SOA)
+    {
+        _blockSize = (numParticles > 0) ? numParticles : 1;
+    }
+    else if (layout == PARTICLE_LAYOUT_AOSOA_8)
+    {
+        _blockSize = 8;
+    }
+    else if (layout == PARTICLE_LAYOUT_AOSOA_16)
+    {
+        _blockSize = 16;
+    }
+    else if (layout == PARTICLE_LAYOUT_COMPACT_2D)
+    {
+        // only X and Y of position and velocity get a word; everything else is left out
+        _wordsPerBlock = sizeof(ParticleCompact2D) / sizeof(unsigned int);
+        for (int field = 0; field < PARTICLE_FIELD_COUNT; field++)
+        {
+            _fieldSlot[field] = -1;
+        }
+        _fieldSlot[PARTICLE_FIELD_POS_X] = 0;
+        _fieldSlot[PARTICLE_FIELD_POS_Y] = 1;
+        _fieldSlot[PARTICLE_FIELD_VEL_X] = 2;
+        _fieldSlot[PARTICLE_FIELD_VEL_Y] = 3;
+
+        // one bit per particle, rounded up to 16 bytes so that the particles after it line 
+        // up with the GPU's alignment for the CompactParticle structure
+        _hasActiveBits = true;
+        unsigned int numBitWords = (numParticles + 31) / 32;
+        _firstParticleWord = (numBitWords + 3) & ~3u;
+    }
+    else if (layout == PARTICLE_LAYOUT_QUANTIZED_2D)
+    {
+        // X and Y share a word, so only the X fields get a slot
+        _wordsPerBlock = sizeof(ParticleQuantized2D) / sizeof(unsigned int);
+        for (int field = 0; field < PARTICLE_FIELD_COUNT; field++)
+        {
+            _fieldSlot[field] = -1;
+        }
+        _fieldSlot[PARTICLE_FIELD_POS_X] = 0;
+        _fieldSlot[PARTICLE_FIELD_VEL_X] = 1;
+
+        // same bit field as the compact layout
+        _hasActiveBits = true;
+        unsigned int numBitWords = (numParticles + 31) / 32;
+        _firstParticleWord = (numBitWords + 3) & ~3u;
+
+        if (_quantizeExtent.x <= 0.0f || _quantizeExtent.y <= 0.0f)
+        {
+            fprintf(stderr, "ParticleLayoutInfo error: quantization bounds are empty; using window space\n");
+            _quantizeMin = glm::vec2(-1.0f);
+            _quantizeExtent = glm::vec2(2.0f);
+        }
+    }
+    else if (layout != PARTICLE_LAYOUT_AOS)
+    {
+        fprintf(stderr, "ParticleLayoutInfo error: unknown layout '%d'; using AoS\n", layout);
+        _layout = PARTICLE_LAYOUT_AOS;
+    }
+
+    if (_layout == PARTICLE_LAYOUT_SOA || _layout == PARTICLE_LAYOUT_AOSOA_8 ||
+        _layout == PARTICLE_LAYOUT_AOSOA_16)
+    {
+        // no padding between the fields; the only padding is at the end of the last block
+        _wordsPerBlock = PARTICLE_FIELD_COUNT * _blockSize;
+        _numBlocks = ((numParticles + _blockSize) - 1) / _blockSize;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleLayout ParticleLayoutInfo::Layout() const
+{
+    return _layout;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A printable name for the layout.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const char *ParticleLayoutInfo::Name() const
+{
+    switch (_layout)
+    {
+    case PARTICLE_LAYOUT_SOA:
+        return "SoA";
+    case PARTICLE_LAYOUT_AOSOA_8:
+        return "AoSoA 8";
+    case PARTICLE_LAYOUT_AOSOA_16:
+        return "AoSoA 16";
+    case PARTICLE_LAYOUT_COMPACT_2D:
+        return "Compact 2D";
+    case PARTICLE_LAYOUT_QUANTIZED_2D:
+        return "Quantized 2D";
+    default:
+        return "AoS";
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleLayoutInfo::NumParticles() const
+{
+    return _numParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  The CPU kernels split work into chunks that are a multiple of this so that a SIMD
+    batch never straddles two blocks.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleLayoutInfo::BlockSize() const
+{
+    return _blockSize;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How big the particle SSBO needs to be for this layout.  AoS includes the padding at the end
+    of every Particle, AoSoA includes the padding at the end of the last block, and the compact 
+    and quantized layouts include the "is active" bit field.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleLayoutInfo::BufferSizeBytes() const
+{
+    return (_firstParticleWord + (_numBlocks * _wordsPerBlock)) * sizeof(unsigned int);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How many particles the CPU particle reset and update should give each thread at a time (see 
+    ThreadPool::ItemsPerCacheSizedChunk(...)).  It is rounded so that a chunk never splits 
+    something that two threads can't share:
+    - an AoSoA block (a SIMD batch must not straddle two blocks)
+    - a group of 32 particles whose "is active" bits share a word
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleLayoutInfo::ParticlesPerCacheSizedChunk() const
+{
+    unsigned int bytesPerParticle = (_numParticles == 0) ? 
+        sizeof(Particle) : (BufferSizeBytes() / _numParticles);
+    if (bytesPerParticle == 0)
+    {
+        bytesPerParticle = 1;
+    }
+    unsigned int particlesPerChunk = ThreadPool::ItemsPerCacheSizedChunk(bytesPerParticle);
+
+    // both are powers of 2, so the bigger one is a multiple of the smaller one
+    unsigned int alignment = _hasActiveBits ? 32 : 1;
+    if (_blockSize < _numParticles && _blockSize > alignment)
+    {
+        alignment = _blockSize;
+    }
+
+    if (particlesPerChunk < alignment)
+    {
+        return alignment;
+    }
+    return particlesPerChunk - (particlesPerChunk % alignment);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The #defines that tell particleLayout.glsl which layout to use.  Give these to
+    ShaderStorage::AddShaderFile(...) for every shader that includes particleLayout.glsl.
+Parameters: None
+Returns:
+    One or more lines of "#define ...".
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+std::string ParticleLayoutInfo::ShaderDefines() const
+{
+    char defines[256];
+    if (_layout == PARTICLE_LAYOUT_AOS)
+    {
+        // the shaders use the original array of Particle structures
+        return "#define PARTICLE_LAYOUT_AOS\n";
+    }
+    else if (_layout == PARTICLE_LAYOUT_COMPACT_2D)
+    {
+        sprintf(defines, "#define PARTICLE_LAYOUT_COMPACT_2D\n#define PARTICLE_ACTIVE_BIT_WORDS %u\n",
+            _firstParticleWord);
+        return defines;
+    }
+    else if (_layout == PARTICLE_LAYOUT_QUANTIZED_2D)
+    {
+        // Note: 9 significant digits is enough to get the exact same float back, so the GPU 
+        // decodes positions with the same bounds as DecodePosition(...).
+        sprintf(defines, "#define PARTICLE_LAYOUT_QUANTIZED_2D\n#define PARTICLE_ACTIVE_BIT_WORDS %u\n"
+            "#define PARTICLE_QUANTIZE_MIN vec2(%.9g, %.9g)\n"
+            "#define PARTICLE_QUANTIZE_EXTENT vec2(%.9g, %.9g)\n",
+            _firstParticleWord, _quantizeMin.x, _quantizeMin.y, _quantizeExtent.x, _quantizeExtent.y);
+        return defines;
+    }
+
+    sprintf(defines, "#define PARTICLE_BLOCK_SIZE %uu\n#define PARTICLE_WORDS_PER_BLOCK %uu\n",
+        _blockSize, _wordsPerBlock);
+    return defines;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  True if positions and velocities are packed (see EncodePosition(...) and 
+    EncodeVelocity(...)) instead of stored as floats.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleLayoutInfo::IsQuantized() const
+{
+    return _layout == PARTICLE_LAYOUT_QUANTIZED_2D;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The distance between two neighboring quantized positions on X and on Y.  A round trip 
+    through EncodePosition(...) and DecodePosition(...) is off by at most half of this.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+glm::vec2 ParticleLayoutInfo::PositionQuantizationStep() const
+{
+    return _quantizeExtent / 65535.0f;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Pulls one particle out of a buffer with this layout.  Not intended for inner loops; the
+    CPU kernels read only the fields that they need.  Fields that this layout doesn't store 
+    are 0.
+Parameters:
+    pStorage        The start of the particle buffer.
+    particleIndex   Self-explanatory.
+Returns:
+    A copy of the particle.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+Particle ParticleLayoutInfo::Read(const void *pStorage, unsigned int particleIndex) const
+{
+    const unsigned int *pWords = static_cast<const unsigned int *>(pStorage);
+    Particle p;
+    if (IsQuantized())
+    {
+        glm::vec2 pos = DecodePosition(pWords[WordIndex(particleIndex, PARTICLE_FIELD_POS_X)]);
+        glm::vec2 vel = DecodeVelocity(pWords[WordIndex(particleIndex, PARTICLE_FIELD_VEL_X)]);
+        p._position = glm::vec4(pos, 0.0f, 0.0f);
+        p._velocity = glm::vec4(vel, 0.0f, 0.0f);
+        p._isActive = ReadIsActive(pStorage, particleIndex);
+        return p;
+    }
+
+    for (int field = PARTICLE_FIELD_POS_X; field <= PARTICLE_FIELD_POS_W; field++)
+    {
+        if (IsFieldStored((ParticleField)field))
+        {
+            memcpy(&p._position[field - PARTICLE_FIELD_POS_X],
+                pWords + WordIndex(particleIndex, (ParticleField)field), sizeof(float));
+        }
+    }
+    for (int field = PARTICLE_FIELD_VEL_X; field <= PARTICLE_FIELD_VEL_W; field++)
+    {
+        if (IsFieldStored((ParticleField)field))
+        {
+            memcpy(&p._velocity[field - PARTICLE_FIELD_VEL_X],
+                pWords + WordIndex(particleIndex, (ParticleField)field), sizeof(float));
+        }
+    }
+    p._isActive = ReadIsActive(pStorage, particleIndex);
+
+    return p;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Puts one particle into a buffer with this layout.  Padding and fields that this layout 
+    doesn't store are not touched.
+
+    Note: With the compact and quantized layouts, this changes a word that is shared with 31 
+    other particles (see WriteIsActive(...)).
+
+    Also Note: With the quantized layout, the position is clamped to the quantization bounds.
+Parameters:
+    pStorage        The start of the particle buffer.
+    particleIndex   Self-explanatory.
+    p               Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleLayoutInfo::Write(void *pStorage, unsigned int particleIndex,
+    const Particle &p) const
+{
+    unsigned int *pWords = static_cast<unsigned int *>(pStorage);
+    if (IsQuantized())
+    {
+        pWords[WordIndex(particleIndex, PARTICLE_FIELD_POS_X)] = 
+            EncodePosition(glm::vec2(p._position));
+        pWords[WordIndex(particleIndex, PARTICLE_FIELD_VEL_X)] = 
+            EncodeVelocity(glm::vec2(p._velocity));
+        WriteIsActive(pStorage, particleIndex, p._isActive);
+        return;
+    }
+
+    for (int field = PARTICLE_FIELD_POS_X; field <= PARTICLE_FIELD_POS_W; field++)
+    {
+        if (IsFieldStored((ParticleField)field))
+        {
+            memcpy(pWords + WordIndex(particleIndex, (ParticleField)field),
+                &p._position[field - PARTICLE_FIELD_POS_X], sizeof(float));
+        }
+    }
+    for (int field = PARTICLE_FIELD_VEL_X; field <= PARTICLE_FIELD_VEL_W; field++)
+    {
+        if (IsFieldStored((ParticleField)field))
+        {
+            memcpy(pWords + WordIndex(particleIndex, (ParticleField)field),
+                &p._velocity[field - PARTICLE_FIELD_VEL_X], sizeof(float));
+        }
+    }
+    WriteIsActive(pStorage, particleIndex, p._isActive);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Rearranges a collection of particles into this layout (ex: for the initial upload in
+    ParticleSsbo::Init(...)).
+Parameters:
+    allParticles    Must have NumParticles() particles.
+    pWords          Resized to fit BufferSizeBytes() and filled.  Padding is 0.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleLayoutInfo::Pack(const std::vector<Particle> &allParticles,
+    std::vector<unsigned int> *pWords) const
+{
+    pWords->assign(BufferSizeBytes() / sizeof(unsigned int), 0);
+    unsigned int numToPack = (allParticles.size() < _numParticles) ?
+        (unsigned int)allParticles.size() : _numParticles;
+    for (unsigned int particleIndex = 0; particleIndex < numToPack; particleIndex++)
+    {
+        Write(pWords->data(), particleIndex, allParticles[particleIndex]);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The opposite of Pack(...).
+Parameters:
+    pStorage        The start of a particle buffer with this layout.
+    pAllParticles   Resized to NumParticles() and filled.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleLayoutInfo::Unpack(const void *pStorage, std::vector<Particle> *pAllParticles) const
+{
+    pAllParticles->resize(_numParticles);
+    for (unsigned int particleIndex = 0; particleIndex < _numParticles; particleIndex++)
+    {
+        (*pAllParticles)[particleIndex] = Read(pStorage, particleIndex);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "bytes moved" estimate.  Walks through the same memory accesses that the particle
+    compute shaders make in one frame and counts every memory sector that they touch if the
+    particles were stored in this layout:
+    - each reset pass reads every particle's "is active" flag (there is one per frame, or none 
+    if the reset is fused into the update)
+    - the update pass reads every particle's "is active" flag, and for active particles, reads
+    the X and Y position and velocity and writes the X and Y position
+
+    Each pass is assumed to start with a cold cache (100,000 particles don't fit in cache).
+    Resetting and deactivating particles is rare enough compared to the rest to leave out.
+
+    This is an estimate, not a measurement of the hardware, but it is exact for what it counts
+    and it explains most of the frame rate difference between layouts.  For a measurement of 
+    the same accesses on the GPU, see ComputeParticleLayoutBenchmark.
+Parameters:
+    allParticles    The particle states to simulate with (ex: Unpack(...)'d from the SSBO, so
+                    that the active/inactive mix is realistic).
+    numResetPasses  How many times a separate reset shader scans the particles per frame.
+Returns:
+    The average number of bytes moved to and from memory per particle per frame.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float ParticleLayoutInfo::EstimateFrameBytesPerParticle(const std::vector<Particle> &allParticles,
+    unsigned int numResetPasses) const
+{
+    if (allParticles.empty())
+    {
+        return 0.0f;
+    }
+
+    unsigned int numParticles = (allParticles.size() < _numParticles) ?
+        (unsigned int)allParticles.size() : _numParticles;
+    unsigned int numSectors =
+        ((BufferSizeBytes() + MEMORY_SECTOR_BYTES) - 1) / MEMORY_SECTOR_BYTES;
+    std::vector<unsigned char> sectorRead(numSectors);
+    std::vector<unsigned char> sectorWritten(numSectors);
+
+    // a reset pass only looks at the "is active" flag
+    unsigned int sectorsPerResetPass = 0;
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        unsigned int sector = (ActiveWordIndex(particleIndex) * sizeof(unsigned int)) / 
+            MEMORY_SECTOR_BYTES;
+        sectorsPerResetPass += (sectorRead[sector] == 0) ? 1 : 0;
+        sectorRead[sector] = 1;
+    }
+
+    // the update pass picks up where the reset pass' "is active" reads left off
+    static const ParticleField readFields[] =
+    {
+        PARTICLE_FIELD_POS_X, PARTICLE_FIELD_POS_Y, PARTICLE_FIELD_VEL_X, PARTICLE_FIELD_VEL_Y
+    };
+    static const ParticleField writtenFields[] =
+    {
+        PARTICLE_FIELD_POS_X, PARTICLE_FIELD_POS_Y
+    };
+    unsigned int sectorsPerUpdatePass = sectorsPerResetPass;
+    for (unsigned int particleIndex = 0; particleIndex < numParticles; particleIndex++)
+    {
+        if (allParticles[particleIndex]._isActive == 0)
+        {
+            continue;
+        }
+
+        for (size_t fieldIndex = 0; fieldIndex < sizeof(readFields) / sizeof(readFields[0]); fieldIndex++)
+        {
+            if (!IsFieldStored(readFields[fieldIndex]))
+            {
+                // packed in with another field
+                continue;
+            }
+            unsigned int sector = (WordIndex(particleIndex, readFields[fieldIndex]) *
+                sizeof(unsigned int)) / MEMORY_SECTOR_BYTES;
+            sectorsPerUpdatePass += (sectorRead[sector] == 0) ? 1 : 0;
+            sectorRead[sector] = 1;
+        }
+        for (size_t fieldIndex = 0; fieldIndex < sizeof(writtenFields) / sizeof(writtenFields[0]); fieldIndex++)
+        {
+            if (!IsFieldStored(writtenFields[fieldIndex]))
+            {
+                continue;
+            }
+            unsigned int sector = (WordIndex(particleIndex, writtenFields[fieldIndex]) *
+                sizeof(unsigned int)) / MEMORY_SECTOR_BYTES;
+            sectorsPerUpdatePass += (sectorWritten[sector] == 0) ? 1 : 0;
+            sectorWritten[sector] = 1;
+        }
+    }
+
+    float totalSectors = (float)((numResetPasses * sectorsPerResetPass) + sectorsPerUpdatePass);
+    return (totalSectors * MEMORY_SECTOR_BYTES) / numParticles;
+}
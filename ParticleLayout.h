@@ -0,0 +1,316 @@
+#pragma once
+
+#include "Particle.h"
+#include "glm/vec2.hpp"
+#include "glm/packing.hpp"
+#include <string>
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The ways that the particle SSBO can be arranged in memory.
+    - AOS: "array of structures".  The original layout.  An array of Particle structures.
+    - SOA: "structure of arrays".  All the X positions, then all the Y positions, etc.
+    - AOSOA_8/AOSOA_16: "array of structures of arrays".  Blocks of 8 (or 16) particles, and
+    within each block, 8 X positions, then 8 Y positions, etc.
+    - COMPACT_2D: An array of ParticleCompact2D (only X and Y position and velocity) after a 
+    bit field of "is active" flags (see Particle.h).
+    - QUANTIZED_2D: Like COMPACT_2D, but an array of ParticleQuantized2D (16-bit position 
+    within the particle region's bounding box and half-float velocity).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+enum ParticleLayout
+{
+    PARTICLE_LAYOUT_AOS = 0,
+    PARTICLE_LAYOUT_SOA,
+    PARTICLE_LAYOUT_AOSOA_8,
+    PARTICLE_LAYOUT_AOSOA_16,
+    PARTICLE_LAYOUT_COMPACT_2D,
+    PARTICLE_LAYOUT_QUANTIZED_2D,
+    PARTICLE_LAYOUT_COUNT
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Every member of a Particle, one 32-bit word at a time, in the same order as the Particle
+    structure.  Must match the PARTICLE_FIELD_* constants in particleLayout.glsl.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+enum ParticleField
+{
+    PARTICLE_FIELD_POS_X = 0,
+    PARTICLE_FIELD_POS_Y,
+    PARTICLE_FIELD_POS_Z,
+    PARTICLE_FIELD_POS_W,
+    PARTICLE_FIELD_VEL_X,
+    PARTICLE_FIELD_VEL_Y,
+    PARTICLE_FIELD_VEL_Z,
+    PARTICLE_FIELD_VEL_W,
+    PARTICLE_FIELD_IS_ACTIVE,
+    PARTICLE_FIELD_COUNT
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Describes where each particle's members live in a particle buffer for a particular layout.
+
+    Every layout is handled with the same formula by thinking of the buffer as a series of
+    blocks of "block size" particles:
+        word index = (first particle word) + (block index * words per block) + 
+            (field slot * block size) + index in block
+    - AoS: block size 1, and each block is a whole Particle (including its padding)
+    - SoA: a single block the size of the whole particle collection
+    - AoSoA: blocks of 8 or 16 (the last block is padded out)
+    - Compact 2D: block size 1, and each block is a ParticleCompact2D.  The particles start 
+    after the "is active" bit field.
+    - Quantized 2D: block size 1, and each block is a ParticleQuantized2D.  Also after an "is 
+    active" bit field.  X and Y share a word, so the packed position is the POS_X field and the 
+    packed velocity is the VEL_X field.  Use the Encode/Decode functions on them.
+
+    A field's "slot" is its position within a block.  It is the same as the field except for 
+    the compact layout, which doesn't store Z, W, or the "is active" flag as a word.  Check 
+    IsFieldStored(...) before using WordIndex(...) on those, and always use ReadIsActive(...) 
+    and WriteIsActive(...) for the "is active" flag.
+
+    The same formula is used on the GPU (particleLayout.glsl, with the numbers provided by
+    ShaderDefines()) and on the CPU (CpuParticleReset, CpuParticleUpdate), so the shaders and
+    the CPU kernels always agree on the layout.
+
+    Note: Storage pointers are void * because a particle buffer is a mix of floats and ints.
+    Each word is only ever accessed as the type of the field that lives there.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleLayoutInfo
+{
+public:
+    ParticleLayoutInfo(ParticleLayout layout, unsigned int numParticles, 
+        const glm::vec2 &quantizeMin = glm::vec2(-1.0f), 
+        const glm::vec2 &quantizeMax = glm::vec2(+1.0f));
+
+    ParticleLayout Layout() const;
+    const char *Name() const;
+    unsigned int NumParticles() const;
+    unsigned int BlockSize() const;
+    unsigned int BufferSizeBytes() const;
+    unsigned int ParticlesPerCacheSizedChunk() const;
+    std::string ShaderDefines() const;
+    bool IsQuantized() const;
+    glm::vec2 PositionQuantizationStep() const;
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Where a particle's field lives in the buffer (in 32-bit words).  Inline because the CPU
+        kernels call this for every particle.
+    Parameters:
+        particleIndex   Self-explanatory.
+        field           Self-explanatory.
+    Returns:
+        A word offset from the start of the buffer.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    unsigned int WordIndex(unsigned int particleIndex, ParticleField field) const
+    {
+        return _firstParticleWord + ((particleIndex / _blockSize) * _wordsPerBlock) + 
+            (_fieldSlot[field] * _blockSize) + (particleIndex % _blockSize);
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Getter.  Only the compact layout leaves out some fields.
+    Parameters:
+        field   Self-explanatory.
+    Returns:
+        True if the field has its own word in the buffer, otherwise false.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    bool IsFieldStored(ParticleField field) const
+    {
+        return _fieldSlot[field] >= 0;
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Getter.  True if the "is active" flags are packed into a bit field (compact layout).
+        32 particles then share a word, so threads must not split a group of 32 particles 
+        between them (see ParticlesPerCacheSizedChunk()).
+    Parameters: None
+    Returns:
+        See description.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    bool HasActiveBits() const
+    {
+        return _hasActiveBits;
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Where a particle's "is active" flag lives (in 32-bit words).  With a bit field, this is 
+        the word that contains the particle's bit.
+    Parameters:
+        particleIndex   Self-explanatory.
+    Returns:
+        A word offset from the start of the buffer.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    unsigned int ActiveWordIndex(unsigned int particleIndex) const
+    {
+        return _hasActiveBits ? 
+            (particleIndex / 32) : WordIndex(particleIndex, PARTICLE_FIELD_IS_ACTIVE);
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Reads a particle's "is active" flag, whether it is a word or a bit.
+    Parameters:
+        pStorage        The start of the particle buffer.
+        particleIndex   Self-explanatory.
+    Returns:
+        1 if active, otherwise 0.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    int ReadIsActive(const void *pStorage, unsigned int particleIndex) const
+    {
+        if (_hasActiveBits)
+        {
+            const unsigned int *pBits = static_cast<const unsigned int *>(pStorage);
+            return (int)((pBits[particleIndex / 32] >> (particleIndex % 32)) & 1);
+        }
+
+        return static_cast<const int *>(pStorage)[ActiveWordIndex(particleIndex)];
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Writes a particle's "is active" flag, whether it is a word or a bit.
+
+        Note: Not atomic.  With a bit field, the caller must be the only one working on this 
+        particle's group of 32.
+    Parameters:
+        pStorage        The start of the particle buffer.
+        particleIndex   Self-explanatory.
+        isActive        1 or 0.
+    Returns:    None
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    void WriteIsActive(void *pStorage, unsigned int particleIndex, int isActive) const
+    {
+        if (_hasActiveBits)
+        {
+            unsigned int *pBits = static_cast<unsigned int *>(pStorage);
+            unsigned int bit = 1u << (particleIndex % 32);
+            if (isActive != 0)
+            {
+                pBits[particleIndex / 32] |= bit;
+            }
+            else
+            {
+                pBits[particleIndex / 32] &= ~bit;
+            }
+            return;
+        }
+
+        static_cast<int *>(pStorage)[ActiveWordIndex(particleIndex)] = isActive;
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        The distance (in words) between the same field of two neighboring particles in the same
+        block.  The SIMD kernels use this to decide between gathering (AoS) and loading a run
+        of consecutive values (SoA and AoSoA).
+    Parameters: None
+    Returns:
+        See description.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    unsigned int FieldStride() const
+    {
+        return (_blockSize == 1) ? _wordsPerBlock : 1;
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Packs an X and Y position into a single word of 16-bit unsigned normalized integers 
+        across the quantization bounds.  Positions outside the bounds are clamped to them.  
+        Must match EncodePosition(...) in particleLayout.glsl.
+    Parameters:
+        pos     Self-explanatory.
+    Returns:
+        The packed position.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    unsigned int EncodePosition(const glm::vec2 &pos) const
+    {
+        return glm::packUnorm2x16((pos - _quantizeMin) / _quantizeExtent);
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        The opposite of EncodePosition(...).  Must match DecodePosition(...) in 
+        particleLayout.glsl.
+    Parameters:
+        packedPos   Self-explanatory.
+    Returns:
+        The X and Y position, on the nearest quantization step.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    glm::vec2 DecodePosition(unsigned int packedPos) const
+    {
+        return _quantizeMin + (glm::unpackUnorm2x16(packedPos) * _quantizeExtent);
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        Packs an X and Y velocity into a single word of half floats.  Velocities don't have 
+        bounds, so they keep a float's range at 11 bits of precision.
+    Parameters:
+        vel     Self-explanatory.
+    Returns:
+        The packed velocity.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    static unsigned int EncodeVelocity(const glm::vec2 &vel)
+    {
+        return glm::packHalf2x16(vel);
+    }
+
+    /*-------------------------------------------------------------------------------------------
+    Description:
+        The opposite of EncodeVelocity(...).
+    Parameters:
+        packedVel   Self-explanatory.
+    Returns:
+        The X and Y velocity.
+    Creator:    agent (10-16-2026)
+    -------------------------------------------------------------------------------------------*/
+    static glm::vec2 DecodeVelocity(unsigned int packedVel)
+    {
+        return glm::unpackHalf2x16(packedVel);
+    }
+
+    Particle Read(const void *pStorage, unsigned int particleIndex) const;
+    void Write(void *pStorage, unsigned int particleIndex, const Particle &p) const;
+    void Pack(const std::vector<Particle> &allParticles, std::vector<unsigned int> *pWords) const;
+    void Unpack(const void *pStorage, std::vector<Particle> *pAllParticles) const;
+
+    float EstimateFrameBytesPerParticle(const std::vector<Particle> &allParticles,
+        unsigned int numResetPasses) const;
+
+private:
+    ParticleLayout _layout;
+    unsigned int _numParticles;
+    unsigned int _blockSize;
+    unsigned int _wordsPerBlock;
+    unsigned int _numBlocks;
+
+    // where each field goes within a block (-1 if not stored)
+    int _fieldSlot[PARTICLE_FIELD_COUNT];
+
+    // the compact layout puts the "is active" bit field in front of the particles
+    bool _hasActiveBits;
+    unsigned int _firstParticleWord;
+
+    // the quantized layout's positions are relative to this box
+    glm::vec2 _quantizeMin;
+    glm::vec2 _quantizeExtent;
+};
@@ -1,29 +1,182 @@
 #include "ParticlePolygonRegion.h"
 
+#include "ThreadPool.h"
+#include "glm/common.hpp"   // for glm::min(...) and glm::max(...)
+#include "glm/geometric.hpp"
+
+#include <math.h>
+
+// SSE2 is always there on x64 and is turned on by default for 32bit builds in Visual Studio 
+// 2012 and up
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REGION_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+
+// the batch transform writes whole faces as 16 floats in a row
+static_assert(sizeof(PolygonFace) == 16 * sizeof(float), "PolygonFace must be 4 tightly packed vec4s");
+
+// how far (relative to the size of the region) one face's end can be from the next face's 
+// start and still count as joined
+static const float LOOP_JOIN_EPSILON_SCALE = 1.0e-5f;
+
+// how far (in radians) the faces can turn back to the right before the region counts as 
+// concave
+// Note: In a region with lots of tiny faces (ex: a circle with 65536 of them), rounding makes 
+// the corners wobble more than they turn, so single corners can't be judged on their own.  
+// Wobbles undo themselves a corner or two later, but a real dent keeps turning right across 
+// all of its faces.
+static const float CONCAVE_TURN_EPSILON = 0.01f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if the faces make a region that the per-face "out of bounds" check works for: a 
+    single closed loop, in order, that turns left (counterclockwise) and goes around exactly 
+    once without ever turning back to the right (give or take rounding), with every normal 
+    pointing out (to the right of its face).
+Parameters:
+    faces   Self-explanatory.
+Returns:
+    True if the region is a convex loop, otherwise false.
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool FacesFormConvexLoop(const std::vector<PolygonFace> &faces)
+{
+    if (faces.size() < 3)
+    {
+        return false;
+    }
+
+    glm::vec2 boxMin(faces[0]._start._position);
+    glm::vec2 boxMax(boxMin);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        boxMin = glm::min(boxMin, glm::vec2(faces[faceIndex]._start._position));
+        boxMax = glm::max(boxMax, glm::vec2(faces[faceIndex]._start._position));
+    }
+    float joinEpsilon = LOOP_JOIN_EPSILON_SCALE * glm::length(boxMax - boxMin);
+
+    // go around twice so that a dent that straddles the first face is seen in one piece, but 
+    // only add up the first time around
+    float totalTurn = 0.0f;
+    float runningTurn = 0.0f;
+    float mostRunningTurn = 0.0f;
+    size_t numFaces = faces.size();
+    for (size_t cornerIndex = 0; cornerIndex < 2 * numFaces; cornerIndex++)
+    {
+        const PolygonFace &f = faces[cornerIndex % numFaces];
+        const PolygonFace &next = faces[(cornerIndex + 1) % numFaces];
+        glm::vec2 edge = glm::vec2(f._end._position) - glm::vec2(f._start._position);
+        glm::vec2 nextEdge = glm::vec2(next._end._position) - glm::vec2(next._start._position);
+        if (glm::length(glm::vec2(next._start._position) - glm::vec2(f._end._position)) > joinEpsilon)
+        {
+            // not one loop (or not in order)
+            return false;
+        }
+
+        // the per-face check treats the normal's side as "out"
+        glm::vec2 outside(edge.y, -edge.x);
+        if (glm::dot(outside, glm::vec2(f._start._normal)) <= 0.0f)
+        {
+            // also catches faces with no length
+            return false;
+        }
+
+        float turn = atan2f((edge.x * nextEdge.y) - (edge.y * nextEdge.x), glm::dot(edge, nextEdge));
+        if (cornerIndex < numFaces)
+        {
+            totalTurn += turn;
+        }
+        runningTurn += turn;
+        mostRunningTurn = glm::max(mostRunningTurn, runningTurn);
+        if (mostRunningTurn - runningTurn > CONCAVE_TURN_EPSILON)
+        {
+            return false;
+        }
+    }
+
+    // a loop that only turns left but goes around more than once crosses itself
+    const float TWO_PI = 6.28318530718f;
+    return fabsf(totalTurn - TWO_PI) < CONCAVE_TURN_EPSILON;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The range of faces that changed during one ThreadPool thread's share of a batch transform.  
+    Padded to a cache line for the same reason as PerThreadCounter.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct PerThreadChangedFaces
+{
+    PerThreadChangedFaces() :
+        _first(0xFFFFFFFF),
+        _end(0)
+    {
+    }
+
+    unsigned int _first;
+    unsigned int _end;
+    char _padding[64 - (2 * sizeof(unsigned int))];
+};
+
 
 /*-----------------------------------------------------------------------------------------------
 Description:
     Ensures that the object starts object with initialized values.  
 Parameters:
-    faces   A collection of PolygonFace structures.  This object will keep a copy of the 
-            originals and any transformed version.
+    faces       A collection of PolygonFace structures.  This object will keep a copy of the 
+                originals and any transformed version.
+    pThreadPool Optional.  If provided, big transforms are split across the pool's threads.
 Returns:    None
 Exception:  Safe
 Creator:    John Cox (10-10-2016)
 -----------------------------------------------------------------------------------------------*/
-ParticleRegionPolygon::ParticleRegionPolygon(const std::vector<PolygonFace> faces)
+ParticleRegionPolygon::ParticleRegionPolygon(const std::vector<PolygonFace> faces, 
+    ThreadPool *pThreadPool) :
+    _isConvex(FacesFormConvexLoop(faces)),
+    _firstChangedFace(0),
+    _endChangedFace((unsigned int)faces.size()),
+    _pThreadPool(pThreadPool)
 {
     _originalFaces = faces;
 
     // the transformed variants begin equal to the original points, then diverge after 
     // SetTransform(...) is called
+    // Note: They have never been uploaded anywhere, so they all start out "changed".
     _transformedFaces = faces;
+
+    _originalX.resize(faces.size() * 4);
+    _originalY.resize(faces.size() * 4);
+    _originalZ.resize(faces.size() * 4);
+    _originalW.resize(faces.size() * 4);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        const glm::vec4 *faceVectors[4] =
+        {
+            &faces[faceIndex]._start._position, &faces[faceIndex]._start._normal,
+            &faces[faceIndex]._end._position, &faces[faceIndex]._end._normal
+        };
+        for (size_t vectorIndex = 0; vectorIndex < 4; vectorIndex++)
+        {
+            size_t soaIndex = (faceIndex * 4) + vectorIndex;
+            _originalX[soaIndex] = faceVectors[vectorIndex]->x;
+            _originalY[soaIndex] = faceVectors[vectorIndex]->y;
+            _originalZ[soaIndex] = faceVectors[vectorIndex]->z;
+            _originalW[soaIndex] = faceVectors[vectorIndex]->w;
+        }
+    }
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
     Why transform this for every emission of every particle when I can do it once before
     particle updating and be done with it for the rest of the frame?
+
+    And why do it even once per frame if the transform didn't change?  If it is the same as the 
+    last one, this does nothing.  Otherwise the faces are transformed in a batch (split across 
+    the thread pool if there is one and there are enough faces to be worth it), and the range 
+    of faces that moved is added to the changed faces (see GetChangedFaces(...)).
 Parameters:
     regionTransform     Transform the faces' points and normals with this.
 Returns:    None
@@ -32,15 +185,39 @@ Creator:    John Cox (10-10-2016)
 -----------------------------------------------------------------------------------------------*/
 void ParticleRegionPolygon::SetTransform(const glm::mat4 &regionTransform)
 {
-    for (size_t faceIndex = 0; faceIndex < _originalFaces.size(); faceIndex++)
+    if (regionTransform == _currentTransform)
     {
-        PolygonFace faceCopy = _originalFaces[faceIndex];
-        faceCopy._start._position = regionTransform * faceCopy._start._position;
-        faceCopy._start._normal = regionTransform * faceCopy._start._normal;
-        faceCopy._end._position = regionTransform * faceCopy._end._position;
-        faceCopy._end._normal = regionTransform * faceCopy._end._normal;
+        return;
+    }
+    _currentTransform = regionTransform;
 
-        _transformedFaces[faceIndex] = faceCopy;
+    unsigned int numFaces = (unsigned int)_originalFaces.size();
+
+    // read one face from each of the 4 arrays and write one face
+    unsigned int facesPerChunk = ThreadPool::ItemsPerCacheSizedChunk(2 * sizeof(PolygonFace));
+    if (_pThreadPool == 0 || numFaces <= facesPerChunk)
+    {
+        unsigned int firstChangedFace = 0xFFFFFFFF;
+        unsigned int endChangedFace = 0;
+        TransformFaceRange(regionTransform, 0, numFaces, &firstChangedFace, &endChangedFace);
+        AddChangedFaces(firstChangedFace, endChangedFace);
+        return;
+    }
+
+    // each thread only ever touches its own range, so no locks are necessary
+    std::vector<PerThreadChangedFaces> changedFacesPerThread(_pThreadPool->NumThreads());
+    _pThreadPool->ParallelFor(numFaces, facesPerChunk, 
+        [this, &regionTransform, &changedFacesPerThread](unsigned int begin, unsigned int end,
+        unsigned int threadIndex)
+    {
+        PerThreadChangedFaces &changedFaces = changedFacesPerThread[threadIndex];
+        TransformFaceRange(regionTransform, begin, end, &changedFaces._first, &changedFaces._end);
+    });
+
+    for (size_t threadIndex = 0; threadIndex < changedFacesPerThread.size(); threadIndex++)
+    {
+        AddChangedFaces(changedFacesPerThread[threadIndex]._first, 
+            changedFacesPerThread[threadIndex]._end);
     }
 }
 
@@ -65,4 +242,242 @@ Creator:    John Cox (10-10-2016)
 const std::vector<PolygonFace> &ParticleRegionPolygon::GetFaces() const
 {
     return _transformedFaces;
-}
\ No newline at end of file
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the faces as they were given to the constructor.  When the shaders do 
+    the transforms (see ComputeParticleUpdate::SetRegionTransform(...)), these are uploaded 
+    once instead of uploading the transformed faces every frame.
+Parameters: None
+Returns:    
+    A const reference to the internal collection of untransformed polygon faces.
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const std::vector<PolygonFace> &ParticleRegionPolygon::GetOriginalFaces() const
+{
+    return _originalFaces;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates the smallest axis-aligned box that contains the transformed polygon.  Particles 
+    are deactivated as soon as they leave the polygon, so every active particle is inside this 
+    box (used for the quantized particle layout; see ParticleLayoutInfo).
+Parameters:
+    pMin    The lower left corner of the box is put here.
+    pMax    The upper right corner of the box is put here.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygon::GetBoundingBox(glm::vec2 *pMin, glm::vec2 *pMax) const
+{
+    if (_transformedFaces.empty())
+    {
+        *pMin = glm::vec2();
+        *pMax = glm::vec2();
+        return;
+    }
+
+    // a face's end is the next face's start, but checking both is simpler than assuming it
+    glm::vec2 boxMin(_transformedFaces[0]._start._position);
+    glm::vec2 boxMax(boxMin);
+    for (size_t faceIndex = 0; faceIndex < _transformedFaces.size(); faceIndex++)
+    {
+        glm::vec2 start(_transformedFaces[faceIndex]._start._position);
+        glm::vec2 end(_transformedFaces[faceIndex]._end._position);
+        boxMin = glm::min(boxMin, glm::min(start, end));
+        boxMax = glm::max(boxMax, glm::max(start, end));
+    }
+
+    *pMin = boxMin;
+    *pMax = boxMax;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells the caller whether the region is a single convex loop of faces, which is what the 
+    per-face "out of bounds" check needs.  Otherwise (concave, holes, more than one loop), use 
+    the winding test (see PolygonWindingTable).
+
+    Decided once from the original faces.  Transforms that rotate, scale, and move the region 
+    don't change it, but a mirroring transform would turn the loop inside out.
+Parameters: None
+Returns:
+    True if the per-face check works for this region, otherwise false.
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygon::IsConvex() const
+{
+    return _isConvex;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells the caller which faces have changed since the last ClearChangedFaces() (or since 
+    this object was made).  They are given as one range that covers all of them.
+Parameters:
+    pFirstFace  The first changed face is put here.
+    pNumFaces   How many faces the range covers is put here.
+Returns:
+    True if any faces changed, otherwise false (and the outputs are left alone).
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleRegionPolygon::GetChangedFaces(unsigned int *pFirstFace, unsigned int *pNumFaces) const
+{
+    if (_firstChangedFace >= _endChangedFace)
+    {
+        return false;
+    }
+
+    *pFirstFace = _firstChangedFace;
+    *pNumFaces = _endChangedFace - _firstChangedFace;
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Call this once the changed faces have been dealt with (ex: uploaded).
+Parameters: None
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygon::ClearChangedFaces()
+{
+    _firstChangedFace = 0;
+    _endChangedFace = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Grows the range of changed faces to cover the given range.
+Parameters:
+    firstFace   The first face that changed.
+    endFace     One past the last face that changed.  Nothing changed if it is <= firstFace.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygon::AddChangedFaces(unsigned int firstFace, unsigned int endFace)
+{
+    if (firstFace >= endFace)
+    {
+        return;
+    }
+
+    if (_firstChangedFace >= _endChangedFace)
+    {
+        _firstChangedFace = firstFace;
+        _endChangedFace = endFace;
+    }
+    else
+    {
+        _firstChangedFace = glm::min(_firstChangedFace, firstFace);
+        _endChangedFace = glm::max(_endChangedFace, endFace);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Transforms the original faces in the given range into the transformed faces.  A face is 
+    only written if it moved, and the range of the ones that did is added to the given range.
+
+    With SSE, the 4 arrays give the X's, Y's, Z's, and W's of one face's 4 vectors, so the 
+    transform is 16 multiply-adds across 4 registers with no shuffling.  A 4x4 transpose then 
+    turns the registers into the face's 4 vectors in PolygonFace order.
+Parameters:
+    regionTransform     Self-explanatory.
+    beginFace           The first face to transform.
+    endFace             One past the last face to transform.
+    pFirstChangedFace   Lowered to the first face that changed, if any did.
+    pEndChangedFace     Raised to one past the last face that changed, if any did.
+Returns:    None
+Exception:  Safe
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleRegionPolygon::TransformFaceRange(const glm::mat4 &regionTransform, 
+    unsigned int beginFace, unsigned int endFace, unsigned int *pFirstChangedFace, 
+    unsigned int *pEndChangedFace)
+{
+    unsigned int firstChangedFace = *pFirstChangedFace;
+    unsigned int endChangedFace = *pEndChangedFace;
+
+#ifdef REGION_TRANSFORM_SSE
+    // glm matrices are column major, so regionTransform[column][row]
+    __m128 m[4][4];
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            m[column][row] = _mm_set1_ps(regionTransform[column][row]);
+        }
+    }
+
+    for (unsigned int faceIndex = beginFace; faceIndex < endFace; faceIndex++)
+    {
+        unsigned int soaIndex = faceIndex * 4;
+        __m128 x = _mm_loadu_ps(&_originalX[soaIndex]);
+        __m128 y = _mm_loadu_ps(&_originalY[soaIndex]);
+        __m128 z = _mm_loadu_ps(&_originalZ[soaIndex]);
+        __m128 w = _mm_loadu_ps(&_originalW[soaIndex]);
+
+        __m128 rows[4];
+        for (int row = 0; row < 4; row++)
+        {
+            rows[row] = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m[0][row], x), _mm_mul_ps(m[1][row], y)),
+                _mm_add_ps(_mm_mul_ps(m[2][row], z), _mm_mul_ps(m[3][row], w)));
+        }
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+
+        // compare with what is there before writing so that unchanged faces aren't reported
+        float *pFace = &_transformedFaces[faceIndex]._start._position.x;
+        __m128 different = _mm_setzero_ps();
+        for (int vectorIndex = 0; vectorIndex < 4; vectorIndex++)
+        {
+            different = _mm_or_ps(different, 
+                _mm_cmpneq_ps(rows[vectorIndex], _mm_loadu_ps(pFace + (vectorIndex * 4))));
+        }
+        if (_mm_movemask_ps(different) != 0)
+        {
+            for (int vectorIndex = 0; vectorIndex < 4; vectorIndex++)
+            {
+                _mm_storeu_ps(pFace + (vectorIndex * 4), rows[vectorIndex]);
+            }
+            firstChangedFace = glm::min(firstChangedFace, faceIndex);
+            endChangedFace = glm::max(endChangedFace, faceIndex + 1);
+        }
+    }
+#else
+    for (unsigned int faceIndex = beginFace; faceIndex < endFace; faceIndex++)
+    {
+        glm::vec4 faceVectors[4];
+        for (unsigned int vectorIndex = 0; vectorIndex < 4; vectorIndex++)
+        {
+            unsigned int soaIndex = (faceIndex * 4) + vectorIndex;
+            faceVectors[vectorIndex] = regionTransform * glm::vec4(_originalX[soaIndex], 
+                _originalY[soaIndex], _originalZ[soaIndex], _originalW[soaIndex]);
+        }
+
+        PolygonFace &face = _transformedFaces[faceIndex];
+        if (face._start._position != faceVectors[0] || face._start._normal != faceVectors[1] ||
+            face._end._position != faceVectors[2] || face._end._normal != faceVectors[3])
+        {
+            face._start._position = faceVectors[0];
+            face._start._normal = faceVectors[1];
+            face._end._position = faceVectors[2];
+            face._end._normal = faceVectors[3];
+            firstChangedFace = glm::min(firstChangedFace, faceIndex);
+            endChangedFace = glm::max(endChangedFace, faceIndex + 1);
+        }
+    }
+#endif
+
+    *pFirstChangedFace = firstChangedFace;
+    *pEndChangedFace = endChangedFace;
+}
@@ -5,6 +5,7 @@
 #include "PolygonFace.h"
 #include <vector>
 
+class ThreadPool;
 
 /*-----------------------------------------------------------------------------------------------
 Description:
@@ -12,20 +13,62 @@ Description:
     a stripped down variation of the one in "render particles 2D advanced CPU" because it only 
     needs to keep track of the polygon boundaries and however they are transformed and does NOT
     need to have "out of bounds" checks.
+
+    Transforms are change tracked.  Setting the same transform again does nothing, and after a 
+    new transform, only the faces that actually moved are reported by GetChangedFaces(...) so 
+    that only those need to be uploaded (see PolygonSsbo::UpdateValues(...)).
+
+    The faces can make any number of closed loops (normals point out of the region, so outer 
+    loops go counterclockwise and holes go clockwise).  Only a single convex loop works with 
+    the per-face "out of bounds" check, so IsConvex() says whether the region qualifies; 
+    anything else needs the winding test (see PolygonWindingTable).
 Creator:    John Cox (10-10-2016)
 -----------------------------------------------------------------------------------------------*/
 class ParticleRegionPolygon
 {
 public:
-    ParticleRegionPolygon(const std::vector<PolygonFace> faces);
+    ParticleRegionPolygon(const std::vector<PolygonFace> faces, ThreadPool *pThreadPool = 0);
     virtual void SetTransform(const glm::mat4 &regionTransform);
 
     const std::vector<PolygonFace> &GetFaces() const;
+    const std::vector<PolygonFace> &GetOriginalFaces() const;
+    void GetBoundingBox(glm::vec2 *pMin, glm::vec2 *pMax) const;
+    bool IsConvex() const;
+
+    bool GetChangedFaces(unsigned int *pFirstFace, unsigned int *pNumFaces) const;
+    void ClearChangedFaces();
+
 private:
+    void AddChangedFaces(unsigned int firstFace, unsigned int endFace);
+    void TransformFaceRange(const glm::mat4 &regionTransform, unsigned int beginFace,
+        unsigned int endFace, unsigned int *pFirstChangedFace, unsigned int *pEndChangedFace);
+
     // this stuff is only kept around as a reference for when transforms need to update it, 
     // which is merely once per frame, so unlike "render particles 2D advanced CPU", cache 
     // coherency isn't much of a concern here
     std::vector<PolygonFace> _originalFaces;
     std::vector<PolygonFace> _transformedFaces;
-};
 
+    // ...except when there are hundreds of thousands of faces, so the originals are also kept 
+    // as a structure of arrays for the batch transform
+    // Note: Each face is 4 vectors (start position, start normal, end position, end normal; 
+    // the same order as in PolygonFace), so vector N's X is _originalX[N], and face F's 
+    // vectors are 4F to 4F + 3.
+    std::vector<float> _originalX;
+    std::vector<float> _originalY;
+    std::vector<float> _originalZ;
+    std::vector<float> _originalW;
+
+    // decided once from the original faces; the transforms don't change it
+    bool _isConvex;
+
+    // the transform that _transformedFaces are in
+    glm::mat4 _currentTransform;
+
+    // the faces that changed since the last ClearChangedFaces() are in [first, end)
+    unsigned int _firstChangedFace;
+    unsigned int _endChangedFace;
+
+    // 0 if the transform should stay on the calling thread
+    ThreadPool *_pThreadPool;
+};
@@ -0,0 +1,145 @@
+#include "ParticleQuantizationCheck.h"
+
+#include <stdio.h>
+
+#include "ParticleLayout.h"
+#include "CpuParticleReset.h"
+#include "CpuParticleUpdate.h"
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+const float ParticleQuantizationCheck::DELTA_TIME_SEC = 0.01f;
+
+// half a pixel in a 500 pixel wide window that spans 2 units of window space
+const float ParticleQuantizationCheck::POSITION_ERROR_BUDGET = 0.5f * (2.0f / 500.0f);
+const float ParticleQuantizationCheck::VELOCITY_RELATIVE_ERROR_BUDGET = 1.0f / 2048.0f;
+const float ParticleQuantizationCheck::IS_ACTIVE_MISMATCH_BUDGET = 0.001f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Keeps what Run() needs.
+Parameters:
+    numParticles    How many particles each copy has.
+    faces           The particle region's faces, already transformed to where the emitters
+                    are.
+    regionMin       The particle region's bounding box, which the quantized layout packs
+    regionMax       positions into.
+    pThreadPool     Spreads the CPU reset and update across all cores.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleQuantizationCheck::ParticleQuantizationCheck(unsigned int numParticles,
+    const std::vector<PolygonFace> &faces, const glm::vec2 &regionMin,
+    const glm::vec2 &regionMax, ThreadPool *pThreadPool) :
+    _numParticles(numParticles),
+    _faces(faces),
+    _regionMin(regionMin),
+    _regionMax(regionMax),
+    _pThreadPool(pThreadPool)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The region is filled by this emitter.  It must already be transformed to where the faces
+    are.
+Parameters:
+    pEmitter    A pointer to a "particle emitter" interface.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ParticleQuantizationCheck::AddEmitter(const IParticleEmitter *pEmitter)
+{
+    _emitters.push_back(pEmitter);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does all of the steps in the class description and prints the results on one line.
+Parameters: None
+Returns:
+    True if the quantized layout stayed within every budget, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleQuantizationCheck::Run() const
+{
+    // fill the region with particles on the float path
+    ParticleLayoutInfo floatLayout(PARTICLE_LAYOUT_AOS, _numParticles);
+    std::vector<unsigned int> floatStorage;
+    floatLayout.Pack(std::vector<Particle>(_numParticles), &floatStorage);
+    CpuParticleReset floatReseter(floatLayout, _pThreadPool);
+    for (size_t emitterIndex = 0; emitterIndex < _emitters.size(); emitterIndex++)
+    {
+        floatReseter.AddEmitter(_emitters[emitterIndex]);
+    }
+    floatReseter.SetParticleStorage(floatStorage.data());
+    CpuParticleUpdate floatUpdater(floatLayout, _faces, _pThreadPool);
+    floatUpdater.SetParticleStorage(floatStorage.data());
+    for (unsigned int frame = 0; frame < NUM_WARMUP_FRAMES; frame++)
+    {
+        floatReseter.ResetParticles(PARTICLES_PER_EMITTER_PER_FRAME);
+        floatUpdater.Update(DELTA_TIME_SEC);
+    }
+
+    // same particles on the quantized path
+    ParticleLayoutInfo quantizedLayout(PARTICLE_LAYOUT_QUANTIZED_2D, _numParticles,
+        _regionMin, _regionMax);
+    std::vector<Particle> startingParticles;
+    floatLayout.Unpack(floatStorage.data(), &startingParticles);
+    std::vector<unsigned int> quantizedStorage;
+    quantizedLayout.Pack(startingParticles, &quantizedStorage);
+    CpuParticleUpdate quantizedUpdater(quantizedLayout, _faces, _pThreadPool);
+    quantizedUpdater.SetParticleStorage(quantizedStorage.data());
+
+    for (unsigned int frame = 0; frame < NUM_COMPARED_FRAMES; frame++)
+    {
+        floatUpdater.Update(DELTA_TIME_SEC);
+        quantizedUpdater.Update(DELTA_TIME_SEC);
+    }
+
+    std::vector<Particle> floatParticles;
+    std::vector<Particle> quantizedParticles;
+    floatLayout.Unpack(floatStorage.data(), &floatParticles);
+    quantizedLayout.Unpack(quantizedStorage.data(), &quantizedParticles);
+    float maxPositionError = 0.0f;
+    float maxVelocityRelativeError = 0.0f;
+    unsigned int numActive = 0;
+    unsigned int numIsActiveMismatches = 0;
+    for (unsigned int particleIndex = 0; particleIndex < _numParticles; particleIndex++)
+    {
+        const Particle &f = floatParticles[particleIndex];
+        const Particle &q = quantizedParticles[particleIndex];
+        if (f._isActive != q._isActive)
+        {
+            numIsActiveMismatches++;
+            continue;
+        }
+        if (f._isActive == 0)
+        {
+            // out of bounds particles are clamped to the bounding box, so don't compare them
+            continue;
+        }
+        numActive++;
+
+        glm::vec2 positionError = glm::abs(glm::vec2(f._position - q._position));
+        maxPositionError = glm::max(maxPositionError, glm::max(positionError.x, positionError.y));
+        float speed = glm::length(glm::vec2(f._velocity));
+        if (speed > 0.0f)
+        {
+            float velocityError = glm::length(glm::vec2(f._velocity - q._velocity));
+            maxVelocityRelativeError = glm::max(maxVelocityRelativeError, velocityError / speed);
+        }
+    }
+
+    float isActiveMismatchFraction = (float)numIsActiveMismatches / _numParticles;
+    bool withinBudget =
+        (maxPositionError <= POSITION_ERROR_BUDGET) &&
+        (maxVelocityRelativeError <= VELOCITY_RELATIVE_ERROR_BUDGET) &&
+        (isActiveMismatchFraction <= IS_ACTIVE_MISMATCH_BUDGET);
+    printf("quantization error after %u frames (%u active particles): position %g (budget %g), "
+        "velocity %g (budget %g), \"is active\" mismatches %u (budget %g): %s\n",
+        NUM_COMPARED_FRAMES, numActive, maxPositionError, POSITION_ERROR_BUDGET,
+        maxVelocityRelativeError, VELOCITY_RELATIVE_ERROR_BUDGET, numIsActiveMismatches,
+        IS_ACTIVE_MISMATCH_BUDGET * _numParticles, withinBudget ? "PASSED" : "FAILED");
+    return withinBudget;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "IParticleEmitter.h"
+#include "PolygonFace.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+class ThreadPool;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The error budget for PARTICLE_LAYOUT_QUANTIZED_2D.  Run() fills the particle region with
+    the CPU particle reset and update using the float (AoS) layout, copies those particles into
+    the quantized layout, then updates both copies side by side for one second of simulation
+    time and compares them:
+    - position: must stay within half a pixel at the default window size
+    - velocity: must stay within a half float's rounding (1 part in 2048)
+    - "is active": no more than 1 particle in 1000 may disagree (particles that are right on
+    a face can go either way)
+
+    The particles are not reset during the comparison so that every particle's error builds up
+    for the whole second.  The results are printed on one line.
+
+    Note: This uses the CPU kernels, which use the same packing functions (glm's versions of
+    the GLSL functions) as the shaders.  Everything happens in the check's own particle copies,
+    so the demo's particles are left alone.
+
+    Note: When this class goes "poof", it won't delete the emitter pointers.  This is ensured by
+    only using const pointers.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleQuantizationCheck
+{
+public:
+    ParticleQuantizationCheck(unsigned int numParticles, const std::vector<PolygonFace> &faces,
+        const glm::vec2 &regionMin, const glm::vec2 &regionMax, ThreadPool *pThreadPool = 0);
+
+    void AddEmitter(const IParticleEmitter *pEmitter);
+    bool Run() const;
+
+private:
+    // same as the demo's fixed time step and emission rate
+    static const float DELTA_TIME_SEC;
+    static const unsigned int PARTICLES_PER_EMITTER_PER_FRAME = 20;
+
+    // long enough for the emitters to fill the region
+    static const unsigned int NUM_WARMUP_FRAMES = 200;
+
+    // one second of simulation time
+    static const unsigned int NUM_COMPARED_FRAMES = 100;
+
+    // see the class description
+    static const float POSITION_ERROR_BUDGET;
+    static const float VELOCITY_RELATIVE_ERROR_BUDGET;
+    static const float IS_ACTIVE_MISMATCH_BUDGET;
+
+    unsigned int _numParticles;
+    std::vector<PolygonFace> _faces;
+
+    // the quantized layout's positions are relative to this box
+    glm::vec2 _regionMin;
+    glm::vec2 _regionMax;
+    ThreadPool *_pThreadPool;
+    std::vector<const IParticleEmitter *> _emitters;
+};
@@ -0,0 +1,89 @@
+#include "ParticleRandom.h"
+
+// the GLSL version is all "uint" math, which wraps around at 32 bits
+static_assert(sizeof(unsigned int) == 4, "ParticleRandom needs a 32bit unsigned int to match the shaders");
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Starts a particle's stream of random numbers.  Same as NewParticleRandom(...) in
+    particleRandom.glsl.
+Parameters:
+    frameNumber     Which frame this is.
+    emitterIndex    Which emitter is resetting the particle.  Point emitters come first, then
+                    bar emitters (same as the emitter SSBO).
+    particleIndex   The particle's index in the particle buffer.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleRandom::ParticleRandom(unsigned int frameNumber, unsigned int emitterIndex,
+    unsigned int particleIndex) :
+    _key(PcgHash(frameNumber ^ PcgHash(emitterIndex ^ PcgHash(particleIndex)))),
+    _counter(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as NextRandomUint(...) in particleRandom.glsl.
+Parameters: None
+Returns:
+    A random unsigned int.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleRandom::NextUint()
+{
+    unsigned int value = PcgHash(_key + (_counter * 2654435769u));
+    _counter++;
+    return value;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as RandomOnRange0To1(...) in particleRandom.glsl.  The top 24 bits fit in a float
+    exactly, and multiplying by a power of 2 is exact, so this can't round differently than the
+    GPU.
+Parameters: None
+Returns:
+    A random float on the range [0,+1).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float ParticleRandom::NextOnRange0To1()
+{
+    return (float)(NextUint() >> 8) * (1.0f / 16777216.0f);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as RandomOnRangeNeg1ToPos1(...) in particleRandom.glsl.
+Parameters: None
+Returns:
+    A random float on the range (-1,+1).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float ParticleRandom::NextOnRangeNeg1ToPos1()
+{
+    if (NextOnRange0To1() < 0.5f)
+    {
+        return -1.0f * NextOnRange0To1();
+    }
+    else
+    {
+        return +1.0f * NextOnRange0To1();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same as PcgHash(...) in particleRandom.glsl.
+Parameters:
+    v   Any unsigned int.
+Returns:
+    A chaotic unsigned int.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ParticleRandom::PcgHash(unsigned int v)
+{
+    unsigned int state = (v * 747796405u) + 2891336453u;
+    unsigned int word = ((state >> ((state >> 28) + 4)) ^ state) * 277803737u;
+    return (word >> 22) ^ word;
+}
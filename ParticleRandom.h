@@ -0,0 +1,30 @@
+#pragma once
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of the counter-based random number generator in particleRandom.glsl.  Each
+    random number is a hash of a key and a count, and the key is made from the frame, the
+    emitter, and the particle, so a particle that is reset by the same emitter on the same frame
+    gets the same random numbers on the CPU as on the GPU, bit for bit.
+
+    There is no shared state, so any number of threads can make their own without locking.
+
+    Must match particleRandom.glsl.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ParticleRandom
+{
+public:
+    ParticleRandom(unsigned int frameNumber, unsigned int emitterIndex,
+        unsigned int particleIndex);
+
+    unsigned int NextUint();
+    float NextOnRange0To1();
+    float NextOnRangeNeg1ToPos1();
+
+    static unsigned int PcgHash(unsigned int v);
+
+private:
+    unsigned int _key;
+    unsigned int _counter;
+};
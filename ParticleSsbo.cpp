@@ -13,7 +13,8 @@ Returns:    None
 Creator: John Cox, 9-6-2016
 -----------------------------------------------------------------------------------------------*/
 ParticleSsbo::ParticleSsbo() :
-    SsboBase()
+    SsboBase(),
+    _layoutInfo(PARTICLE_LAYOUT_AOS, 0)
 {
 }
 
@@ -47,20 +48,35 @@ Parameters:
     allParticles    The size of this collection determines the size of the SSBO that is 
                     allocated on the GPU, and the values in the collection are dumped into the 
                     GPU buffer.
+    layoutInfo      How to arrange the particles in the buffer.  Must be made for 
+                    allParticles.size() particles.
 Returns:    None
 Creator: John Cox, 11-24-2016
 -----------------------------------------------------------------------------------------------*/
-void ParticleSsbo::Init(const std::vector<Particle> &allParticles)
+void ParticleSsbo::Init(const std::vector<Particle> &allParticles, 
+    const ParticleLayoutInfo &layoutInfo)
 {
     if (_bufferId == 0)
     {
+        if (layoutInfo.NumParticles() != allParticles.size())
+        {
+            fprintf(stderr, "ParticleSsbo::Init(...) error: layout is for %u particles, but there are %u\n",
+                layoutInfo.NumParticles(), (unsigned int)allParticles.size());
+            return;
+        }
+
         glGenBuffers(1, &_bufferId);
 
+        // rearrange the particles into the requested layout before uploading them
+        _layoutInfo = layoutInfo;
+        std::vector<unsigned int> particleWords;
+        _layoutInfo.Pack(allParticles, &particleWords);
+
         // only let the buffer size be set once
         _numVertices = allParticles.size();
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
-        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Particle) * allParticles.size(),
-            allParticles.data(), GL_STATIC_DRAW);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _layoutInfo.BufferSizeBytes(),
+            particleWords.data(), GL_STATIC_DRAW);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
     }
 
@@ -121,6 +137,13 @@ void ParticleSsbo::ConfigureCompute(unsigned int computeProgramId)
 /*-----------------------------------------------------------------------------------------------
 Description:
     Sets up the vertex attribute pointers for this SSBO's VAO.
+
+    Only the AoS layout can be described with vertex attributes (SoA and AoSoA don't have a 
+    fixed distance between one particle and the next, and the compact and quantized layouts' 
+    "is active" flags are bits).  For the other layouts, the render shader 
+    reads the particles straight out of the SSBO by vertex ID (see particleRender.vert), so the 
+    SSBO is bound to the render program like it is to the compute programs and the VAO is left 
+    without any attributes.
 Parameters: 
     RenderProgramId     Self-explanatory
 Returns:    None
@@ -134,6 +157,14 @@ void ParticleSsbo::ConfigureRender(unsigned int renderProgramId)
         return;
     }
 
+    if (_layoutInfo.Layout() != PARTICLE_LAYOUT_AOS)
+    {
+        // same binding as the compute shaders
+        // Note: The VAO is still required.  OpenGL core profile won't draw without one bound.
+        ConfigureCompute(renderProgramId);
+        return;
+    }
+
     // set up the VAO
     // now set up the vertex array indices for the drawing shader
     // Note: MUST bind the program beforehand or else the VAO binding will blow up.  It won't 
@@ -187,3 +218,18 @@ void ParticleSsbo::ConfigureRender(unsigned int renderProgramId)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glUseProgram(0);    // render program
 }
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A getter for how the particles are arranged in the buffer.  The CPU particle reset and 
+    update need this to work on a mapped pointer to the buffer, and the shaders need its 
+    ShaderDefines().
+Parameters: None
+Returns:
+    See description.
+Creator: agent, 10-16-2026
+-----------------------------------------------------------------------------------------------*/
+const ParticleLayoutInfo &ParticleSsbo::GetLayoutInfo() const
+{
+    return _layoutInfo;
+}
@@ -2,6 +2,7 @@
 
 #include "SsboBase.h"
 #include "Particle.h"
+#include "ParticleLayout.h"
 #include <vector>
 
 /*-----------------------------------------------------------------------------------------------
@@ -10,6 +11,9 @@ Description:
     is big enough to store the requested number of particles, and since this buffer will be used 
     in a drawing shader as well as a compute shader, this class will also up the VAO and the 
     vertex attributes.
+
+    The particles can be arranged in memory in several ways (see ParticleLayout).  The shaders 
+    that use this buffer must be built with GetLayoutInfo().ShaderDefines().
 Creator:    John Cox (9-3-2016)
 -----------------------------------------------------------------------------------------------*/
 class ParticleSsbo : public SsboBase
@@ -18,8 +22,14 @@ public:
     ParticleSsbo();
     virtual ~ParticleSsbo();
     
-    void Init(const std::vector<Particle> &allParticles);
+    void Init(const std::vector<Particle> &allParticles, 
+        const ParticleLayoutInfo &layoutInfo);
     void ConfigureCompute(unsigned int computeProgramId) override;
     void ConfigureRender(unsigned int renderProgramId) override;
+
+    const ParticleLayoutInfo &GetLayoutInfo() const;
+
+private:
+    ParticleLayoutInfo _layoutInfo;
 };
 
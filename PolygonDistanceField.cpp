@@ -0,0 +1,198 @@
+#include "PolygonDistanceField.h"
+
+#include "ThreadPool.h"
+
+#include "glm/common.hpp"   // for glm::min(...) and glm::max(...)
+#include "glm/geometric.hpp"
+
+#include <stdio.h>
+
+// how many texels the field extends past the faces' bounding box on every side
+static const unsigned int MARGIN_TEXELS = 2;
+
+// the smallest field that still has texels between the margins
+static const unsigned int MIN_TEXELS_PER_SIDE = (2 * MARGIN_TEXELS) + 4;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values.  The field is empty (and Sample(...) says that nothing is in
+    it) until Bake(...) is called.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonDistanceField::PolygonDistanceField()
+{
+    _header._texelsX = 0;
+    _header._texelsY = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    (Re)bakes the field over the bounding box of the given faces.  Call it again whenever the
+    faces move.
+
+    Faces whose normals have no length can't put anything outside of them, so they are left
+    out.
+Parameters:
+    faces           The polygon's faces.
+    texelsPerSide   The resolution/accuracy knob (see the class description).  At least 8.
+    pThreadPool     Optional.  If provided, the rows are split across the pool's threads.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceField::Bake(const std::vector<PolygonFace> &faces,
+    unsigned int texelsPerSide, ThreadPool *pThreadPool)
+{
+    _distances.clear();
+    _header._texelsX = 0;
+    _header._texelsY = 0;
+    if (faces.empty())
+    {
+        return;
+    }
+    if (texelsPerSide < MIN_TEXELS_PER_SIDE)
+    {
+        fprintf(stderr, "PolygonDistanceField::Bake(...) error: %u texels per side is less than the minimum of %u\n",
+            texelsPerSide, MIN_TEXELS_PER_SIDE);
+        return;
+    }
+
+    _faceLines.clear();
+    glm::vec2 boxMin(faces[0]._start._position);
+    glm::vec2 boxMax(boxMin);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        const PolygonFace &f = faces[faceIndex];
+        glm::vec2 start(f._start._position);
+        glm::vec2 end(f._end._position);
+        boxMin = glm::min(boxMin, glm::min(start, end));
+        boxMax = glm::max(boxMax, glm::max(start, end));
+
+        glm::vec2 normal(f._start._normal);
+        float normalLength = glm::length(normal);
+        if (normalLength > 0.0f)
+        {
+            normal /= normalLength;
+            _faceLines.push_back(glm::vec3(normal, glm::dot(start, normal)));
+        }
+    }
+
+    // a flat region still needs texels with some size
+    glm::vec2 extent = glm::max(boxMax - boxMin, glm::vec2(1.0e-6f));
+    _header._texelSize = extent / (float)(texelsPerSide - 1 - (2 * MARGIN_TEXELS));
+    _header._min = boxMin - ((float)MARGIN_TEXELS * _header._texelSize);
+    _header._texelsX = texelsPerSide;
+    _header._texelsY = texelsPerSide;
+    _distances.resize(texelsPerSide * texelsPerSide);
+
+    if (pThreadPool == 0)
+    {
+        BakeRows(0, texelsPerSide);
+    }
+    else
+    {
+        // each row is independent, so a handful of rows per chunk keeps every thread busy
+        pThreadPool->ParallelFor(texelsPerSide, 4,
+            [this](unsigned int begin, unsigned int end, unsigned int threadIndex)
+        {
+            (void)threadIndex;
+            BakeRows(begin, end);
+        });
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of the shader's sample (see polygonDistanceField.glsl).  Interpolates
+    between the 4 texels around the position.
+Parameters:
+    posX        The X position of the particle to check.
+    posY        The Y position of the particle to check.
+    pDistance   Set to the signed distance (positive is out of bounds) if the position is in
+                the field.
+Returns:
+    True if the position is in the field, otherwise false (check every face instead).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool PolygonDistanceField::Sample(float posX, float posY, float *pDistance) const
+{
+    // written so that NaN also goes to the "not in the field" case
+    float texelX = (posX - _header._min.x) / _header._texelSize.x;
+    float texelY = (posY - _header._min.y) / _header._texelSize.y;
+    bool isInField = (texelX >= 0.0f) && (texelX <= (float)(_header._texelsX - 1)) &&
+        (texelY >= 0.0f) && (texelY <= (float)(_header._texelsY - 1));
+    if (_distances.empty() || !isInField)
+    {
+        return false;
+    }
+
+    // the last row and column are the far side of the one before them
+    unsigned int x = glm::min((unsigned int)texelX, _header._texelsX - 2);
+    unsigned int y = glm::min((unsigned int)texelY, _header._texelsY - 2);
+    float fractionX = texelX - (float)x;
+    float fractionY = texelY - (float)y;
+    const float *pRow = &_distances[(y * _header._texelsX) + x];
+    float bottom = pRow[0] + ((pRow[1] - pRow[0]) * fractionX);
+    pRow += _header._texelsX;
+    float top = pRow[0] + ((pRow[1] - pRow[0]) * fractionX);
+    *pDistance = bottom + ((top - bottom) * fractionY);
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes at the front of the shader's distance field buffer.
+Parameters: None
+Returns:
+    A const reference to the field's placement and size.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const PolygonDistanceFieldHeader &PolygonDistanceField::GetHeader() const
+{
+    return _header;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes right after the header in the shader's distance field buffer.
+Parameters: None
+Returns:
+    A const reference to the texels, row by row from the field's minimum.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const std::vector<float> &PolygonDistanceField::GetDistances() const
+{
+    return _distances;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Bakes the rows in the range [firstRow, endRow).  Every texel gets the largest signed
+    distance to any face's line.
+Parameters:
+    firstRow    Self-explanatory.
+    endRow      One past the last row.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceField::BakeRows(unsigned int firstRow, unsigned int endRow)
+{
+    for (unsigned int y = firstRow; y < endRow; y++)
+    {
+        float posY = _header._min.y + ((float)y * _header._texelSize.y);
+        float *pRow = &_distances[y * _header._texelsX];
+        for (unsigned int x = 0; x < _header._texelsX; x++)
+        {
+            float posX = _header._min.x + ((float)x * _header._texelSize.x);
+            float largestDistance = -1.0e30f;
+            for (size_t lineIndex = 0; lineIndex < _faceLines.size(); lineIndex++)
+            {
+                const glm::vec3 &line = _faceLines[lineIndex];
+                float distance = (posX * line.x) + (posY * line.y) - line.z;
+                largestDistance = glm::max(largestDistance, distance);
+            }
+            pRow[x] = largestDistance;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "PolygonFace.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+class ThreadPool;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The front of the "distance field" buffer.  Must match the DistanceFieldBuffer in
+    polygonDistanceField.glsl (std430: the vec2s are 8 bytes each and the distances start right
+    after the texel counts, 24 bytes in).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct PolygonDistanceFieldHeader
+{
+    glm::vec2 _min;
+    glm::vec2 _texelSize;
+    unsigned int _texelsX;
+    unsigned int _texelsY;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A polygon region baked into a grid of signed distances so that the "out of bounds" check
+    is a single (bilinear) sample no matter how many faces the region has.
+
+    The out of bounds check (ParticleOutOfBoundsPolygon(...) in polygonBoundsCheck.glsl) says
+    that a particle is out if it is on the outside of any face's line, so each texel holds 
+    the largest signed distance from the texel to any face's line (positive is outside).  That 
+    is:
+    - positive exactly where checking every face says "out"
+    - the exact distance to the boundary inside of a convex region
+    - a lower bound on the distance outside of it (it is the distance to the nearest line,
+    not to the nearest face, which is farther near the corners)
+
+    Texels are samples at the corners of the grid (_min, _min + _texelSize, ...), and the field
+    extends a couple of texels past the faces' bounding box so that particles that just left
+    get a positive distance too.  Anything farther out than that isn't in the field, and the
+    caller checks every face.
+
+    Accuracy: Between texels the distance is interpolated.  Along a face that is exact (the
+    distance to a line is linear), but within about a texel of a corner the interpolated
+    distance comes out too high, so particles there can be called "out" a little early.  More
+    texels per side shrink that band.  Baking checks every face for every texel, so it costs
+    (texels x faces) and should only happen when the faces move.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonDistanceField
+{
+public:
+    PolygonDistanceField();
+
+    void Bake(const std::vector<PolygonFace> &faces, unsigned int texelsPerSide,
+        ThreadPool *pThreadPool = 0);
+
+    bool Sample(float posX, float posY, float *pDistance) const;
+
+    const PolygonDistanceFieldHeader &GetHeader() const;
+    const std::vector<float> &GetDistances() const;
+
+private:
+    void BakeRows(unsigned int firstRow, unsigned int endRow);
+
+    PolygonDistanceFieldHeader _header;
+
+    // each face as a normalized line (X and Y of the normal, then the offset along it) so that
+    // baking is one multiply-add per face per texel
+    std::vector<glm::vec3> _faceLines;
+
+    std::vector<float> _distances;
+};
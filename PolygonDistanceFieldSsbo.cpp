@@ -0,0 +1,127 @@
+#include "PolygonDistanceFieldSsbo.h"
+
+#include <stdio.h>
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls the base class to give members initial values (zeros).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonDistanceFieldSsbo::PolygonDistanceFieldSsbo() :
+    SsboBase(),
+    _bufferSizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Exists to be declared virtual so that the base class' destructor is called
+    upon object death.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonDistanceFieldSsbo::~PolygonDistanceFieldSsbo()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the SSBO, but does not allocate space for it.  That happens in
+    UpdateValues(...).  Same restrictions as PolygonSsbo::Init().
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceFieldSsbo::Init()
+{
+    if (_bufferId == 0)
+    {
+        glGenBuffers(1, &_bufferId);
+    }
+
+    _hasBeenInitialized = true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+Parameters:
+    computeProgramId    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceFieldSsbo::ConfigureCompute(unsigned int computeProgramId)
+{
+    if (!_hasBeenInitialized)
+    {
+        fprintf(stderr, "PolygonDistanceFieldSsbo::ConfigureCompute(...) error: SSBO has not been initialized\n");
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+
+    // see the corresponding area in ParticleSsbo::Init(...) for explanation
+    // Note: MUST use the same binding point
+    GLuint ssboBindingPointIndex = 15;  // not 3, 5, 6, 7, 13, or 14
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "DistanceFieldBuffer");
+    glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  The field is never drawn.
+Parameters:
+    renderProgramId     Not used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceFieldSsbo::ConfigureRender(unsigned int renderProgramId)
+{
+    // this statement is only to get rid of an "unreferenced parameter" warning
+    (void)renderProgramId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Uploads the field's header and then its texels right behind it.  The buffer only grows, so 
+    a field that is baked again at the same resolution or lower reuses the existing space.
+
+    Note: The buffer ID doesn't change when the buffer grows, so the binding from
+    ConfigureCompute(...) still holds.
+Parameters:
+    distanceField   Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonDistanceFieldSsbo::UpdateValues(const PolygonDistanceField &distanceField)
+{
+    const std::vector<float> &data = distanceField.GetDistances();
+    if (data.empty())
+    {
+        // not baked
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    unsigned int headerBytes = sizeof(PolygonDistanceFieldHeader);
+    unsigned int dataBytes = sizeof(float) * data.size();
+    if ((headerBytes + dataBytes) > _bufferSizeBytes)
+    {
+        _bufferSizeBytes = headerBytes + dataBytes;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _bufferSizeBytes, 0, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, headerBytes, &distanceField.GetHeader());
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, headerBytes, dataBytes, data.data());
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "SsboBase.h"
+#include "PolygonDistanceField.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that holds a PolygonDistanceField for the compute shaders (see 
+    polygonDistanceField.glsl).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonDistanceFieldSsbo : public SsboBase
+{
+public:
+    PolygonDistanceFieldSsbo();
+    virtual ~PolygonDistanceFieldSsbo();
+
+    void Init();
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+
+    void UpdateValues(const PolygonDistanceField &distanceField);
+
+private:
+    unsigned int _bufferSizeBytes;
+};
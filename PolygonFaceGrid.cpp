@@ -0,0 +1,433 @@
+#include "PolygonFaceGrid.h"
+
+#include "glm/common.hpp"   // for glm::min(...) and glm::max(...)
+#include "glm/geometric.hpp"
+
+#include <math.h>
+#include <stdio.h>
+
+// the grid's resolution when none is given; the grid grows with the face count (about as many
+// cells as faces), but not without limit (1024^2 cells is 8MB of cells)
+static const unsigned int MIN_AUTO_CELLS_PER_SIDE = 4;
+static const unsigned int MAX_AUTO_CELLS_PER_SIDE = 1024;
+
+// how close (relative to the size of the region) a line can come to a cell's corner before the
+// line counts as crossing the cell
+static const float SIDE_EPSILON_SCALE = 1.0e-5f;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "out of bounds" check for one face.  Same as ParticleOutOfBoundsPolygon(...) in
+    polygonBoundsCheck.glsl.
+Parameters:
+    posX    Self-explanatory.
+    posY    Self-explanatory.
+    f       The face.
+Returns:
+    How far outside of the face's line the position is (times the normal's length).  Positive
+    is outside.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline float DistanceOutsideFace(float posX, float posY, const PolygonFace &f)
+{
+    float faceToParticleX = posX - f._start._position.x;
+    float faceToParticleY = posY - f._start._position.y;
+    return (faceToParticleX * f._start._normal.x) + (faceToParticleY * f._start._normal.y);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if any part of a line segment is in a box (Liang-Barsky clipping).
+Parameters:
+    start   One end of the segment.
+    end     The other end.
+    boxMin  The box's lower left corner.
+    boxMax  The box's upper right corner.
+Returns:
+    True if the segment touches the box, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static bool SegmentReachesBox(const glm::vec2 &start, const glm::vec2 &end, 
+    const glm::vec2 &boxMin, const glm::vec2 &boxMax)
+{
+    // the part of the segment that is in the box is [enter, exit] (0 is the start, 1 the end)
+    float enter = 0.0f;
+    float exit = 1.0f;
+    glm::vec2 startToEnd = end - start;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (startToEnd[axis] == 0.0f)
+        {
+            if (start[axis] < boxMin[axis] || start[axis] > boxMax[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float toMin = (boxMin[axis] - start[axis]) / startToEnd[axis];
+        float toMax = (boxMax[axis] - start[axis]) / startToEnd[axis];
+        enter = glm::max(enter, glm::min(toMin, toMax));
+        exit = glm::min(exit, glm::max(toMin, toMax));
+        if (enter > exit)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values.  The grid is empty (and ParticleOutOfBounds(...) checks
+    every face) until Build(...) is called.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonFaceGrid::PolygonFaceGrid() :
+    _sideEpsilon(0.0f)
+{
+    _header._cellsX = 0;
+    _header._cellsY = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    (Re)builds the grid over the bounding box of the given faces.  Call it again whenever the
+    faces move.
+Parameters:
+    faces           The polygon's faces.  The same ones must be given to
+                    ParticleOutOfBounds(...) (and be in the shader's face buffer) because the
+                    cells refer to them by index.
+    cellsPerSide    Optional.  Must be a power of 2.  If 0, then it is picked from the number of
+                    faces.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonFaceGrid::Build(const std::vector<PolygonFace> &faces, unsigned int cellsPerSide)
+{
+    _data.clear();
+    _header._cellsX = 0;
+    _header._cellsY = 0;
+    if (faces.empty())
+    {
+        return;
+    }
+
+    if (cellsPerSide == 0)
+    {
+        cellsPerSide = MIN_AUTO_CELLS_PER_SIDE;
+        while ((cellsPerSide * cellsPerSide) < faces.size() && cellsPerSide < MAX_AUTO_CELLS_PER_SIDE)
+        {
+            cellsPerSide *= 2;
+        }
+    }
+    else if ((cellsPerSide & (cellsPerSide - 1)) != 0)
+    {
+        fprintf(stderr, "PolygonFaceGrid::Build(...) error: %u cells per side is not a power of 2\n", cellsPerSide);
+        return;
+    }
+
+    // a face's end is the next face's start, but checking both is simpler than assuming it
+    glm::vec2 boxMin(faces[0]._start._position);
+    glm::vec2 boxMax(boxMin);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        glm::vec2 start(faces[faceIndex]._start._position);
+        glm::vec2 end(faces[faceIndex]._end._position);
+        boxMin = glm::min(boxMin, glm::min(start, end));
+        boxMax = glm::max(boxMax, glm::max(start, end));
+    }
+
+    // a flat region still needs cells with some size
+    glm::vec2 extent = glm::max(boxMax - boxMin, glm::vec2(1.0e-6f));
+    _header._min = boxMin;
+    _header._cellSize = extent / (float)cellsPerSide;
+    _header._cellsX = cellsPerSide;
+    _header._cellsY = cellsPerSide;
+    _sideEpsilon = SIDE_EPSILON_SCALE * glm::max(extent.x, extent.y);
+
+    // every cell starts out "inside" (no faces), and the face lists are added after the cells
+    _data.assign(2 * cellsPerSide * cellsPerSide, 0);
+
+    std::vector<unsigned int> allFaces(faces.size());
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        allFaces[faceIndex] = (unsigned int)faceIndex;
+    }
+    BuildBlock(faces, 0, 0, cellsPerSide, allFaces);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of the shader's grid lookup (see polygonFaceGrid.glsl).  Gives the same
+    answer as checking every face.
+Parameters:
+    posX    The X position of the particle to check.
+    posY    The Y position of the particle to check.
+    faces   The same faces that the grid was built with.
+Returns:
+    True if the particle is on the outside of any face, otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool PolygonFaceGrid::ParticleOutOfBounds(float posX, float posY,
+    const std::vector<PolygonFace> &faces) const
+{
+    // written so that NaN also goes to the "not in the grid" case
+    float cellX = (posX - _header._min.x) / _header._cellSize.x;
+    float cellY = (posY - _header._min.y) / _header._cellSize.y;
+    bool isInGrid = (cellX >= 0.0f) && (cellX < (float)_header._cellsX) &&
+        (cellY >= 0.0f) && (cellY < (float)_header._cellsY);
+    if (!isInGrid)
+    {
+        for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+        {
+            if (DistanceOutsideFace(posX, posY, faces[faceIndex]) > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    unsigned int cellIndex = ((unsigned int)cellY * _header._cellsX) + (unsigned int)cellX;
+    unsigned int firstListed = _data[(2 * cellIndex) + 0];
+    unsigned int numListed = _data[(2 * cellIndex) + 1];
+    if (numListed == CELL_OUTSIDE)
+    {
+        return true;
+    }
+
+    for (unsigned int listIndex = firstListed; listIndex < firstListed + numListed; listIndex++)
+    {
+        if (DistanceOutsideFace(posX, posY, faces[_data[listIndex]]) > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes at the front of the shader's face grid buffer.
+Parameters: None
+Returns:
+    A const reference to the grid's placement and size.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const PolygonFaceGridHeader &PolygonFaceGrid::GetHeader() const
+{
+    return _header;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes right after the header in the shader's face grid buffer.
+Parameters: None
+Returns:
+    A const reference to the cells and their face lists.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const std::vector<unsigned int> &PolygonFaceGrid::GetData() const
+{
+    return _data;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Sorts out one square block of cells.  The candidate faces are the only ones whose lines
+    might cross the block (all the others were found to be on the inside of the block that this
+    one was split from).
+    - If the block is all on the outside of one candidate's line, then every cell is "outside".
+    - If the block is all on the inside of every candidate's line, then every cell is "inside".
+    - Otherwise, the faces whose lines cross the block are either the cell's face list (if the
+    block is one cell) or the candidates for the 4 quarters of the block.
+Parameters:
+    faces           Self-explanatory.
+    firstCellX      The block's lower left cell.
+    firstCellY      Same.
+    blockCells      How many cells there are on each side of the block (a power of 2).
+    candidateFaces  Indices of the faces to check.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonFaceGrid::BuildBlock(const std::vector<PolygonFace> &faces, unsigned int firstCellX,
+    unsigned int firstCellY, unsigned int blockCells,
+    const std::vector<unsigned int> &candidateFaces)
+{
+    glm::vec2 blockMin = _header._min +
+        (glm::vec2((float)firstCellX, (float)firstCellY) * _header._cellSize);
+    glm::vec2 blockMax = blockMin + ((float)blockCells * _header._cellSize);
+
+    std::vector<unsigned int> crossingFaces;
+    for (size_t candidateIndex = 0; candidateIndex < candidateFaces.size(); candidateIndex++)
+    {
+        unsigned int faceIndex = candidateFaces[candidateIndex];
+        const PolygonFace &f = faces[faceIndex];
+        float epsilon = _sideEpsilon * glm::length(glm::vec2(f._start._normal));
+
+        float corners[4] =
+        {
+            DistanceOutsideFace(blockMin.x, blockMin.y, f),
+            DistanceOutsideFace(blockMax.x, blockMin.y, f),
+            DistanceOutsideFace(blockMin.x, blockMax.y, f),
+            DistanceOutsideFace(blockMax.x, blockMax.y, f)
+        };
+        float nearest = glm::min(glm::min(corners[0], corners[1]), glm::min(corners[2], corners[3]));
+        float farthest = glm::max(glm::max(corners[0], corners[1]), glm::max(corners[2], corners[3]));
+        if (nearest > epsilon)
+        {
+            FillBlock(firstCellX, firstCellY, blockCells, CELL_OUTSIDE);
+            return;
+        }
+        else if (farthest >= -epsilon)
+        {
+            crossingFaces.push_back(faceIndex);
+        }
+    }
+
+    if (crossingFaces.empty())
+    {
+        // already "inside"
+        return;
+    }
+
+    if (blockCells == 1)
+    {
+        ReduceToReachingFaces(faces, blockMin, blockMax, &crossingFaces);
+        if (crossingFaces.empty())
+        {
+            return;
+        }
+
+        unsigned int cellIndex = (firstCellY * _header._cellsX) + firstCellX;
+        _data[(2 * cellIndex) + 0] = (unsigned int)_data.size();
+        _data[(2 * cellIndex) + 1] = (unsigned int)crossingFaces.size();
+        _data.insert(_data.end(), crossingFaces.begin(), crossingFaces.end());
+        return;
+    }
+
+    unsigned int halfBlockCells = blockCells / 2;
+    BuildBlock(faces, firstCellX, firstCellY, halfBlockCells, crossingFaces);
+    BuildBlock(faces, firstCellX + halfBlockCells, firstCellY, halfBlockCells, crossingFaces);
+    BuildBlock(faces, firstCellX, firstCellY + halfBlockCells, halfBlockCells, crossingFaces);
+    BuildBlock(faces, firstCellX + halfBlockCells, firstCellY + halfBlockCells, halfBlockCells,
+        crossingFaces);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the faces whose segments don't reach the cell out of its list if that doesn't change 
+    any answers in the cell (see the class description).  Otherwise the list is left alone.
+
+    The part of the cell that is inside of every face that reaches it is found by clipping the 
+    cell with them.  If that part is also inside of all of the other faces, then those other 
+    faces can't make any particle in the cell "out" that the reaching faces don't already.
+Parameters:
+    faces           Self-explanatory.
+    cellMin         The cell's lower left corner.
+    cellMax         The cell's upper right corner.
+    pCrossingFaces  The faces whose lines cross the cell.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonFaceGrid::ReduceToReachingFaces(const std::vector<PolygonFace> &faces, 
+    const glm::vec2 &cellMin, const glm::vec2 &cellMax, 
+    std::vector<unsigned int> *pCrossingFaces) const
+{
+    // a little bigger so that rounding doesn't lose a face that just touches the cell
+    glm::vec2 reachMin = cellMin - glm::vec2(_sideEpsilon);
+    glm::vec2 reachMax = cellMax + glm::vec2(_sideEpsilon);
+    std::vector<unsigned int> reachingFaces;
+    std::vector<unsigned int> otherFaces;
+    for (size_t listIndex = 0; listIndex < pCrossingFaces->size(); listIndex++)
+    {
+        const PolygonFace &f = faces[(*pCrossingFaces)[listIndex]];
+        if (SegmentReachesBox(glm::vec2(f._start._position), glm::vec2(f._end._position), 
+            reachMin, reachMax))
+        {
+            reachingFaces.push_back((*pCrossingFaces)[listIndex]);
+        }
+        else
+        {
+            otherFaces.push_back((*pCrossingFaces)[listIndex]);
+        }
+    }
+    if (otherFaces.empty())
+    {
+        return;
+    }
+
+    // clip the cell with each reaching face (Sutherland-Hodgman)
+    std::vector<glm::vec2> insidePart;
+    insidePart.push_back(cellMin);
+    insidePart.push_back(glm::vec2(cellMax.x, cellMin.y));
+    insidePart.push_back(cellMax);
+    insidePart.push_back(glm::vec2(cellMin.x, cellMax.y));
+    std::vector<glm::vec2> clipped;
+    for (size_t listIndex = 0; listIndex < reachingFaces.size() && !insidePart.empty(); listIndex++)
+    {
+        const PolygonFace &f = faces[reachingFaces[listIndex]];
+        clipped.clear();
+        for (size_t pointIndex = 0; pointIndex < insidePart.size(); pointIndex++)
+        {
+            const glm::vec2 &p = insidePart[pointIndex];
+            const glm::vec2 &q = insidePart[(pointIndex + 1) % insidePart.size()];
+            float pOutside = DistanceOutsideFace(p.x, p.y, f);
+            float qOutside = DistanceOutsideFace(q.x, q.y, f);
+            if (pOutside <= 0.0f)
+            {
+                clipped.push_back(p);
+            }
+            if ((pOutside <= 0.0f) != (qOutside <= 0.0f))
+            {
+                clipped.push_back(p + ((q - p) * (pOutside / (pOutside - qOutside))));
+            }
+        }
+        insidePart.swap(clipped);
+    }
+
+    for (size_t listIndex = 0; listIndex < otherFaces.size(); listIndex++)
+    {
+        const PolygonFace &f = faces[otherFaces[listIndex]];
+        float epsilon = _sideEpsilon * glm::length(glm::vec2(f._start._normal));
+        for (size_t pointIndex = 0; pointIndex < insidePart.size(); pointIndex++)
+        {
+            if (DistanceOutsideFace(insidePart[pointIndex].x, insidePart[pointIndex].y, f) > epsilon)
+            {
+                return;
+            }
+        }
+    }
+
+    pCrossingFaces->swap(reachingFaces);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives every cell in a block the same state (no face list).
+Parameters:
+    firstCellX      The block's lower left cell.
+    firstCellY      Same.
+    blockCells      How many cells there are on each side of the block.
+    cellState       CELL_OUTSIDE or 0 ("inside").
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonFaceGrid::FillBlock(unsigned int firstCellX, unsigned int firstCellY,
+    unsigned int blockCells, unsigned int cellState)
+{
+    for (unsigned int cellY = firstCellY; cellY < firstCellY + blockCells; cellY++)
+    {
+        for (unsigned int cellX = firstCellX; cellX < firstCellX + blockCells; cellX++)
+        {
+            unsigned int cellIndex = (cellY * _header._cellsX) + cellX;
+            _data[(2 * cellIndex) + 0] = 0;
+            _data[(2 * cellIndex) + 1] = cellState;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "PolygonFace.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The front of the "face grid" buffer.  Must match the FaceGridBuffer in
+    polygonFaceGrid.glsl (std430: the vec2s are 8 bytes each and the grid data starts right
+    after the cell counts, 24 bytes in).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct PolygonFaceGridHeader
+{
+    glm::vec2 _min;
+    glm::vec2 _cellSize;
+    unsigned int _cellsX;
+    unsigned int _cellsY;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A uniform grid over a polygon region's bounding box that lets the "out of bounds" check
+    look at only a few faces instead of all of them.
+
+    The out of bounds check (ParticleOutOfBoundsPolygon(...) in polygonBoundsCheck.glsl) says
+    that a particle is out if it is on the outside of any face's line.  Whether a particle is on the
+    outside of a line is linear in its position, so if all 4 corners of a cell are on the same
+    side, then so is everything in the cell.  Each cell therefore stores one of:
+    - "outside": every point in the cell is outside of some face
+    - "inside": every point in the cell is inside of every face (no faces listed)
+    - the short list of faces whose lines cross the cell; only these need checking
+    That gives the same answers as checking every face.  Positions that aren't in the
+    grid at all (only particles on their way out of the region) are checked against every
+    face.
+
+    A cell's list is then cut down to the faces whose segments actually reach the cell when 
+    the others can't change any answers in it (always the case for a closed convex polygon 
+    like the demo's region).  Without this, a cell near a smooth boundary with thousands of 
+    faces would list every face whose (infinitely long) line clips it.  This is checked to 
+    within a tiny epsilon, so answers can only differ from checking every face for particles 
+    right on the boundary, where rounding decides anyway.
+
+    The grid is built from the top down: a block of cells only checks the faces whose lines
+    crossed the block that it was split from, so most faces are thrown out after the first
+    few splits and building is far cheaper than checking every face against every cell.
+
+    The data is laid out the same way as it is in the shader's buffer: 2 words per cell
+    (where its face list starts in the data and how many faces are in it, or
+    CELL_OUTSIDE), then every cell's face list.  Cells go row by row from the grid's minimum.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonFaceGrid
+{
+public:
+    // the "face count" of a cell that is completely outside of the region
+    static const unsigned int CELL_OUTSIDE = 0xFFFFFFFF;
+
+    PolygonFaceGrid();
+
+    void Build(const std::vector<PolygonFace> &faces, unsigned int cellsPerSide = 0);
+
+    bool ParticleOutOfBounds(float posX, float posY,
+        const std::vector<PolygonFace> &faces) const;
+
+    const PolygonFaceGridHeader &GetHeader() const;
+    const std::vector<unsigned int> &GetData() const;
+
+private:
+    void BuildBlock(const std::vector<PolygonFace> &faces, unsigned int firstCellX,
+        unsigned int firstCellY, unsigned int blockCells,
+        const std::vector<unsigned int> &candidateFaces);
+    void ReduceToReachingFaces(const std::vector<PolygonFace> &faces, 
+        const glm::vec2 &cellMin, const glm::vec2 &cellMax, 
+        std::vector<unsigned int> *pCrossingFaces) const;
+    void FillBlock(unsigned int firstCellX, unsigned int firstCellY, unsigned int blockCells,
+        unsigned int cellState);
+
+    PolygonFaceGridHeader _header;
+
+    // lines that pass this close to a corner count as crossing the cell so that rounding
+    // can't make a cell look like it is all on one side when it isn't
+    float _sideEpsilon;
+
+    std::vector<unsigned int> _data;
+};
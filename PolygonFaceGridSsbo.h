@@ -0,0 +1,27 @@
+#pragma once
+
+#include "SsboBase.h"
+#include "PolygonFaceGrid.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that holds a PolygonFaceGrid for the compute shaders (see 
+    polygonFaceGrid.glsl).  The grid refers to faces by their index in the PolygonSsbo, so the 
+    two have to be uploaded from the same faces.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonFaceGridSsbo : public SsboBase
+{
+public:
+    PolygonFaceGridSsbo();
+    virtual ~PolygonFaceGridSsbo();
+
+    void Init();
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+
+    void UpdateValues(const PolygonFaceGrid &faceGrid);
+
+private:
+    unsigned int _bufferSizeBytes;
+};
@@ -11,26 +11,29 @@ Creator: John Cox, 9-8-2016
 -----------------------------------------------------------------------------------------------*/
 PolygonSsbo::PolygonSsbo() :
     SsboBase(),
-    _bufferSizeBytes(0)
+    _bufferSizeBytes(0),
+    _planeBufferId(0),
+    _planeBufferSizeBytes(0)
 {
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Does nothing.  Exists to be declared virtual so that the base class' destructor is called 
-    upon object death.
+    Deletes the plane buffer.  The base class deletes the rest.
 Parameters: None
 Returns:    None
 Creator: John Cox, 9-8-2016
 -----------------------------------------------------------------------------------------------*/
 PolygonSsbo::~PolygonSsbo()
 {
+    glDeleteBuffers(1, &_planeBufferId);
 }
 
 /*-----------------------------------------------------------------------------------------------
 Description:
-    Generates the SSBO and the VAO, but does not allocate space for them.  
-    The SSBO is bound in ConfigureCompute(...) and sized/resized in UpdateValues(...).
+    Generates the SSBOs (faces and planes) and the VAO, but does not allocate space for them.  
+    The plane SSBO is bound in ConfigureCompute(...), and both are sized/resized in 
+    UpdateValues(...).
     The VAO is initialized in ConfigureRender(...).
 
     Note: MUST be called before calling ConfigureCompute(...) and ConfigureRender(...).
@@ -49,6 +52,10 @@ void PolygonSsbo::Init()
         glGenBuffers(1, &_bufferId);
         // do not allocate space; that happens at runtime with UpdateValues(...)
     }
+    if (_planeBufferId == 0)
+    {
+        glGenBuffers(1, &_planeBufferId);
+    }
     if (_vaoId == 0)
     {
         glGenVertexArrays(1, &_vaoId);
@@ -60,6 +67,7 @@ void PolygonSsbo::Init()
 /*-----------------------------------------------------------------------------------------------
 Description:
     Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+    The compute shaders only see the planes.
 Parameters: 
     computeProgramId    Self-explanatory
 Returns:    None
@@ -73,14 +81,14 @@ void PolygonSsbo::ConfigureCompute(unsigned int computeProgramId)
         return;
     }
 
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _planeBufferId);
 
     // see the corresponding area in ParticleSsbo::Init(...) for explanation
     // Note: MUST use the same binding point 
     GLuint ssboBindingPointIndex = 13;   // or 1, or 5, or 17, or wherever IS UNUSED
-    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "FaceBuffer");
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "FacePlaneBuffer");
     glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _planeBufferId);
 
     // cleanup
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
@@ -151,6 +159,8 @@ Description:
     Rather than duplicate load, I'll go out of my way to give the compute shader pre-transformed 
     values.
     
+    The compute shaders' planes are made from the same faces and uploaded along with them.
+    
     Note: Do not pass in arrays of different sizes at runtime.  Just use a single array. This 
     SSBO object has no concept of the compute shader's contents, so it does not update the 
     compute shader's "num faces" uniform.  
@@ -161,6 +171,9 @@ Creator: John Cox, 10-10-2016
 -----------------------------------------------------------------------------------------------*/
 void PolygonSsbo::UpdateValues(const std::vector<PolygonFace> &faceCollection)
 {
+    UpdatePlanes(faceCollection, 0, faceCollection.size(), 
+        (sizeof(float) * 3 * faceCollection.size()) > _planeBufferSizeBytes);
+
     // two vertices per face (used with glDrawArrays)
     _numVertices = faceCollection.size() * 2;
 
@@ -181,3 +194,91 @@ void PolygonSsbo::UpdateValues(const std::vector<PolygonFace> &faceCollection)
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Like UpdateValues(faceCollection), but only uploads the given range of faces (see 
+    ParticleRegionPolygon::GetChangedFaces(...)).  If the buffer isn't big enough for the whole 
+    collection yet, then the whole collection is uploaded.
+Parameters:
+    faceCollection  Self-explanatory
+    firstFace       The first face to upload.
+    numFaces        How many faces to upload.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonSsbo::UpdateValues(const std::vector<PolygonFace> &faceCollection, 
+    unsigned int firstFace, unsigned int numFaces)
+{
+    unsigned int byteCounter = sizeof(PolygonFace) * faceCollection.size();
+    if (byteCounter > _bufferSizeBytes)
+    {
+        UpdateValues(faceCollection);
+        return;
+    }
+
+    if (firstFace >= faceCollection.size() || numFaces == 0)
+    {
+        return;
+    }
+    if (numFaces > faceCollection.size() - firstFace)
+    {
+        numFaces = faceCollection.size() - firstFace;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(PolygonFace) * firstFace, 
+        sizeof(PolygonFace) * numFaces, faceCollection.data() + firstFace);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    UpdatePlanes(faceCollection, firstFace, numFaces, false);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Turns the given range of faces into the compute shaders' planes (see 
+    polygonFacePlanes.glsl) and uploads them to the same range of the plane buffer.
+
+    Note: The faces' normals have no Z or W, and dotting the particle's position with the 
+    normal and then taking away the normal dotted with the face's start is the same as the old 
+    dot(position - start, normal), so the normals are not normalized.
+Parameters:
+    faceCollection  Self-explanatory
+    firstFace       The first face to upload.
+    numFaces        How many faces to upload.
+    reallocate      If true, the buffer is (re)allocated to fit the range (which must then be 
+                    the whole collection).
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonSsbo::UpdatePlanes(const std::vector<PolygonFace> &faceCollection, 
+    unsigned int firstFace, unsigned int numFaces, bool reallocate)
+{
+    _planes.resize(3 * numFaces);
+    for (unsigned int faceCount = 0; faceCount < numFaces; faceCount++)
+    {
+        const PolygonFace &f = faceCollection[firstFace + faceCount];
+        _planes[(3 * faceCount) + 0] = f._start._normal.x;
+        _planes[(3 * faceCount) + 1] = f._start._normal.y;
+        _planes[(3 * faceCount) + 2] = (f._start._position.x * f._start._normal.x) + 
+            (f._start._position.y * f._start._normal.y);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _planeBufferId);
+    unsigned int byteCounter = sizeof(float) * _planes.size();
+    if (reallocate)
+    {
+        _planeBufferSizeBytes = byteCounter;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _planeBufferSizeBytes, _planes.data(), GL_STATIC_DRAW);
+    }
+    else
+    {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(float) * 3 * firstFace, byteCounter, 
+            _planes.data());
+    }
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
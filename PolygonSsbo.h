@@ -8,6 +8,11 @@
 Description:
     Sets up the Shader Storage Block Object for a 2D polygon.  The polygon will be used in both 
     the compute shader and in the geometry render shader.
+
+    The render shader draws the whole faces, but the compute shaders' bounds check only needs 
+    the half-plane behind each face, so a second, compact buffer of planes (see 
+    polygonFacePlanes.glsl) is kept alongside the faces and only that one is given to the 
+    compute shaders.  A plane is 12 bytes instead of a face's 64.
 Creator: John Cox, 9-8-2016
 -----------------------------------------------------------------------------------------------*/
 class PolygonSsbo : public SsboBase
@@ -21,8 +26,19 @@ public:
     void ConfigureRender(unsigned int renderProgramId) override;
 
     void UpdateValues(const std::vector<PolygonFace> &faceCollection);
+    void UpdateValues(const std::vector<PolygonFace> &faceCollection, unsigned int firstFace,
+        unsigned int numFaces);
 
 private:
+    void UpdatePlanes(const std::vector<PolygonFace> &faceCollection, unsigned int firstFace,
+        unsigned int numFaces, bool reallocate);
+
     unsigned int _bufferSizeBytes;
+
+    unsigned int _planeBufferId;
+    unsigned int _planeBufferSizeBytes;
+
+    // reused for every upload so that converting the faces doesn't allocate
+    std::vector<float> _planes;
 };
 
@@ -0,0 +1,251 @@
+#include "PolygonWindingTable.h"
+
+#include "glm/common.hpp"   // for glm::min(...) and glm::max(...)
+
+#include <string.h>     // for memcpy(...)
+
+// the table's resolution when none is given; about as many rows as faces, so that most rows 
+// only list a few, but not without limit
+static const unsigned int MIN_AUTO_ROWS = 16;
+static const unsigned int MAX_AUTO_ROWS = 4096;
+
+// each face in a row is its start and end
+static const unsigned int WORDS_PER_FACE = 4;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The float as it is stored in the table.
+Parameters:
+    value   Self-explanatory.
+Returns:
+    The float's bits.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline unsigned int FloatBits(float value)
+{
+    unsigned int bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The opposite of FloatBits(...).
+Parameters:
+    bits    A float's bits out of the table.
+Returns:
+    The float.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline float BitsFloat(unsigned int bits)
+{
+    float value = 0.0f;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives members initial values.  The table is empty (and says that nothing is out of bounds)
+    until Build(...) is called.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonWindingTable::PolygonWindingTable()
+{
+    _header._rowsPerUnit = 0.0f;
+    _header._rows = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    (Re)builds the table over the bounding box of the given faces.  Call it again whenever the
+    faces move.
+Parameters:
+    faces       The region's faces.  They must make closed loops (see the class description).
+    numRows     The table's resolution.  If 0, it is picked based on the number of faces.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonWindingTable::Build(const std::vector<PolygonFace> &faces, unsigned int numRows)
+{
+    _data.clear();
+    _header._rowsPerUnit = 0.0f;
+    _header._rows = 0;
+    if (faces.empty())
+    {
+        return;
+    }
+
+    if (numRows == 0)
+    {
+        numRows = glm::min(glm::max((unsigned int)faces.size(), MIN_AUTO_ROWS), MAX_AUTO_ROWS);
+    }
+
+    glm::vec2 boxMin(faces[0]._start._position);
+    glm::vec2 boxMax(boxMin);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        glm::vec2 start(faces[faceIndex]._start._position);
+        glm::vec2 end(faces[faceIndex]._end._position);
+        boxMin = glm::min(boxMin, glm::min(start, end));
+        boxMax = glm::max(boxMax, glm::max(start, end));
+    }
+    _header._min = boxMin;
+    _header._max = boxMax;
+    _header._rows = numRows;
+
+    // a flat region has no faces that span any height, so every row stays empty
+    float height = boxMax.y - boxMin.y;
+    _header._rowsPerUnit = (height > 0.0f) ? ((float)numRows / height) : 0.0f;
+
+    // first count each row's faces so that the rows can be laid out back to back, then fill 
+    // them in
+    // Note: A face spans [lower Y, upper Y) as far as the ray is concerned, and RowOf(...) 
+    // never goes down as Y goes up, so every particle whose ray a face can cross is in one of 
+    // the rows from RowOf(lower Y) to RowOf(upper Y).
+    std::vector<unsigned int> rowStarts(numRows + 1, 0);
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        const PolygonFace &f = faces[faceIndex];
+        if (f._start._position.y == f._end._position.y)
+        {
+            continue;
+        }
+
+        unsigned int firstRow = RowOf(glm::min(f._start._position.y, f._end._position.y));
+        unsigned int lastRow = RowOf(glm::max(f._start._position.y, f._end._position.y));
+        for (unsigned int row = firstRow; row <= lastRow; row++)
+        {
+            rowStarts[row + 1]++;
+        }
+    }
+    for (unsigned int row = 0; row < numRows; row++)
+    {
+        rowStarts[row + 1] += rowStarts[row];
+    }
+
+    unsigned int faceDataStart = numRows + 1;
+    _data.resize(faceDataStart + (WORDS_PER_FACE * rowStarts[numRows]));
+    memcpy(_data.data(), rowStarts.data(), sizeof(unsigned int) * rowStarts.size());
+
+    // rowStarts now becomes where the next face in each row goes
+    for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+    {
+        const PolygonFace &f = faces[faceIndex];
+        if (f._start._position.y == f._end._position.y)
+        {
+            continue;
+        }
+
+        unsigned int firstRow = RowOf(glm::min(f._start._position.y, f._end._position.y));
+        unsigned int lastRow = RowOf(glm::max(f._start._position.y, f._end._position.y));
+        for (unsigned int row = firstRow; row <= lastRow; row++)
+        {
+            unsigned int *pFace = &_data[faceDataStart + (WORDS_PER_FACE * rowStarts[row]++)];
+            pFace[0] = FloatBits(f._start._position.x);
+            pFace[1] = FloatBits(f._start._position.y);
+            pFace[2] = FloatBits(f._end._position.x);
+            pFace[3] = FloatBits(f._end._position.y);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The CPU version of the shader's check (see polygonWindingTable.glsl).  Counts the faces in 
+    the particle's row that cross the ray to its right.
+Parameters:
+    posX    The X position of the particle to check.
+    posY    The Y position of the particle to check.
+Returns:
+    True if the faces don't wind around the particle (or it isn't even in the region's 
+    bounding box), otherwise false.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool PolygonWindingTable::ParticleOutOfBounds(float posX, float posY) const
+{
+    if (_data.empty())
+    {
+        return false;
+    }
+
+    // written so that NaN also goes to the "out" case
+    if (!(posX >= _header._min.x && posX <= _header._max.x && 
+        posY >= _header._min.y && posY <= _header._max.y))
+    {
+        return true;
+    }
+
+    unsigned int row = RowOf(posY);
+    unsigned int faceDataStart = _header._rows + 1;
+    int winding = 0;
+    for (unsigned int faceIndex = _data[row]; faceIndex < _data[row + 1]; faceIndex++)
+    {
+        const unsigned int *pFace = &_data[faceDataStart + (WORDS_PER_FACE * faceIndex)];
+        float startX = BitsFloat(pFace[0]);
+        float startY = BitsFloat(pFace[1]);
+        float endX = BitsFloat(pFace[2]);
+        float endY = BitsFloat(pFace[3]);
+
+        // positive if the particle is to the left of the face (going from start to end)
+        float side = ((endX - startX) * (posY - startY)) - ((posX - startX) * (endY - startY));
+        if (startY <= posY)
+        {
+            if (endY > posY && side > 0.0f)
+            {
+                // going up and crossing the ray
+                winding++;
+            }
+        }
+        else if (endY <= posY && side < 0.0f)
+        {
+            // going down and crossing the ray
+            winding--;
+        }
+    }
+
+    return winding == 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes at the front of the shader's winding table buffer.
+Parameters: None
+Returns:
+    A const reference to the table's placement and size.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const PolygonWindingTableHeader &PolygonWindingTable::GetHeader() const
+{
+    return _header;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.  Goes right after the header in the shader's winding table buffer.
+Parameters: None
+Returns:
+    A const reference to the row starts and the rows' faces (see the class description).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+const std::vector<unsigned int> &PolygonWindingTable::GetData() const
+{
+    return _data;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Which row a height falls in.  Same as the shader.
+Parameters:
+    posY    Somewhere in the table's bounding box.
+Returns:
+    The row, from 0 to (rows - 1).  The top of the box goes in the last row.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int PolygonWindingTable::RowOf(float posY) const
+{
+    float row = (posY - _header._min.y) * _header._rowsPerUnit;
+    return glm::min((unsigned int)glm::max(row, 0.0f), _header._rows - 1);
+}
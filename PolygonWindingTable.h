@@ -0,0 +1,67 @@
+#pragma once
+
+#include "PolygonFace.h"
+#include "glm/vec2.hpp"
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The front of the "winding table" buffer.  Must match the WindingTableBuffer in
+    polygonWindingTable.glsl (std430: the vec2s are 8 bytes each and the table data starts 
+    right after the row count, 24 bytes in).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct PolygonWindingTableHeader
+{
+    glm::vec2 _min;
+    glm::vec2 _max;
+    float _rowsPerUnit;
+    unsigned int _rows;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An "out of bounds" check for regions that the per-face check can't handle: concave 
+    regions and regions with holes.  
+
+    The per-face check (ParticleOutOfBoundsPolygon(...) in polygonBoundsCheck.glsl) says that 
+    a particle is out if it is on the outside of any face's line, which is only right for a 
+    single convex loop of faces.  This instead counts how many times the faces wind around the 
+    particle (a winding number; see Dan Sunday's "Inclusion of a Point in a Polygon") by 
+    casting a ray to the right of the particle and adding up the faces that cross it: +1 for 
+    each one going up, -1 for each one going down.  Zero is outside.  The faces can make any 
+    number of closed loops as long as they follow the same convention as the demo's region 
+    (normals point out, so outer loops go counterclockwise and holes go clockwise).
+
+    Only faces that span the particle's height can cross the ray, so the region's bounding box 
+    is cut into rows and each row lists the faces that span any part of it.  A particle only 
+    checks the faces in its own row.  Horizontal faces never cross the ray and aren't listed 
+    at all.
+
+    The data is laid out the same way as it is in the shader's buffer: (rows + 1) words that 
+    say where each row's faces start (counted in faces; the last one is where the last row 
+    ends), then every row's faces as 4 words each (start X, start Y, end X, end Y; float bits).
+    A face is copied into every row that it spans so that a row's faces are all together.
+
+    Note: Rows are found by multiplying rather than dividing so that the CPU and the shader 
+    put a particle in the same row (float multiplication is exact to the last bit in both).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonWindingTable
+{
+public:
+    PolygonWindingTable();
+
+    void Build(const std::vector<PolygonFace> &faces, unsigned int numRows = 0);
+
+    bool ParticleOutOfBounds(float posX, float posY) const;
+
+    const PolygonWindingTableHeader &GetHeader() const;
+    const std::vector<unsigned int> &GetData() const;
+
+private:
+    unsigned int RowOf(float posY) const;
+
+    PolygonWindingTableHeader _header;
+    std::vector<unsigned int> _data;
+};
@@ -0,0 +1,127 @@
+#include "PolygonWindingTableSsbo.h"
+
+#include <stdio.h>
+
+#include "glload/include/glload/gl_4_4.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls the base class to give members initial values (zeros).
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonWindingTableSsbo::PolygonWindingTableSsbo() :
+    SsboBase(),
+    _bufferSizeBytes(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  Exists to be declared virtual so that the base class' destructor is called
+    upon object death.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+PolygonWindingTableSsbo::~PolygonWindingTableSsbo()
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Generates the SSBO, but does not allocate space for it.  That happens in
+    UpdateValues(...).  Same restrictions as PolygonSsbo::Init().
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonWindingTableSsbo::Init()
+{
+    if (_bufferId == 0)
+    {
+        glGenBuffers(1, &_bufferId);
+    }
+
+    _hasBeenInitialized = true;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Binds the SSBO object (a CPU-side thing) to its corresponding buffer in the shader (GPU).
+Parameters:
+    computeProgramId    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonWindingTableSsbo::ConfigureCompute(unsigned int computeProgramId)
+{
+    if (!_hasBeenInitialized)
+    {
+        fprintf(stderr, "PolygonWindingTableSsbo::ConfigureCompute(...) error: SSBO has not been initialized\n");
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+
+    // see the corresponding area in ParticleSsbo::Init(...) for explanation
+    // Note: MUST use the same binding point
+    GLuint ssboBindingPointIndex = 17;  // not 3, 5, 6, 7, 13, 14, 15, or 16
+    GLuint storageBlockIndex = glGetProgramResourceIndex(computeProgramId, GL_SHADER_STORAGE_BLOCK, "WindingTableBuffer");
+    glShaderStorageBlockBinding(computeProgramId, storageBlockIndex, ssboBindingPointIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ssboBindingPointIndex, _bufferId);
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Does nothing.  The table is never drawn.
+Parameters:
+    renderProgramId     Not used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonWindingTableSsbo::ConfigureRender(unsigned int renderProgramId)
+{
+    // this statement is only to get rid of an "unreferenced parameter" warning
+    (void)renderProgramId;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Uploads the table's header and then its rows right behind it.  The buffer only grows, so 
+    a rebuilt table that is the same size or smaller reuses the existing space.
+
+    Note: The buffer ID doesn't change when the buffer grows, so the binding from
+    ConfigureCompute(...) still holds.
+Parameters:
+    windingTable    Self-explanatory
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void PolygonWindingTableSsbo::UpdateValues(const PolygonWindingTable &windingTable)
+{
+    const std::vector<unsigned int> &data = windingTable.GetData();
+    if (data.empty())
+    {
+        // not built
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _bufferId);
+    unsigned int headerBytes = sizeof(PolygonWindingTableHeader);
+    unsigned int dataBytes = sizeof(unsigned int) * data.size();
+    if ((headerBytes + dataBytes) > _bufferSizeBytes)
+    {
+        _bufferSizeBytes = headerBytes + dataBytes;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _bufferSizeBytes, 0, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, headerBytes, &windingTable.GetHeader());
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, headerBytes, dataBytes, data.data());
+
+    // cleanup
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
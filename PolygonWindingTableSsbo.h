@@ -0,0 +1,28 @@
+#pragma once
+
+#include "SsboBase.h"
+#include "PolygonWindingTable.h"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Encapsulates the SSBO that holds a PolygonWindingTable for the compute shaders (see 
+    polygonWindingTable.glsl).  The table has its own copy of the faces, but it still has to 
+    be built from the same faces as the PolygonSsbo (transformed or not) so that the particles 
+    are checked against what is drawn.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class PolygonWindingTableSsbo : public SsboBase
+{
+public:
+    PolygonWindingTableSsbo();
+    virtual ~PolygonWindingTableSsbo();
+
+    void Init();
+    void ConfigureCompute(unsigned int computeProgramId) override;
+    void ConfigureRender(unsigned int renderProgramId) override;
+
+    void UpdateValues(const PolygonWindingTable &windingTable);
+
+private:
+    unsigned int _bufferSizeBytes;
+};
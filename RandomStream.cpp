@@ -0,0 +1,258 @@
+#include "RandomStream.h"
+
+#include "ParticleRandom.h"     // for the hash
+
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// spreads consecutive counts out over all 32 bits before they are hashed (golden ratio
+// increments; same as ParticleRandom)
+static const unsigned int COUNTER_SPREAD = 2654435769u;
+
+// 2^-24; the top 24 bits of a random number times this is on the range [0,+1), exactly
+static const float INVERSE_2_TO_THE_24 = 1.0f / 16777216.0f;
+
+#if defined(__AVX2__)
+/*-----------------------------------------------------------------------------------------------
+Description:
+    ParticleRandom::PcgHash(...) on 8 numbers at once.
+Parameters:
+    v   8 unsigned ints.
+Returns:
+    8 chaotic unsigned ints.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static inline __m256i PcgHash8(__m256i v)
+{
+    __m256i state = _mm256_add_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32((int)747796405u)),
+        _mm256_set1_epi32((int)2891336453u));
+    __m256i shift = _mm256_add_epi32(_mm256_srli_epi32(state, 28), _mm256_set1_epi32(4));
+    __m256i word = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_srlv_epi32(state, shift), state),
+        _mm256_set1_epi32((int)277803737u));
+    return _mm256_xor_si256(_mm256_srli_epi32(word, 22), word);
+}
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes "count" random floats on the range [0,+1) whose counts' low 32 bits are
+    firstCount, firstCount + 1, etc.  The caller makes sure that the low 32 bits don't wrap
+    around in the middle (that is where the key changes).
+Parameters:
+    pValues     Where to put them.
+    count       How many.
+    key         The key for this block of the stream.
+    firstCount  The low 32 bits of the first one's count.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void FillBlockOnRange0To1(float *pValues, unsigned int count, unsigned int key,
+    unsigned int firstCount)
+{
+    unsigned int valueIndex = 0;
+
+#if defined(__AVX2__)
+    const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i keys = _mm256_set1_epi32((int)key);
+    const __m256i counterSpread = _mm256_set1_epi32((int)COUNTER_SPREAD);
+    const __m256 scale = _mm256_set1_ps(INVERSE_2_TO_THE_24);
+    for (; valueIndex + 8 <= count; valueIndex += 8)
+    {
+        __m256i counts = _mm256_add_epi32(_mm256_set1_epi32((int)(firstCount + valueIndex)),
+            laneOffsets);
+        __m256i hashes = PcgHash8(_mm256_add_epi32(keys, _mm256_mullo_epi32(counts, counterSpread)));
+
+        // the top 24 bits are positive as a signed int, so the signed conversion is fine
+        __m256 values = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(hashes, 8)), scale);
+        _mm256_storeu_ps(pValues + valueIndex, values);
+    }
+#endif
+
+    // whatever didn't fit in a whole SIMD register (or everything, without AVX2)
+    for (; valueIndex < count; valueIndex++)
+    {
+        unsigned int hash = ParticleRandom::PcgHash(key + ((firstCount + valueIndex) * COUNTER_SPREAD));
+        pValues[valueIndex] = (float)(hash >> 8) * INVERSE_2_TO_THE_24;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes the stream's key.  Streams with different seeds or stream indices are unrelated.
+Parameters:
+    seed        Any number.  The same seed gives the same numbers every time the program runs.
+    streamIndex Ex: a thread index, so that each thread gets a different stream from one seed.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+RandomStream::RandomStream(unsigned int seed, unsigned int streamIndex) :
+    _key(ParticleRandom::PcgHash(seed ^ ParticleRandom::PcgHash(streamIndex))),
+    _counter(0)
+{
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Jumps ahead in the stream as if "count" numbers had been taken out of it.  This is only an
+    addition.
+Parameters:
+    count   Self-explanatory.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void RandomStream::Skip(unsigned long long count)
+{
+    _counter += count;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Getter.
+Parameters: None
+Returns:
+    How many numbers have been taken out of (or skipped in) the stream so far.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned long long RandomStream::Position() const
+{
+    return _counter;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the next number out of the stream.
+Parameters: None
+Returns:
+    A random unsigned int.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int RandomStream::NextUint()
+{
+    unsigned int key = BlockKey((unsigned int)(_counter >> 32));
+    unsigned int hash = ParticleRandom::PcgHash(key + ((unsigned int)_counter * COUNTER_SPREAD));
+    _counter++;
+    return hash;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the next number out of the stream as a float.
+Parameters: None
+Returns:
+    A random float on the range [0,+1).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float RandomStream::NextOnRange0To1()
+{
+    return (float)(NextUint() >> 8) * INVERSE_2_TO_THE_24;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the next "count" numbers out of the stream as floats.  Same numbers as calling
+    NextOnRange0To1() "count" times, only faster.
+Parameters:
+    pValues     Where to put them.
+    count       How many.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void RandomStream::FillOnRange0To1(float *pValues, unsigned int count)
+{
+    // the key changes every 2^32 numbers, so split the fill where that happens
+    unsigned int valueIndex = 0;
+    while (valueIndex < count)
+    {
+        unsigned int firstCount = (unsigned int)_counter;
+        unsigned long long untilNextBlock = 0x100000000ull - firstCount;
+        unsigned int blockCount = count - valueIndex;
+        if (untilNextBlock < blockCount)
+        {
+            blockCount = (unsigned int)untilNextBlock;
+        }
+
+        FillBlockOnRange0To1(pValues + valueIndex, blockCount,
+            BlockKey((unsigned int)(_counter >> 32)), firstCount);
+        valueIndex += blockCount;
+        _counter += blockCount;
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Like FillOnRange0To1(...), but on the range [min, min + delta).  Ex: velocity magnitudes
+    (see MinMaxVelocity).
+Parameters:
+    pValues     Where to put them.
+    count       How many.
+    min         The smallest value.
+    delta       The size of the range.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void RandomStream::FillBetween(float *pValues, unsigned int count, float min, float delta)
+{
+    FillOnRange0To1(pValues, count);
+
+    // simple enough for the compiler to vectorize by itself
+    for (unsigned int valueIndex = 0; valueIndex < count; valueIndex++)
+    {
+        pValues[valueIndex] = min + (pValues[valueIndex] * delta);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Fills an array with random 2D directions (normalized).  Each takes two numbers out of the
+    stream.
+
+    Like the emitters, this normalizes a random point in the [-1,+1] square instead of picking
+    a random angle, so the diagonals come up a little more often than the axes.  That's fine
+    for particles, and it avoids sin(...) and cos(...).
+Parameters:
+    pDirections     Where to put them.
+    count           How many.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void RandomStream::FillDirections(glm::vec2 *pDirections, unsigned int count)
+{
+    // a glm::vec2 is just two floats, so fill all of the X's and Y's at once
+    float *pValues = &pDirections[0].x;
+    FillOnRange0To1(pValues, 2 * count);
+
+    for (unsigned int directionIndex = 0; directionIndex < count; directionIndex++)
+    {
+        float x = (2.0f * pValues[(2 * directionIndex) + 0]) - 1.0f;
+        float y = (2.0f * pValues[(2 * directionIndex) + 1]) - 1.0f;
+
+        // (0,0) has no direction, so use X instead (it comes up once in 2^48 tries)
+        float lengthSquared = (x * x) + (y * y);
+        if (lengthSquared == 0.0f)
+        {
+            x = 1.0f;
+            lengthSquared = 1.0f;
+        }
+
+        float inverseLength = 1.0f / sqrtf(lengthSquared);
+        pDirections[directionIndex] = glm::vec2(x * inverseLength, y * inverseLength);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The counter is 64bit, but the hash is 32bit, so every 2^32 numbers ("block") get their own
+    key.
+Parameters:
+    block   The high 32 bits of the counter.
+Returns:
+    The block's key.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int RandomStream::BlockKey(unsigned int block) const
+{
+    return ParticleRandom::PcgHash(_key ^ ParticleRandom::PcgHash(block));
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "glm/vec2.hpp"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A stream of random numbers that belongs to whoever made it.  This replaces RandomToast,
+    whose xorshf96 generator kept its state in globals, so nothing that used it could run on
+    more than one thread at a time.
+
+    The numbers are counter-based, like ParticleRandom: number N in the stream is a hash of the
+    stream's key and N.  That means:
+    - There is no state that streams share, so every thread can have its own stream (ex: one
+    per ThreadPool thread index) and none of them need locks.
+    - Jumping ahead is free (see Skip(...)).  Threads can also split one stream between them by
+    each skipping to their own part of it.
+    - Each number doesn't depend on the one before it, so the Fill...(...) functions make 8 at
+    a time with SIMD (AVX2) when the compiler is allowed to use it (/arch:AVX2 in Visual
+    Studio, which the x64 configurations use).  Otherwise they make them one at a time, and the numbers are the same either way.
+
+    The counter is 64bit, so a stream won't repeat itself in any reasonable amount of time.
+
+    Note: A stream is not thread safe itself.  Give each thread its own.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class RandomStream
+{
+public:
+    RandomStream(unsigned int seed = 0, unsigned int streamIndex = 0);
+
+    void Skip(unsigned long long count);
+    unsigned long long Position() const;
+
+    unsigned int NextUint();
+    float NextOnRange0To1();
+
+    void FillOnRange0To1(float *pValues, unsigned int count);
+    void FillBetween(float *pValues, unsigned int count, float min, float delta);
+    void FillDirections(glm::vec2 *pDirections, unsigned int count);
+
+private:
+    unsigned int BlockKey(unsigned int block) const;
+
+    unsigned int _key;
+    unsigned long long _counter;
+};
@@ -122,22 +122,89 @@ void ShaderStorage::DeleteProgram(const std::string &programKey)
     }
 }
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Reads a shader file into a string and pastes in the contents of any file named by an
+    '#include "fileName"' line.  GLSL has no #include of its own, and this lets multiple 
+    shaders share one copy of something like the particle layout (particleLayout.glsl).  
+    
+    Included files are looked up in the same way as the shader file (relative to the program or 
+    an absolute path) and can include other files.
+
+    Prints its own errors to stderr.
+Parameters:
+    filePath        Can be relative to program or an absolute path.
+    includeDepth    Guards against files that include each other.  Start at 0.
+Returns:
+    The file contents with includes expanded, or an empty string if the file couldn't be read.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static std::string ReadShaderFileWithIncludes(const std::string &filePath, int includeDepth)
+{
+    static const int MAX_INCLUDE_DEPTH = 8;
+    if (includeDepth > MAX_INCLUDE_DEPTH)
+    {
+        fprintf(stderr, "Shader file '%s' is included too deep; circular #include?\n",
+            filePath.c_str());
+        return std::string();
+    }
+
+    std::ifstream shaderFile(filePath);
+    std::string expandedContents;
+    std::string line;
+    while (std::getline(shaderFile, line))
+    {
+        // only a line that starts with #include "..." is expanded; anything else (including 
+        // commented-out includes) is left alone
+        const std::string includeDirective = "#include \"";
+        size_t nameEnd = line.find('"', includeDirective.length());
+        if (line.compare(0, includeDirective.length(), includeDirective) == 0 && 
+            nameEnd != std::string::npos)
+        {
+            std::string includePath = line.substr(includeDirective.length(), 
+                nameEnd - includeDirective.length());
+            std::string includeContents = ReadShaderFileWithIncludes(includePath, 
+                includeDepth + 1);
+            if (includeContents.length() == 0)
+            {
+                fprintf(stderr, "Shader file '%s' could not include '%s'\n", filePath.c_str(), 
+                    includePath.c_str());
+            }
+            expandedContents += includeContents;
+        }
+        else
+        {
+            expandedContents += line;
+            expandedContents += '\n';
+        }
+    }
+    shaderFile.close();
+
+    return expandedContents;
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Reads the specified file and attempts to compile it into the specified shader type.  Stores
     the binary in a collection of binaries under the specified key.
 
+    Files can #include other files (see ReadShaderFileWithIncludes(...)) and can be given extra 
+    #defines so that the same file can be built differently (ex: for different particle 
+    layouts).
+
     Prints its own errors to stderr.  The APIENTRY debug function doesn't report shader compile
     errors.
 Parameters:
-    programKey  Must have already been created by NewShader.
-    filePath    Can be relative to program or an absolute path.
-    shaderType  GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, etc.
+    programKey      Must have already been created by NewShader.
+    filePath        Can be relative to program or an absolute path.
+    shaderType      GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, etc.
+    shaderDefines   Optional.  Lines of "#define ..." that are inserted right after the 
+                    "#version" line (GLSL requires #version to come first).
 Returns:    None
 Creator:    John Cox (7-14-2016)
 -----------------------------------------------------------------------------------------------*/
 void ShaderStorage::AddShaderFile(const std::string &programKey, const std::string &filePath,
-    const GLenum shaderType)
+    const GLenum shaderType, const std::string &shaderDefines)
 {
     if (_shaderBinaries.find(programKey) == _shaderBinaries.end())
     {
@@ -146,11 +213,7 @@ void ShaderStorage::AddShaderFile(const std::string &programKey, const std::stri
         return;
     }
 
-    std::ifstream shaderFile(filePath);
-    std::stringstream shaderData;
-    shaderData << shaderFile.rdbuf();
-    shaderFile.close();
-    std::string fileContents = shaderData.str();
+    std::string fileContents = ReadShaderFileWithIncludes(filePath, 0);
 
     if (fileContents.length() == 0)
     {
@@ -158,6 +221,20 @@ void ShaderStorage::AddShaderFile(const std::string &programKey, const std::stri
         return;
     }
 
+    if (shaderDefines.length() > 0)
+    {
+        size_t versionStart = fileContents.find("#version");
+        size_t versionLineEnd = (versionStart == std::string::npos) ? 
+            std::string::npos : fileContents.find('\n', versionStart);
+        if (versionLineEnd == std::string::npos)
+        {
+            fprintf(stderr, "Shader file '%s' has no #version line for the defines to follow\n", 
+                filePath.c_str());
+            return;
+        }
+        fileContents.insert(versionLineEnd + 1, shaderDefines);
+    }
+
     // OpenGL takes pointers to file contents and pointers to file content lengths, so use arrays
     const GLchar *bytes[] = { fileContents.c_str() };
     const GLint strLengths[] = { (int)fileContents.length() };
@@ -26,7 +26,7 @@ public:
     void DeleteProgram(const std::string &programKey);
 
     void AddShaderFile(const std::string &programKey, const std::string &filePath,
-        const GLenum shaderType);
+        const GLenum shaderType, const std::string &shaderDefines = "");
     GLuint LinkShader(const std::string &programKey);
     GLuint GetShaderProgram(const std::string &programKey) const;
     GLint GetUniformLocation(const std::string &programKey,
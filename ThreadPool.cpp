@@ -0,0 +1,254 @@
+#include "ThreadPool.h"
+
+// most desktop CPUs have at least this much L2 cache per core, so a chunk this big should stay
+// in cache while a thread works on it without being so small that the queue overhead matters
+static const unsigned int CACHE_SIZED_CHUNK_BYTES = 128 * 1024;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Starts up the worker threads.  The calling thread also works during ParallelFor(...), so
+    "num threads - 1" threads are created.
+Parameters:
+    numThreads  The total number of threads to work with.  If 0, then the number of hardware
+                threads is used.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ThreadPool::ThreadPool(unsigned int numThreads) :
+    _pCurrentFunc(0),
+    _jobGeneration(0),
+    _workersBusy(0),
+    _quit(false)
+{
+    if (numThreads == 0)
+    {
+        // may return 0 if it can't tell
+        numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+        {
+            numThreads = 1;
+        }
+    }
+
+    for (unsigned int threadIndex = 0; threadIndex < numThreads; threadIndex++)
+    {
+        _queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+
+    // thread 0 is the calling thread
+    for (unsigned int threadIndex = 1; threadIndex < numThreads; threadIndex++)
+    {
+        _workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, threadIndex));
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Tells the worker threads to quit and waits for them.
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_jobLock);
+        _quit = true;
+    }
+    _jobStart.notify_all();
+
+    for (size_t workerIndex = 0; workerIndex < _workers.size(); workerIndex++)
+    {
+        _workers[workerIndex].join();
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A simple getter for the number of threads that work on a ParallelFor(...), including the
+    calling thread.  Callers use this to size their per-thread result slots.
+Parameters: None
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ThreadPool::NumThreads() const
+{
+    return (unsigned int)_queues.size();
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calls "func" on every chunk of the range [0, numItems) across all threads and returns once
+    every chunk is done.
+
+    Chunks are dealt out in contiguous runs (thread 0 gets the first run, thread 1 the next,
+    etc.) so that, if nothing is stolen, each thread walks through memory in order.
+Parameters:
+    numItems        The number of items to split up.
+    itemsPerChunk   How many items each call to "func" gets (the last chunk may be smaller).
+    func            Called as func(begin, end, threadIndex).  Must be safe to run on different
+                    chunks at the same time.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ThreadPool::ParallelFor(unsigned int numItems, unsigned int itemsPerChunk,
+    const RANGE_FUNC &func)
+{
+    if (numItems == 0)
+    {
+        return;
+    }
+    if (itemsPerChunk == 0)
+    {
+        itemsPerChunk = 1;
+    }
+
+    unsigned int numChunks = ((numItems - 1) / itemsPerChunk) + 1;
+    unsigned int numThreads = NumThreads();
+    if (numThreads == 1 || numChunks == 1)
+    {
+        // not worth waking anyone up
+        func(0, numItems, 0);
+        return;
+    }
+
+    // the workers are all asleep, so the queues can be filled without locking them
+    unsigned int chunksPerThread = ((numChunks - 1) / numThreads) + 1;
+    for (unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        ChunkRange chunk;
+        chunk._begin = chunkIndex * itemsPerChunk;
+        chunk._end = (chunk._begin + itemsPerChunk < numItems) ?
+            (chunk._begin + itemsPerChunk) : numItems;
+        _queues[chunkIndex / chunksPerThread]->_chunks.push_back(chunk);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_jobLock);
+        _pCurrentFunc = &func;
+        _workersBusy = (unsigned int)_workers.size();
+        _jobGeneration++;
+    }
+    _jobStart.notify_all();
+
+    // pitch in
+    RunChunks(0);
+
+    // wait for the workers to finish before "func" goes out of scope
+    std::unique_lock<std::mutex> lock(_jobLock);
+    _jobDone.wait(lock, [this]() { return _workersBusy == 0; });
+    _pCurrentFunc = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Calculates how many items of the given size fill a cache-sized chunk.  The result is
+    rounded down to a multiple of 8 so that chunk boundaries line up with the SIMD batches in
+    the CPU particle passes.
+Parameters:
+    bytesPerItem    Self-explanatory.
+Returns:
+    See description.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+unsigned int ThreadPool::ItemsPerCacheSizedChunk(unsigned int bytesPerItem)
+{
+    unsigned int numItems = (CACHE_SIZED_CHUNK_BYTES / bytesPerItem) & ~7u;
+    return (numItems > 0) ? numItems : 8;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Takes the next chunk from this thread's own queue (front), or failing that, steals one from
+    the far end of another thread's queue (back).  Threads are checked in order starting with the next one
+    over so that the thieves don't all gang up on thread 0.
+Parameters:
+    threadIndex     The thread that is looking for work.
+    pChunk          Receives the chunk.
+Returns:
+    True if a chunk was found, otherwise false (all queues are empty).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool ThreadPool::PopOrSteal(unsigned int threadIndex, ChunkRange *pChunk)
+{
+    {
+        WorkQueue &ownQueue = *_queues[threadIndex];
+        std::lock_guard<std::mutex> lock(ownQueue._lock);
+        if (!ownQueue._chunks.empty())
+        {
+            *pChunk = ownQueue._chunks.front();
+            ownQueue._chunks.pop_front();
+            return true;
+        }
+    }
+
+    unsigned int numThreads = NumThreads();
+    for (unsigned int offset = 1; offset < numThreads; offset++)
+    {
+        WorkQueue &victimQueue = *_queues[(threadIndex + offset) % numThreads];
+        std::lock_guard<std::mutex> lock(victimQueue._lock);
+        if (!victimQueue._chunks.empty())
+        {
+            *pChunk = victimQueue._chunks.back();
+            victimQueue._chunks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Runs chunks of the current job until there are none left to pop or steal.
+Parameters:
+    threadIndex     The thread that is doing the work.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ThreadPool::RunChunks(unsigned int threadIndex)
+{
+    ChunkRange chunk;
+    while (PopOrSteal(threadIndex, &chunk))
+    {
+        (*_pCurrentFunc)(chunk._begin, chunk._end, threadIndex);
+    }
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The worker threads' main function.  Sleeps until a job starts, works on it, reports that
+    it is done, and goes back to sleep.
+Parameters:
+    threadIndex     Which queue belongs to this thread.
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void ThreadPool::WorkerLoop(unsigned int threadIndex)
+{
+    unsigned int lastGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_jobLock);
+            _jobStart.wait(lock, [this, lastGeneration]()
+            {
+                return _quit || (_jobGeneration != lastGeneration);
+            });
+            if (_quit)
+            {
+                return;
+            }
+            lastGeneration = _jobGeneration;
+        }
+
+        RunChunks(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(_jobLock);
+            _workersBusy--;
+        }
+        _jobDone.notify_one();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A small fork-join thread pool for running the CPU particle passes across all host cores.
+
+    ParallelFor(...) splits a range of items into chunks, deals the chunks out in contiguous
+    runs to one queue per thread, and then every thread (including the calling thread) works
+    through its own queue from the front.  When a thread runs out of work, it steals chunks from
+    the back of another thread's queue.  That keeps neighboring chunks on the same thread for
+    as long as possible and still balances the load when some chunks take longer than others
+    (ex: chunks full of inactive particles finish almost immediately).
+
+    Note: The callback is told which thread it is running on.  Callers use that to accumulate
+    results in per-thread slots (see PerThreadCounter) and then merge them after
+    ParallelFor(...) returns, which avoids having every chunk hit the same atomic.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+class ThreadPool
+{
+public:
+    // arguments: first item, one past the last item, thread index
+    typedef std::function<void(unsigned int, unsigned int, unsigned int)> RANGE_FUNC;
+
+    ThreadPool(unsigned int numThreads = 0);
+    ~ThreadPool();
+
+    unsigned int NumThreads() const;
+    void ParallelFor(unsigned int numItems, unsigned int itemsPerChunk, const RANGE_FUNC &func);
+
+    static unsigned int ItemsPerCacheSizedChunk(unsigned int bytesPerItem);
+
+private:
+    // copying a pool of threads doesn't make sense
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    struct ChunkRange
+    {
+        unsigned int _begin;
+        unsigned int _end;
+    };
+
+    // each thread gets its own queue and its own lock so that threads only contend with each
+    // other while stealing
+    struct WorkQueue
+    {
+        std::mutex _lock;
+        std::deque<ChunkRange> _chunks;
+    };
+
+    bool PopOrSteal(unsigned int threadIndex, ChunkRange *pChunk);
+    void RunChunks(unsigned int threadIndex);
+    void WorkerLoop(unsigned int threadIndex);
+
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+
+    // job state
+    const RANGE_FUNC *_pCurrentFunc;
+    std::mutex _jobLock;
+    std::condition_variable _jobStart;
+    std::condition_variable _jobDone;
+    unsigned int _jobGeneration;
+    unsigned int _workersBusy;
+    bool _quit;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A counter that fills a whole cache line so that threads incrementing neighboring counters
+    don't fight over the same line (false sharing).
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct PerThreadCounter
+{
+    PerThreadCounter() :
+        _count(0)
+    {
+    }
+
+    unsigned int _count;
+    char _padding[64 - sizeof(unsigned int)];
+};
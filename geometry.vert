@@ -1,17 +1,25 @@
 #version 440
 
 // this should already be transformed because it is pre-transformed for the compute shader 
+// (unless GPU_TRANSFORMS is defined; then the faces are uploaded untransformed and moved here)
 layout (location = 0) in vec2 pos;
 
+#ifdef GPU_TRANSFORMS
+uniform mat4 transformMatrixWindowSpace;
+#else
 // keep this around in case it's needed later
 //uniform mat4 transformMatrixWindowSpace;
+#endif
 
 void main()
 {
     // nothing special here except the Z value
     // Note: See explanation for alpha blending in Init() in main.cpp.
     vec4 p = vec4(pos, -0.8f, 1.0f);
+#ifdef GPU_TRANSFORMS
+    gl_Position = transformMatrixWindowSpace * p;
+#else
     //gl_Position = transformMatrixWindowSpace * p;
     gl_Position = p;
+#endif
 }
-
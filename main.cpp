@@ -43,10 +43,36 @@
 // for particles, where they live, and how to update them
 #include "glm/vec2.hpp"
 #include "ParticleSsbo.h"
+#include "ParticleDeadListSsbo.h"
+#include "ParticleDrawListSsbo.h"
 #include "PolygonSsbo.h"
+#include "PolygonFaceGrid.h"
+#include "PolygonFaceGridSsbo.h"
+#include "PolygonDistanceField.h"
+#include "PolygonDistanceFieldSsbo.h"
+#include "PolygonWindingTable.h"
+#include "PolygonWindingTableSsbo.h"
 #include "ParticlePolygonRegion.h"
 #include "ComputeParticleReset.h"
 #include "ComputeParticleUpdate.h"
+#include "ComputeParticleResetAndUpdate.h"
+#include "ComputeParticleResetAndUpdateBenchmark.h"
+#include "ComputeParticleCountBenchmark.h"
+#include "ComputeParticleLayoutBenchmark.h"
+#include "ComputeFaceTileBenchmark.h"
+#include "ComputePrimitives.h"
+#include "ComputePrimitivesBenchmark.h"
+#include "ComputeParticleCollisions.h"
+#include "ComputeParticleCollisionBenchmark.h"
+#include "ComputeParticleSort.h"
+#include "ComputeParticleSortBenchmark.h"
+#include "ComputeParticleLiveList.h"
+#include "ComputeParticleRandomCheck.h"
+#include "CpuParticleReset.h"
+#include "CpuParticleUpdate.h"
+#include "CpuPolygonBoundaryBenchmark.h"
+#include "ParticleQuantizationCheck.h"
+#include "ThreadPool.h"
 
 // for moving the shapes around in window space
 #include "glm/gtc/matrix_transform.hpp"
@@ -56,6 +82,9 @@
 #include "FreeTypeEncapsulated.h"
 #include "Stopwatch.h"
 
+// the simulation moves in fixed steps of real time, however many fit in each frame
+#include "FixedTimestepScheduler.h"
+
 Stopwatch gTimer;
 FreeTypeEncapsulated gTextAtlases;
 
@@ -65,7 +94,16 @@ GLint gUnifLocGeometryTransform;
 
 // ??stored in scene??
 ParticleSsbo gParticleBuffer;
+ParticleDeadListSsbo gParticleDeadListBuffer;
+ParticleDrawListSsbo gParticleDrawListBuffer;
 PolygonSsbo gPolygonFaceBuffer;
+PolygonFaceGrid gPolygonFaceGrid;
+PolygonFaceGridSsbo gPolygonFaceGridBuffer;
+PolygonDistanceField gPolygonDistanceField;
+PolygonDistanceFieldSsbo gPolygonDistanceFieldBuffer;
+PolygonWindingTable gPolygonWindingTable;
+PolygonWindingTableSsbo gPolygonWindingTableBuffer;
+bool gUsePolygonWindingTest = false;
 ParticleRegionPolygon *gpPolygonRegion = 0;
 
 //// in a bigger program, this would somehow be encapsulated and associated with both the circle
@@ -83,6 +121,47 @@ IParticleEmitter *gpParticleEmitterBar3 = 0;
 IParticleEmitter *gpParticleEmitterBar4 = 0;
 ComputeParticleReset *gpParticleReseter = 0;
 ComputeParticleUpdate *gpParticleUpdater = 0;
+ComputeParticleResetAndUpdate *gpParticleResetAndUpdater = 0;
+CpuParticleReset *gpCpuParticleReseter = 0;
+CpuParticleUpdate *gpCpuParticleUpdater = 0;
+ComputeParticleCountBenchmark *gpParticleCountBenchmark = 0;
+ComputeParticleLayoutBenchmark *gpParticleLayoutBenchmark = 0;
+ComputeFaceTileBenchmark *gpFaceTileBenchmark = 0;
+ComputePrimitives *gpComputePrimitives = 0;
+ComputeParticleCollisions *gpParticleCollisions = 0;
+ComputeParticleSort *gpParticleSort = 0;
+ComputeParticleSortBenchmark *gpParticleSortBenchmark = 0;
+ComputeParticleLiveList *gpParticleLiveList = 0;
+ThreadPool *gpThreadPool = 0;
+
+// enable these to reset and/or update particles on the CPU (spread across all cores) instead of 
+// with the compute shaders
+//#define USE_CPU_PARTICLE_RESET
+//#define USE_CPU_PARTICLE_UPDATE
+
+// enable this to reset and update particles in a single compute shader pass that reads and 
+// writes each particle at most once per frame (see ComputeParticleResetAndUpdate) instead of 
+// separate reset and update passes
+//#define USE_FUSED_PARTICLE_RESET_AND_UPDATE
+#if defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE) && (defined(USE_CPU_PARTICLE_RESET) || defined(USE_CPU_PARTICLE_UPDATE))
+#error "The fused particle reset and update can't be mixed with the CPU particle reset or update"
+#endif
+
+// the particle reset shader only visits the particles that it resets by taking them off of a 
+// list of inactive particles that the update shader keeps (see ParticleDeadListSsbo)
+// Note: The list is only kept if both happen on the GPU in separate passes.  The fused pass 
+// visits every particle anyway.
+#if !defined(USE_CPU_PARTICLE_RESET) && !defined(USE_CPU_PARTICLE_UPDATE) && !defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE)
+#define USE_PARTICLE_DEAD_LIST
+#endif
+
+// the update shader lists the particles that are still active, and only those are drawn (with 
+// an indirect draw, so the CPU never reads the count; see ParticleDrawListSsbo)
+// Note: The list is only kept if the update happens on the GPU.  Otherwise every particle is 
+// drawn and the inactive ones are transparent.
+#if !defined(USE_CPU_PARTICLE_UPDATE)
+#define USE_PARTICLE_DRAW_LIST
+#endif
 
 // divide between the circle and the polygon regions
 // Note: 
@@ -90,6 +169,158 @@ ComputeParticleUpdate *gpParticleUpdater = 0;
 // - 15,000 particles => 30-40 fps on my computer
 const unsigned int MAX_PARTICLE_COUNT = 100000;
 
+// the simulation takes steps of this much time, and as many of them per frame as it takes to 
+// keep up with real time (see FixedTimestepScheduler)
+const float SIMULATION_STEP_SEC = 0.01f;
+
+// the spiral of death guard: a frame that took longer than this many steps' worth of time 
+// only runs this many, and the simulation falls behind real time instead of taking ever 
+// longer to catch up
+const unsigned int MAX_SIMULATION_STEPS_PER_FRAME = 8;
+
+// how fast each emitter spawns particles, in simulated time
+// Note: 2000 per second is 20 per step, which was the old "20 per frame" with a frame of 0.01 
+// seconds.  With this particle region and the emitters' min-max spawn velocities, that 
+// stabilizes at ~45,000 active particles in one moment.
+const float PARTICLES_PER_EMITTER_PER_SEC = 2000.0f;
+
+FixedTimestepScheduler gSimulationScheduler(SIMULATION_STEP_SEC, MAX_SIMULATION_STEPS_PER_FRAME);
+
+// how the particles are arranged in the particle SSBO (see ParticleLayout.h); the shaders and 
+// the CPU particle reset/update are all built to match
+// Note: PARTICLE_LAYOUT_COMPACT_2D and PARTICLE_LAYOUT_QUANTIZED_2D move the least memory per 
+// frame, but they drop the Z and W of position and velocity, so only use them while 
+// everything stays in 2D.  The quantized layout also stores positions relative to the 
+// particle region's bounding box, so the region must not move after startup.
+const ParticleLayout PARTICLE_LAYOUT = PARTICLE_LAYOUT_AOS;
+
+// enable this to upload the polygon faces and the emitters once, untransformed, and give the 
+// compute shaders only the transforms each frame (see ComputeParticleUpdate::
+// SetRegionTransform(...)) instead of transforming them on the CPU and uploading them again
+// Note: The CPU particle reset and update need the CPU-transformed faces and emitters.
+//#define USE_GPU_TRANSFORMS
+#if defined(USE_GPU_TRANSFORMS) && (defined(USE_CPU_PARTICLE_RESET) || defined(USE_CPU_PARTICLE_UPDATE))
+#error "GPU transforms can't be mixed with the CPU particle reset or update"
+#endif
+
+// enable this to check each particle against only the polygon faces near it (see 
+// PolygonFaceGrid) instead of every face, in both the compute shaders and the CPU update
+// Note: The demo's region only has a handful of faces, so this is for regions with hundreds 
+// or thousands of them.  The grid is rebuilt whenever the faces move.
+//#define USE_POLYGON_FACE_GRID
+
+// enable this to have the compute shaders take one sample of a signed distance field (see 
+// PolygonDistanceField) instead of checking polygon faces, so the cost doesn't depend on the 
+// number of faces at all
+// Note: The texels per side trade memory and baking time for accuracy near the corners.  The 
+// CPU update still checks faces.
+//#define USE_POLYGON_DISTANCE_FIELD
+const unsigned int POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE = 256;
+#if defined(USE_POLYGON_DISTANCE_FIELD) && defined(USE_POLYGON_FACE_GRID)
+#error "The polygon distance field replaces the face grid; enable only one of them"
+#endif
+
+// enable this to have each work group of the update shader read the polygon faces into shared 
+// memory one tile at a time and check all of its particles against each tile (see 
+// polygonFaceTiles.glsl) instead of every particle reading every face itself
+// Note: Like the face grid, this is for regions with lots of faces.  It is a different way of 
+// checking every face, so it can't be mixed with the ways that check fewer of them.
+//#define USE_SHARED_MEMORY_FACE_TILES
+#if defined(USE_SHARED_MEMORY_FACE_TILES) && (defined(USE_POLYGON_FACE_GRID) || defined(USE_POLYGON_DISTANCE_FIELD))
+#error "Shared memory face tiles can't be mixed with the face grid or the distance field"
+#endif
+#if defined(USE_SHARED_MEMORY_FACE_TILES) && (defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE) || defined(USE_CPU_PARTICLE_UPDATE))
+#error "Shared memory face tiles are only in the separate particle update shader"
+#endif
+
+// enable this to support regions that aren't a single convex loop of faces (concave regions, 
+// holes; see ParticleRegionPolygon::IsConvex()) with a winding number test that only looks at 
+// the faces in the particle's row (see PolygonWindingTable), in both the compute shaders and 
+// the CPU update
+// Note: Convex regions still use the per-face check, which is cheaper for a handful of faces.
+// The table is rebuilt whenever the faces move.
+//#define USE_POLYGON_WINDING_TEST
+#if defined(USE_POLYGON_WINDING_TEST) && (defined(USE_POLYGON_FACE_GRID) || defined(USE_POLYGON_DISTANCE_FIELD) || defined(USE_SHARED_MEMORY_FACE_TILES))
+#error "The polygon winding test can't be mixed with the face grid, the distance field, or face tiles"
+#endif
+
+// enable this to cut a hole in the middle of the demo's region (see GeneratePolygonRegion(...))
+//#define USE_POLYGON_REGION_WITH_HOLE
+#if defined(USE_POLYGON_REGION_WITH_HOLE) && !defined(USE_POLYGON_WINDING_TEST)
+#error "A region with a hole needs the polygon winding test"
+#endif
+
+// enable this to time (once per second) the update shader's particle reads and writes with 
+// every particle layout, given the particles' current state, along with the bytes moved per 
+// particle and the bandwidth that comes to (see ComputeParticleLayoutBenchmark)
+//#define BENCHMARK_PARTICLE_LAYOUTS
+
+// enable this to time (once, at startup) a frame of the separate particle reset and update 
+// passes vs. the fused pass on the same particles (see 
+// ComputeParticleResetAndUpdateBenchmark)
+//#define BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+
+// enable this to check (once, at startup) that PARTICLE_LAYOUT_QUANTIZED_2D stays within its 
+// error budget compared to the float layouts
+//#define CHECK_QUANTIZATION_ERROR_BUDGET
+
+// enable this to check (once, at startup) that the GPU's random numbers match the CPU's bit 
+// for bit for a handful of (frame, emitter, particle) keys (see ComputeParticleRandomCheck)
+//#define CHECK_PARTICLE_RANDOM
+
+// enable this to time (once per second) the counting of active particles with one atomic 
+// counter operation per particle vs. one per work group (see ComputeParticleCountBenchmark)
+//#define BENCHMARK_PARTICLE_COUNTERS
+
+// enable this to time (once, a few seconds in) the GPU boundary test for regions with more 
+// and more faces: every particle reading every face vs. shared memory face tiles vs. the 
+// distance field (see ComputeFaceTileBenchmark)
+//#define BENCHMARK_FACE_TILES
+
+// enable this to time (once, at startup) the CPU boundary test for regions with more and more 
+// faces: checking every face vs. the face grid vs. the distance field vs. the winding table 
+// (see CpuPolygonBoundaryBenchmark)
+//#define BENCHMARK_POLYGON_BOUNDARY_TESTS
+
+// enable this to bounce active particles off of each other on the GPU after every update (see 
+// ComputeParticleCollisions)
+//#define USE_PARTICLE_COLLISIONS
+
+// particles are circles this big (in window space) as far as collisions are concerned
+const float PARTICLE_COLLISION_RADIUS = 0.005f;
+
+// enable this to time (once, at startup) the particle collisions' build and query for 1024 up 
+// to a million particles and check them against the brute force (see 
+// ComputeParticleCollisionBenchmark)
+//#define BENCHMARK_PARTICLE_COLLISIONS
+
+// enable this to re-sort the particle buffer into Z (Morton) order every so often so that 
+// particles that are near each other in the region are near each other in memory (see 
+// ComputeParticleSort)
+//#define USE_PARTICLE_SORT
+
+// particles only drift a little each frame, so the order stays good for a while
+const unsigned int PARTICLE_SORT_INTERVAL_FRAMES = 60;
+
+// enable this to measure (once, a few seconds in) the memory traffic of a neighbor query 
+// before and after a sort (see ComputeParticleSortBenchmark)
+//#define BENCHMARK_PARTICLE_SORT
+#if defined(BENCHMARK_PARTICLE_SORT) && !defined(USE_PARTICLE_SORT)
+#error "The particle sort benchmark needs the particle sort"
+#endif
+
+// enable this to keep a dense list of the active particles (compacted after every update) and 
+// only summon the update shader for them instead of for every particle in the buffer (see 
+// ComputeParticleLiveList)
+//#define USE_PARTICLE_LIVE_LIST
+#if defined(USE_PARTICLE_LIVE_LIST) && !defined(USE_PARTICLE_DEAD_LIST)
+#error "The live particle list needs the separate GPU particle reset and update"
+#endif
+
+// enable this to check the GPU scan, compaction, and sort against the CPU and time them on 1 
+// thousand up to 100 million elements (once, at startup; see ComputePrimitivesBenchmark)
+//#define BENCHMARK_COMPUTE_PRIMITIVES
+
 
 
 /*-----------------------------------------------------------------------------------------------
@@ -114,6 +345,10 @@ Description:
     - vec2(+0.25f, -0.5f);
     - vec2(+0.5f, +0.25f);
     - vec2(-0.5f, +0.25f);
+
+    With USE_POLYGON_REGION_WITH_HOLE, a square hole is cut out of the middle (between the 
+    emitters).  The hole's faces go clockwise so that their normals point into the hole, which 
+    is out of the region.
 Parameters:
     polygonFaceCollection   A pointer to the structure that needs to be filled out.
 Returns:    None
@@ -138,9 +373,78 @@ static void GeneratePolygonRegion(std::vector<PolygonFace> *polygonFaceCollectio
     polygonFaceCollection->push_back(face2);
     polygonFaceCollection->push_back(face3);
     polygonFaceCollection->push_back(face4);
+
+#ifdef USE_POLYGON_REGION_WITH_HOLE
+    glm::vec2 h1(-0.15f, -0.25f);
+    glm::vec2 h2(-0.15f, +0.05f);
+    glm::vec2 h3(+0.15f, +0.05f);
+    glm::vec2 h4(+0.15f, -0.25f);
+    glm::vec2 hn1(glm::normalize(RotateNeg90(h2 - h1)));
+    glm::vec2 hn2(glm::normalize(RotateNeg90(h3 - h2)));
+    glm::vec2 hn3(glm::normalize(RotateNeg90(h4 - h3)));
+    glm::vec2 hn4(glm::normalize(RotateNeg90(h1 - h4)));
+    polygonFaceCollection->push_back(PolygonFace(MyVertex(h1, hn1), MyVertex(h2, hn1)));
+    polygonFaceCollection->push_back(PolygonFace(MyVertex(h2, hn2), MyVertex(h3, hn2)));
+    polygonFaceCollection->push_back(PolygonFace(MyVertex(h3, hn3), MyVertex(h4, hn3)));
+    polygonFaceCollection->push_back(PolygonFace(MyVertex(h4, hn4), MyVertex(h1, hn4)));
+#endif
 }
 
 
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Maps the particle SSBO into system memory so that the CPU particle reset and update can work 
+    on it directly.  Must be followed by UnmapParticleBuffer() before any shader uses the buffer 
+    again.
+Parameters: None
+Returns:
+    A pointer to the start of the particle buffer.  The particles are arranged according to 
+    gParticleBuffer.GetLayoutInfo().
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void *MapParticleBuffer()
+{
+    // make sure that any compute shader writes are visible to the mapped pointer
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gParticleBuffer.BufferId());
+    void *pMappedParticles = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, 
+        gParticleBuffer.GetLayoutInfo().BufferSizeBytes(), GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return pMappedParticles;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Gives the particle SSBO back to OpenGL after MapParticleBuffer().
+Parameters: None
+Returns:    None
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static void UnmapParticleBuffer()
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gParticleBuffer.BufferId());
+    glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Where the particle region and the emitters are placed in window space.
+Parameters: None
+Returns:
+    A transform from the region's and emitters' model space to window space.
+Creator:    agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+static glm::mat4 WindowSpaceTransform()
+{
+    // it's a big polygon for window space (see GeneratePolygonRegion(...)), so after rotating 
+    // it, don't move it very far or it will go out of window space and we won't see it
+    glm::mat4 windowSpaceTransform = glm::rotate(glm::mat4(), 45.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+    windowSpaceTransform *= glm::translate(glm::mat4(), glm::vec3(-0.1f, -0.05f, 0.0f));
+    return windowSpaceTransform;
+}
+
 /*-----------------------------------------------------------------------------------------------
 Description:
     Governs window creation, the initial OpenGL configuration (face culling, depth mask, even
@@ -189,22 +493,272 @@ void Init()
     GLuint freeTypeProgramId = shaderStorageRef.GetShaderProgram(freeTypeShaderKey);
     gTextAtlases.Init("FreeSans.ttf", freeTypeProgramId);
 
+    // the CPU particle passes and the region's transforms are spread across all cores
+    gpThreadPool = new ThreadPool();
+
+    std::vector<PolygonFace> polygonFaces;
+    GeneratePolygonRegion(&polygonFaces);
+    gpPolygonRegion = new ParticleRegionPolygon(polygonFaces, gpThreadPool);
+    gpPolygonRegion->SetTransform(WindowSpaceTransform());
+
+    // the particle region doesn't move, so its bounding box is also the bounding box for every 
+    // active particle (needed by the quantized layout)
+    glm::vec2 regionMin;
+    glm::vec2 regionMax;
+    gpPolygonRegion->GetBoundingBox(&regionMin, &regionMax);
+#ifdef USE_POLYGON_WINDING_TEST
+    // convex regions keep the per-face check
+    gUsePolygonWindingTest = !gpPolygonRegion->IsConvex();
+#endif
+
+    // every shader that touches the particle buffer needs to know how it is laid out
+    ParticleLayoutInfo particleLayout(PARTICLE_LAYOUT, MAX_PARTICLE_COUNT, regionMin, regionMax);
+    std::string particleLayoutDefines = particleLayout.ShaderDefines();
+#ifdef USE_PARTICLE_DEAD_LIST
+    particleLayoutDefines += "#define PARTICLE_DEAD_LIST\n";
+
+    std::string computeShaderDeadListPopKey = "compute particle dead list pop";
+    shaderStorageRef.NewShader(computeShaderDeadListPopKey);
+    shaderStorageRef.AddShaderFile(computeShaderDeadListPopKey, "particleDeadListPop.comp", GL_COMPUTE_SHADER);
+    shaderStorageRef.LinkShader(computeShaderDeadListPopKey);
+#endif
+#ifdef USE_PARTICLE_DRAW_LIST
+    particleLayoutDefines += "#define PARTICLE_DRAW_LIST\n";
+#endif
+#ifdef USE_PARTICLE_LIVE_LIST
+    particleLayoutDefines += "#define PARTICLE_LIVE_LIST\n";
+#endif
+#ifdef USE_GPU_TRANSFORMS
+    std::string transformDefines = "#define GPU_TRANSFORMS\n";
+#else
+    std::string transformDefines;
+#endif
+    particleLayoutDefines += transformDefines;
+#ifdef USE_POLYGON_FACE_GRID
+    particleLayoutDefines += "#define POLYGON_FACE_GRID\n";
+#endif
+#ifdef USE_POLYGON_DISTANCE_FIELD
+    particleLayoutDefines += "#define POLYGON_DISTANCE_FIELD\n";
+#endif
+#ifdef USE_SHARED_MEMORY_FACE_TILES
+    particleLayoutDefines += "#define POLYGON_FACE_TILES\n";
+#endif
+    if (gUsePolygonWindingTest)
+    {
+        particleLayoutDefines += "#define POLYGON_WINDING_TEST\n";
+    }
+
     // for the particle compute shader stuff
     std::string computeShaderUpdateKey = "compute particle update";
     shaderStorageRef.NewShader(computeShaderUpdateKey);
-    shaderStorageRef.AddShaderFile(computeShaderUpdateKey, "particleUpdate.comp", GL_COMPUTE_SHADER);
+    shaderStorageRef.AddShaderFile(computeShaderUpdateKey, "particleUpdate.comp", GL_COMPUTE_SHADER, 
+        particleLayoutDefines);
     shaderStorageRef.LinkShader(computeShaderUpdateKey);
 
     std::string computeShaderResetKey = "compute particle reset";
     shaderStorageRef.NewShader(computeShaderResetKey);
-    shaderStorageRef.AddShaderFile(computeShaderResetKey, "particleReset.comp", GL_COMPUTE_SHADER);
+    shaderStorageRef.AddShaderFile(computeShaderResetKey, "particleReset.comp", GL_COMPUTE_SHADER, 
+        particleLayoutDefines);
     shaderStorageRef.LinkShader(computeShaderResetKey);
 
+#ifdef USE_PARTICLE_LIVE_LIST
+    std::string computeShaderLiveListFlagsKey = "compute particle live list flags";
+    shaderStorageRef.NewShader(computeShaderLiveListFlagsKey);
+    shaderStorageRef.AddShaderFile(computeShaderLiveListFlagsKey, "particleLiveListFlags.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderLiveListFlagsKey);
+
+    std::string computeShaderLiveListArgsKey = "compute particle live list args";
+    shaderStorageRef.NewShader(computeShaderLiveListArgsKey);
+    shaderStorageRef.AddShaderFile(computeShaderLiveListArgsKey, "particleLiveListArgs.comp", 
+        GL_COMPUTE_SHADER);
+    shaderStorageRef.LinkShader(computeShaderLiveListArgsKey);
+#endif
+
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    std::string computeShaderResetAndUpdateKey = "compute particle reset and update";
+    shaderStorageRef.NewShader(computeShaderResetAndUpdateKey);
+    shaderStorageRef.AddShaderFile(computeShaderResetAndUpdateKey, "particleResetAndUpdate.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderResetAndUpdateKey);
+#endif
+
+#ifdef BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+    // the separate passes (without the dead list) and the fused pass, all built the same way
+    // Note: Both ways check every face (or use the winding test if the region needs it) so 
+    // that only the passes differ, and neither keeps a draw list.
+    std::string fusedBenchmarkDefines = particleLayout.ShaderDefines() + transformDefines;
+    if (gUsePolygonWindingTest)
+    {
+        fusedBenchmarkDefines += "#define POLYGON_WINDING_TEST\n";
+    }
+
+    std::string computeShaderResetBenchmarkKey = "compute particle reset benchmark";
+    shaderStorageRef.NewShader(computeShaderResetBenchmarkKey);
+    shaderStorageRef.AddShaderFile(computeShaderResetBenchmarkKey, "particleReset.comp", 
+        GL_COMPUTE_SHADER, fusedBenchmarkDefines);
+    shaderStorageRef.LinkShader(computeShaderResetBenchmarkKey);
+
+    std::string computeShaderUpdateBenchmarkKey = "compute particle update benchmark";
+    shaderStorageRef.NewShader(computeShaderUpdateBenchmarkKey);
+    shaderStorageRef.AddShaderFile(computeShaderUpdateBenchmarkKey, "particleUpdate.comp", 
+        GL_COMPUTE_SHADER, fusedBenchmarkDefines);
+    shaderStorageRef.LinkShader(computeShaderUpdateBenchmarkKey);
+
+    std::string computeShaderResetAndUpdateBenchmarkKey = "compute particle reset and update benchmark";
+    shaderStorageRef.NewShader(computeShaderResetAndUpdateBenchmarkKey);
+    shaderStorageRef.AddShaderFile(computeShaderResetAndUpdateBenchmarkKey, 
+        "particleResetAndUpdate.comp", GL_COMPUTE_SHADER, fusedBenchmarkDefines);
+    shaderStorageRef.LinkShader(computeShaderResetAndUpdateBenchmarkKey);
+#endif
+
+#ifdef BENCHMARK_PARTICLE_COUNTERS
+    // the same shader, built with and without the work group counters
+    std::string computeShaderCountPerInvocationKey = "compute particle count per invocation";
+    shaderStorageRef.NewShader(computeShaderCountPerInvocationKey);
+    shaderStorageRef.AddShaderFile(computeShaderCountPerInvocationKey, "particleCountBenchmark.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines + "#define PER_INVOCATION_ATOMIC_COUNTERS\n");
+    shaderStorageRef.LinkShader(computeShaderCountPerInvocationKey);
+
+    std::string computeShaderCountWorkGroupKey = "compute particle count work group";
+    shaderStorageRef.NewShader(computeShaderCountWorkGroupKey);
+    shaderStorageRef.AddShaderFile(computeShaderCountWorkGroupKey, "particleCountBenchmark.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderCountWorkGroupKey);
+#endif
+
+#ifdef BENCHMARK_FACE_TILES
+    // the same shader, built as is, with the face tiles, and with the distance field
+    // Note: The benchmark has its own regions and doesn't transform anything, so it only gets 
+    // the particle layout.
+    std::string computeShaderBoundsUntiledKey = "compute particle bounds untiled";
+    shaderStorageRef.NewShader(computeShaderBoundsUntiledKey);
+    shaderStorageRef.AddShaderFile(computeShaderBoundsUntiledKey, "particleBoundsBenchmark.comp", 
+        GL_COMPUTE_SHADER, particleLayout.ShaderDefines());
+    shaderStorageRef.LinkShader(computeShaderBoundsUntiledKey);
+
+    std::string computeShaderBoundsTiledKey = "compute particle bounds tiled";
+    shaderStorageRef.NewShader(computeShaderBoundsTiledKey);
+    shaderStorageRef.AddShaderFile(computeShaderBoundsTiledKey, "particleBoundsBenchmark.comp", 
+        GL_COMPUTE_SHADER, particleLayout.ShaderDefines() + "#define POLYGON_FACE_TILES\n");
+    shaderStorageRef.LinkShader(computeShaderBoundsTiledKey);
+
+    std::string computeShaderBoundsDistanceFieldKey = "compute particle bounds distance field";
+    shaderStorageRef.NewShader(computeShaderBoundsDistanceFieldKey);
+    shaderStorageRef.AddShaderFile(computeShaderBoundsDistanceFieldKey, 
+        "particleBoundsBenchmark.comp", GL_COMPUTE_SHADER, 
+        particleLayout.ShaderDefines() + "#define POLYGON_DISTANCE_FIELD\n");
+    shaderStorageRef.LinkShader(computeShaderBoundsDistanceFieldKey);
+#endif
+
+#if defined(USE_PARTICLE_COLLISIONS) || defined(BENCHMARK_PARTICLE_COLLISIONS) || defined(USE_PARTICLE_SORT) || defined(USE_PARTICLE_LIVE_LIST) || defined(BENCHMARK_COMPUTE_PRIMITIVES)
+    // one set of primitives for everything that needs them
+    // Note: Their shaders only see plain buffers of uints, so they don't need the particle 
+    // layout and the primitives build them themselves.
+    gpComputePrimitives = new ComputePrimitives();
+#endif
+
+#ifdef CHECK_PARTICLE_RANDOM
+    {
+        ComputeParticleRandomCheck randomCheck;
+        randomCheck.Run();
+    }
+#endif
+
+#ifdef BENCHMARK_COMPUTE_PRIMITIVES
+    {
+        ComputePrimitivesBenchmark primitivesBenchmark(gpComputePrimitives);
+        bool primitivesPassed = primitivesBenchmark.CheckCorrectness();
+        printf("compute primitives check: %s\n", primitivesPassed ? "PASSED" : "FAILED");
+        primitivesBenchmark.Run();
+    }
+#endif
+
+#ifdef BENCHMARK_PARTICLE_COLLISIONS
+    {
+        // the benchmark has its own particle buffers, which are always an array of structures
+        // Note: It configures these shaders for its particle buffers, so run it before the 
+        // demo's particle buffer is set up.
+        std::string aosDefines = ParticleLayoutInfo(PARTICLE_LAYOUT_AOS, 1).ShaderDefines();
+
+        std::string benchmarkKeysKey = "compute particle collision keys benchmark";
+        shaderStorageRef.NewShader(benchmarkKeysKey);
+        shaderStorageRef.AddShaderFile(benchmarkKeysKey, "particleCollisionKeys.comp", 
+            GL_COMPUTE_SHADER, aosDefines);
+        shaderStorageRef.LinkShader(benchmarkKeysKey);
+
+        std::string benchmarkCellsKey = "compute particle collision cells benchmark";
+        shaderStorageRef.NewShader(benchmarkCellsKey);
+        shaderStorageRef.AddShaderFile(benchmarkCellsKey, "particleCollisionCells.comp", 
+            GL_COMPUTE_SHADER, aosDefines);
+        shaderStorageRef.LinkShader(benchmarkCellsKey);
+
+        std::string benchmarkResolveKey = "compute particle collision resolve benchmark";
+        shaderStorageRef.NewShader(benchmarkResolveKey);
+        shaderStorageRef.AddShaderFile(benchmarkResolveKey, "particleCollisionResolve.comp", 
+            GL_COMPUTE_SHADER, aosDefines);
+        shaderStorageRef.LinkShader(benchmarkResolveKey);
+
+        std::string benchmarkBruteForceKey = "compute particle collision brute force";
+        shaderStorageRef.NewShader(benchmarkBruteForceKey);
+        shaderStorageRef.AddShaderFile(benchmarkBruteForceKey, "particleCollisionBruteForce.comp", 
+            GL_COMPUTE_SHADER, aosDefines);
+        shaderStorageRef.LinkShader(benchmarkBruteForceKey);
+
+        ComputeParticleCollisionBenchmark collisionBenchmark(PARTICLE_COLLISION_RADIUS, 
+            benchmarkKeysKey, benchmarkCellsKey, benchmarkResolveKey, benchmarkBruteForceKey, 
+            gpComputePrimitives);
+        collisionBenchmark.Run();
+    }
+#endif
+
+#if defined(USE_PARTICLE_COLLISIONS) || defined(BENCHMARK_PARTICLE_SORT)
+    // the sort benchmark's neighbor query is the collisions' cell table build
+    std::string computeShaderCollisionKeysKey = "compute particle collision keys";
+    shaderStorageRef.NewShader(computeShaderCollisionKeysKey);
+    shaderStorageRef.AddShaderFile(computeShaderCollisionKeysKey, "particleCollisionKeys.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderCollisionKeysKey);
+
+    std::string computeShaderCollisionCellsKey = "compute particle collision cells";
+    shaderStorageRef.NewShader(computeShaderCollisionCellsKey);
+    shaderStorageRef.AddShaderFile(computeShaderCollisionCellsKey, "particleCollisionCells.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderCollisionCellsKey);
+
+    std::string computeShaderCollisionResolveKey = "compute particle collision resolve";
+    shaderStorageRef.NewShader(computeShaderCollisionResolveKey);
+    shaderStorageRef.AddShaderFile(computeShaderCollisionResolveKey, "particleCollisionResolve.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderCollisionResolveKey);
+#endif
+
+#ifdef USE_PARTICLE_SORT
+    std::string computeShaderSortKeysKey = "compute particle sort keys";
+    shaderStorageRef.NewShader(computeShaderSortKeysKey);
+    shaderStorageRef.AddShaderFile(computeShaderSortKeysKey, "particleSortKeys.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderSortKeysKey);
+
+    std::string computeShaderSortGatherKey = "compute particle sort gather";
+    shaderStorageRef.NewShader(computeShaderSortGatherKey);
+    shaderStorageRef.AddShaderFile(computeShaderSortGatherKey, "particleSortGather.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderSortGatherKey);
+
+    std::string computeShaderSortScatterKey = "compute particle sort scatter";
+    shaderStorageRef.NewShader(computeShaderSortScatterKey);
+    shaderStorageRef.AddShaderFile(computeShaderSortScatterKey, "particleSortScatter.comp", 
+        GL_COMPUTE_SHADER, particleLayoutDefines);
+    shaderStorageRef.LinkShader(computeShaderSortScatterKey);
+#endif
+
     // a render shader specifically for the particles (particle color may change depending on 
     // particle state, so it isn't the same as the geometry's render shader)
     std::string renderParticlesShaderKey = "render particles";
     shaderStorageRef.NewShader(renderParticlesShaderKey);
-    shaderStorageRef.AddShaderFile(renderParticlesShaderKey, "particleRender.vert", GL_VERTEX_SHADER);
+    shaderStorageRef.AddShaderFile(renderParticlesShaderKey, "particleRender.vert", GL_VERTEX_SHADER, 
+        particleLayoutDefines);
     shaderStorageRef.AddShaderFile(renderParticlesShaderKey, "particleRender.frag", GL_FRAGMENT_SHADER);
     shaderStorageRef.LinkShader(renderParticlesShaderKey);
 
@@ -212,26 +766,145 @@ void Init()
     // white, pass through to frag shader)
     std::string renderGeometryShaderKey = "render geometry";
     shaderStorageRef.NewShader(renderGeometryShaderKey);
-    shaderStorageRef.AddShaderFile(renderGeometryShaderKey, "geometry.vert", GL_VERTEX_SHADER);
+    shaderStorageRef.AddShaderFile(renderGeometryShaderKey, "geometry.vert", GL_VERTEX_SHADER, 
+        transformDefines);
     shaderStorageRef.AddShaderFile(renderGeometryShaderKey, "geometry.frag", GL_FRAGMENT_SHADER);
     shaderStorageRef.LinkShader(renderGeometryShaderKey);
     gUnifLocGeometryTransform = shaderStorageRef.GetUniformLocation(renderGeometryShaderKey, "transformMatrixWindowSpace");
 
     // set up the polygon SSBO for computing and rendering
-    std::vector<PolygonFace> polygonFaces;
-    GeneratePolygonRegion(&polygonFaces);
-    gpPolygonRegion = new ParticleRegionPolygon(polygonFaces);
     gPolygonFaceBuffer.Init();
     gPolygonFaceBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gPolygonFaceBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+#ifdef BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+    gPolygonFaceBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateBenchmarkKey));
+    gPolygonFaceBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateBenchmarkKey));
+#endif
     gPolygonFaceBuffer.ConfigureRender(shaderStorageRef.GetShaderProgram(renderGeometryShaderKey));
+#ifdef USE_GPU_TRANSFORMS
+    // the shaders transform the faces, so this is the only upload
+    gPolygonFaceBuffer.UpdateValues(gpPolygonRegion->GetOriginalFaces());
+#endif
+
+#ifdef USE_POLYGON_FACE_GRID
+    // the grid has to be built from the same faces that are in the face buffer
+#ifdef USE_GPU_TRANSFORMS
+    gPolygonFaceGrid.Build(gpPolygonRegion->GetOriginalFaces());
+#else
+    gPolygonFaceGrid.Build(gpPolygonRegion->GetFaces());
+#endif
+    gPolygonFaceGridBuffer.Init();
+    gPolygonFaceGridBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gPolygonFaceGridBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+    gPolygonFaceGridBuffer.UpdateValues(gPolygonFaceGrid);
+#endif
+
+#ifdef USE_POLYGON_DISTANCE_FIELD
+    // same faces as the face buffer
+#ifdef USE_GPU_TRANSFORMS
+    gPolygonDistanceField.Bake(gpPolygonRegion->GetOriginalFaces(), 
+        POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE, gpThreadPool);
+#else
+    gPolygonDistanceField.Bake(gpPolygonRegion->GetFaces(), 
+        POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE, gpThreadPool);
+#endif
+    gPolygonDistanceFieldBuffer.Init();
+    gPolygonDistanceFieldBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gPolygonDistanceFieldBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+    gPolygonDistanceFieldBuffer.UpdateValues(gPolygonDistanceField);
+#endif
+
+    if (gUsePolygonWindingTest)
+    {
+        // same faces as the face buffer
+#ifdef USE_GPU_TRANSFORMS
+        gPolygonWindingTable.Build(gpPolygonRegion->GetOriginalFaces());
+#else
+        gPolygonWindingTable.Build(gpPolygonRegion->GetFaces());
+#endif
+        gPolygonWindingTableBuffer.Init();
+        gPolygonWindingTableBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+        gPolygonWindingTableBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+#ifdef BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+        gPolygonWindingTableBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateBenchmarkKey));
+        gPolygonWindingTableBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateBenchmarkKey));
+#endif
+        gPolygonWindingTableBuffer.UpdateValues(gPolygonWindingTable);
+    }
 
     // set up the particle SSBO for computing and rendering
     std::vector<Particle> allParticles(MAX_PARTICLE_COUNT);
-    gParticleBuffer.Init(allParticles);
+    gParticleBuffer.Init(allParticles, particleLayout);
     gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetKey));
     gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+#ifdef BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetBenchmarkKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateBenchmarkKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateBenchmarkKey));
+#endif
+#ifdef BENCHMARK_PARTICLE_COUNTERS
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderCountPerInvocationKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderCountWorkGroupKey));
+#endif
+#ifdef BENCHMARK_FACE_TILES
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderBoundsUntiledKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderBoundsTiledKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderBoundsDistanceFieldKey));
+#endif
+#if defined(USE_PARTICLE_COLLISIONS) || defined(BENCHMARK_PARTICLE_SORT)
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderCollisionKeysKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderCollisionCellsKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderCollisionResolveKey));
+#endif
+#ifdef USE_PARTICLE_LIVE_LIST
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderLiveListFlagsKey));
+#endif
+#ifdef USE_PARTICLE_SORT
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderSortKeysKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderSortGatherKey));
+    gParticleBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderSortScatterKey));
+#endif
     gParticleBuffer.ConfigureRender(shaderStorageRef.GetShaderProgram(renderParticlesShaderKey));
 
+#ifdef USE_PARTICLE_DEAD_LIST
+    // every particle starts out inactive, so every particle starts out on the dead list
+    gParticleDeadListBuffer.Init(allParticles);
+    gParticleDeadListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderDeadListPopKey));
+    gParticleDeadListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetKey));
+    gParticleDeadListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_PARTICLE_SORT
+    gParticleDeadListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderSortScatterKey));
+#endif
+#endif
+
+#ifdef USE_PARTICLE_LIVE_LIST
+    // every particle starts out inactive, so the list starts out empty
+    gpParticleLiveList = new ComputeParticleLiveList(MAX_PARTICLE_COUNT, 
+        computeShaderLiveListFlagsKey, computeShaderLiveListArgsKey, gpComputePrimitives);
+    gpParticleLiveList->ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetKey));
+    gpParticleLiveList->ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#endif
+
+#ifdef USE_PARTICLE_DRAW_LIST
+    // filled in by whichever shader updates the particles
+    gParticleDrawListBuffer.Init(MAX_PARTICLE_COUNT);
+    gParticleDrawListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderUpdateKey));
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gParticleDrawListBuffer.ConfigureCompute(shaderStorageRef.GetShaderProgram(computeShaderResetAndUpdateKey));
+#endif
+#endif
+
     // place the point emitters into the corners of the polygon region
     // Note: Take into account that GeneratePolygonRegion(...) generates a polygon that covers 
     // at least (-0.5f,-0.5f) to (+0.5f,+0.5f).
@@ -271,8 +944,61 @@ void Init()
     emitDir = glm::vec2(+1.0f, 0.0f);
     gpParticleEmitterBar4 = new ParticleEmitterBar(barStart, barEnd, emitDir, 0.1f, 0.6f);
 
+#ifdef BENCHMARK_FUSED_PARTICLE_RESET_AND_UPDATE
+    {
+        // Note: Its passes bind their atomic counters and emitter SSBOs where the demo's do, so 
+        // run it before the demo's passes are made.  It leaves the particles as it found them 
+        // (all inactive), so the dead list is still right.
+        ComputeParticleResetAndUpdateBenchmark resetAndUpdateBenchmark(particleLayout, 
+            gParticleBuffer.BufferId(), polygonFaces.size(), computeShaderResetBenchmarkKey, 
+            computeShaderUpdateBenchmarkKey, computeShaderResetAndUpdateBenchmarkKey);
+        IParticleEmitter *benchmarkEmitters[] =
+        {
+            gpParticleEmitterPoint1, gpParticleEmitterPoint2, gpParticleEmitterPoint3, 
+            gpParticleEmitterPoint4, gpParticleEmitterBar1, gpParticleEmitterBar2, 
+            gpParticleEmitterBar3, gpParticleEmitterBar4
+        };
+        for (size_t emitterIndex = 0; emitterIndex < sizeof(benchmarkEmitters) / sizeof(benchmarkEmitters[0]); emitterIndex++)
+        {
+#ifndef USE_GPU_TRANSFORMS
+            // Display() does this every frame, but it hasn't run yet
+            benchmarkEmitters[emitterIndex]->SetTransform(WindowSpaceTransform());
+#endif
+            resetAndUpdateBenchmark.AddEmitter(benchmarkEmitters[emitterIndex]);
+        }
+#ifdef USE_GPU_TRANSFORMS
+        resetAndUpdateBenchmark.SetTransform(WindowSpaceTransform());
+#else
+        // same for the faces
+        gPolygonFaceBuffer.UpdateValues(gpPolygonRegion->GetFaces());
+#endif
+        resetAndUpdateBenchmark.Run(
+            (unsigned int)(PARTICLES_PER_EMITTER_PER_SEC * SIMULATION_STEP_SEC), 
+            SIMULATION_STEP_SEC);
+    }
+#endif
+
     // start up the encapsulation of the CPU side of the computer shader
+    // Note: The fused shader and the reset shader each have their own emitter SSBO on the same 
+    // binding point, so only make the ones that are in use.
+#ifdef USE_FUSED_PARTICLE_RESET_AND_UPDATE
+    gpParticleResetAndUpdater = new ComputeParticleResetAndUpdate(MAX_PARTICLE_COUNT, 
+        polygonFaces.size(), computeShaderResetAndUpdateKey);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterPoint1);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterPoint2);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterPoint3);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterPoint4);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterBar1);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterBar2);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterBar3);
+    gpParticleResetAndUpdater->AddEmitter(gpParticleEmitterBar4);
+#else
+#ifdef USE_PARTICLE_DEAD_LIST
+    gpParticleReseter = new ComputeParticleReset(MAX_PARTICLE_COUNT, computeShaderResetKey,
+        &gParticleDeadListBuffer, computeShaderDeadListPopKey);
+#else
     gpParticleReseter = new ComputeParticleReset(MAX_PARTICLE_COUNT, computeShaderResetKey);
+#endif
     gpParticleReseter->AddEmitter(gpParticleEmitterPoint1);
     gpParticleReseter->AddEmitter(gpParticleEmitterPoint2);
     gpParticleReseter->AddEmitter(gpParticleEmitterPoint3);
@@ -282,11 +1008,110 @@ void Init()
     gpParticleReseter->AddEmitter(gpParticleEmitterBar3);
     gpParticleReseter->AddEmitter(gpParticleEmitterBar4);
 
+#ifdef USE_PARTICLE_LIVE_LIST
+    gpParticleUpdater = new ComputeParticleUpdate(MAX_PARTICLE_COUNT, polygonFaces.size(), computeShaderUpdateKey,
+        gpParticleLiveList);
+#else
     gpParticleUpdater = new ComputeParticleUpdate(MAX_PARTICLE_COUNT, polygonFaces.size(), computeShaderUpdateKey);
+#endif
+#endif
+
+    // the CPU versions of the same
+    gpCpuParticleReseter = new CpuParticleReset(gParticleBuffer.GetLayoutInfo(), gpThreadPool);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterPoint1);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterPoint2);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterPoint3);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterPoint4);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterBar1);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterBar2);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterBar3);
+    gpCpuParticleReseter->AddEmitter(gpParticleEmitterBar4);
+#ifdef USE_POLYGON_FACE_GRID
+    gpCpuParticleUpdater = new CpuParticleUpdate(gParticleBuffer.GetLayoutInfo(), 
+        gpPolygonRegion->GetFaces(), gpThreadPool, &gPolygonFaceGrid);
+#else
+    gpCpuParticleUpdater = new CpuParticleUpdate(gParticleBuffer.GetLayoutInfo(), 
+        gpPolygonRegion->GetFaces(), gpThreadPool, 0, 
+        gUsePolygonWindingTest ? &gPolygonWindingTable : 0);
+#endif
+
+#ifdef CHECK_QUANTIZATION_ERROR_BUDGET
+    {
+        ParticleQuantizationCheck quantizationCheck(MAX_PARTICLE_COUNT, 
+            gpPolygonRegion->GetFaces(), regionMin, regionMax, gpThreadPool);
+        IParticleEmitter *checkEmitters[] =
+        {
+            gpParticleEmitterPoint1, gpParticleEmitterPoint2, gpParticleEmitterPoint3, 
+            gpParticleEmitterPoint4, gpParticleEmitterBar1, gpParticleEmitterBar2, 
+            gpParticleEmitterBar3, gpParticleEmitterBar4
+        };
+        for (size_t emitterIndex = 0; emitterIndex < sizeof(checkEmitters) / sizeof(checkEmitters[0]); emitterIndex++)
+        {
+            // the check runs on the CPU, so the emitters have to be where the faces are
+            checkEmitters[emitterIndex]->SetTransform(WindowSpaceTransform());
+            quantizationCheck.AddEmitter(checkEmitters[emitterIndex]);
+        }
+        quantizationCheck.Run();
+    }
+#endif
+
+#ifdef BENCHMARK_POLYGON_BOUNDARY_TESTS
+    {
+        CpuPolygonBoundaryBenchmark polygonBoundaryBenchmark(
+            POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE, gpThreadPool);
+        polygonBoundaryBenchmark.Run();
+    }
+#endif
+
+#ifdef USE_GPU_TRANSFORMS
+    // the shaders transform the emitters, so the emitter SSBOs need them untransformed (the 
+    // error budget check above transformed them)
+    IParticleEmitter *untransformedEmitters[] =
+    {
+        gpParticleEmitterPoint1, gpParticleEmitterPoint2, gpParticleEmitterPoint3, 
+        gpParticleEmitterPoint4, gpParticleEmitterBar1, gpParticleEmitterBar2, 
+        gpParticleEmitterBar3, gpParticleEmitterBar4
+    };
+    for (size_t emitterIndex = 0; emitterIndex < sizeof(untransformedEmitters) / sizeof(untransformedEmitters[0]); emitterIndex++)
+    {
+        untransformedEmitters[emitterIndex]->SetTransform(glm::mat4());
+    }
+#endif
+
+#ifdef BENCHMARK_PARTICLE_COUNTERS
+    gpParticleCountBenchmark = new ComputeParticleCountBenchmark(MAX_PARTICLE_COUNT, 
+        computeShaderCountPerInvocationKey, computeShaderCountWorkGroupKey);
+#endif
+#ifdef BENCHMARK_PARTICLE_LAYOUTS
+    // builds its own shaders, one per layout, with the same quantization bounds as the demo's
+    gpParticleLayoutBenchmark = new ComputeParticleLayoutBenchmark(particleLayout, 
+        gParticleBuffer.BufferId(), regionMin, regionMax);
+#endif
+#ifdef BENCHMARK_FACE_TILES
+    gpFaceTileBenchmark = new ComputeFaceTileBenchmark(MAX_PARTICLE_COUNT, 
+        computeShaderBoundsUntiledKey, computeShaderBoundsTiledKey, 
+        computeShaderBoundsDistanceFieldKey, POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE, 
+        gpThreadPool);
+#endif
+#if defined(USE_PARTICLE_COLLISIONS) || defined(BENCHMARK_PARTICLE_SORT)
+    gpParticleCollisions = new ComputeParticleCollisions(MAX_PARTICLE_COUNT, 
+        PARTICLE_COLLISION_RADIUS, computeShaderCollisionKeysKey, computeShaderCollisionCellsKey,
+        computeShaderCollisionResolveKey, gpComputePrimitives);
+#endif
+#ifdef USE_PARTICLE_SORT
+    gpParticleSort = new ComputeParticleSort(MAX_PARTICLE_COUNT, regionMin, regionMax, 
+        computeShaderSortKeysKey, computeShaderSortGatherKey, computeShaderSortScatterKey, 
+        gpComputePrimitives);
+#endif
+#ifdef BENCHMARK_PARTICLE_SORT
+    gpParticleSortBenchmark = new ComputeParticleSortBenchmark(particleLayout, gpParticleSort, 
+        gpParticleCollisions);
+#endif
 
     // the timer will be used for framerate calculations
     gTimer.Init();
     gTimer.Start();
+    gSimulationScheduler.Start(&gTimer);
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -308,15 +1133,44 @@ void Display()
 
     // update all particle locations
 
-    // it's a big polygon for window space (see GeneratePolygonRegion(...)), so after rotating 
-    // it, don't move it very far or it will go out of window space and we won't see it
-    glm::mat4 windowSpaceTransform = glm::rotate(glm::mat4(), 45.0f, glm::vec3(0.0f, 0.0f, 1.0f));
-    windowSpaceTransform *= glm::translate(glm::mat4(), glm::vec3(-0.1f, -0.05f, 0.0f));
+    glm::mat4 windowSpaceTransform = WindowSpaceTransform();
 
+#if defined(USE_GPU_TRANSFORMS)
+    // the faces and emitters were uploaded once, untransformed, so only the transforms change
+#if defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE)
+    gpParticleResetAndUpdater->SetEmitterTransform(windowSpaceTransform);
+    gpParticleResetAndUpdater->SetRegionTransform(windowSpaceTransform);
+#else
+    gpParticleReseter->SetEmitterTransform(windowSpaceTransform);
+    gpParticleUpdater->SetRegionTransform(windowSpaceTransform);
+#endif
+#else
     // pre-compute vertices so that they don't have to be transformed in exactly the same way 
     // for every single particle
+    // Note: Nothing is transformed if the transform hasn't changed, and only the faces that 
+    // moved are uploaded.
     gpPolygonRegion->SetTransform(windowSpaceTransform);
-    gPolygonFaceBuffer.UpdateValues(gpPolygonRegion->GetFaces());
+    unsigned int firstChangedFace = 0;
+    unsigned int numChangedFaces = 0;
+    if (gpPolygonRegion->GetChangedFaces(&firstChangedFace, &numChangedFaces))
+    {
+        gPolygonFaceBuffer.UpdateValues(gpPolygonRegion->GetFaces(), firstChangedFace, numChangedFaces);
+        gpPolygonRegion->ClearChangedFaces();
+#ifdef USE_POLYGON_FACE_GRID
+        gPolygonFaceGrid.Build(gpPolygonRegion->GetFaces());
+        gPolygonFaceGridBuffer.UpdateValues(gPolygonFaceGrid);
+#endif
+#ifdef USE_POLYGON_DISTANCE_FIELD
+        gPolygonDistanceField.Bake(gpPolygonRegion->GetFaces(), 
+            POLYGON_DISTANCE_FIELD_TEXELS_PER_SIDE, gpThreadPool);
+        gPolygonDistanceFieldBuffer.UpdateValues(gPolygonDistanceField);
+#endif
+        if (gUsePolygonWindingTest)
+        {
+            gPolygonWindingTable.Build(gpPolygonRegion->GetFaces());
+            gPolygonWindingTableBuffer.UpdateValues(gPolygonWindingTable);
+        }
+    }
     gpParticleEmitterPoint1->SetTransform(windowSpaceTransform);
     gpParticleEmitterPoint2->SetTransform(windowSpaceTransform);
     gpParticleEmitterPoint3->SetTransform(windowSpaceTransform);
@@ -325,15 +1179,75 @@ void Display()
     gpParticleEmitterBar2->SetTransform(windowSpaceTransform);
     gpParticleEmitterBar3->SetTransform(windowSpaceTransform);
     gpParticleEmitterBar4->SetTransform(windowSpaceTransform);
+#endif
 
 
     // reset inactive particles and update active particles (the MAGIC happens here)
-    // Note: 20 particles per emitter per frame * 8 emitters * 60 frames per second stabilizes 
-    // (for this particle region and the emitters' min-max spawn velocities) at ~45,000 active 
-    // particles in one moment.
-    // Also Note: 50 easily maxes out the maximuum 100,000 total particles active at one time.
-    gpParticleReseter->ResetParticles(20);
-    unsigned int numActiveParticles = gpParticleUpdater->Update(0.01f);
+    // Note: A fast frame can get 0 steps.  Then nothing moved, so the draw list and the count 
+    // from the last step are still right and nothing needs to run.
+    // Also Note: The frame's whole emission is reset before its steps, so all of the frame's 
+    // new particles are born at the start of it.
+    // Also Also Note: The compute shaders' counts are read back a few frames late so that the 
+    // CPU doesn't have to wait for the GPU to finish this frame (see CounterReadbackRing).  The 
+    // CPU update counts them itself, so its count is always current.
+    unsigned int numSimulationSteps = gSimulationScheduler.Advance();
+    unsigned int particlesPerEmitter = 
+        gSimulationScheduler.TakeEmission(PARTICLES_PER_EMITTER_PER_SEC);
+    static unsigned int numActiveParticles = 0;
+    static unsigned int activeCountLatencyFrames = 0;
+    if (numSimulationSteps > 0)
+    {
+#ifdef USE_PARTICLE_SORT
+        // before the reset, so the dead list is the only thing holding on to particle indices
+        // Note: Only on frames that update.  The draw list is rebuilt by the update, but on a 
+        // frame with 0 steps, the last one would be drawn with the particles' old indices.
+        static unsigned int framesUntilParticleSort = PARTICLE_SORT_INTERVAL_FRAMES;
+        if (--framesUntilParticleSort == 0)
+        {
+            gpParticleSort->Sort();
+            framesUntilParticleSort = PARTICLE_SORT_INTERVAL_FRAMES;
+#ifdef USE_PARTICLE_LIVE_LIST
+            // the live particles aren't where the list says anymore
+            gpParticleLiveList->Rebuild();
+#endif
+        }
+#endif
+
+        float stepSec = gSimulationScheduler.StepSec();
+#if defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE)
+        // the fused shader resets before its first step
+        gpParticleResetAndUpdater->ResetParticles(particlesPerEmitter);
+#elif defined(USE_CPU_PARTICLE_RESET)
+        gpCpuParticleReseter->SetParticleStorage(MapParticleBuffer());
+        gpCpuParticleReseter->ResetParticles(particlesPerEmitter);
+        UnmapParticleBuffer();
+#else
+        gpParticleReseter->ResetParticles(particlesPerEmitter);
+#endif
+#if defined(USE_FUSED_PARTICLE_RESET_AND_UPDATE)
+        // every step in one dispatch
+        gParticleDrawListBuffer.ClearCount();
+        numActiveParticles = gpParticleResetAndUpdater->Update(stepSec, numSimulationSteps);
+        activeCountLatencyFrames = gpParticleResetAndUpdater->ActiveCountLatencyFrames();
+#elif defined(USE_CPU_PARTICLE_UPDATE)
+        gpCpuParticleUpdater->SetParticleStorage(MapParticleBuffer());
+        for (unsigned int stepCount = 0; stepCount < numSimulationSteps; stepCount++)
+        {
+            numActiveParticles = gpCpuParticleUpdater->Update(stepSec);
+        }
+        activeCountLatencyFrames = 0;
+        UnmapParticleBuffer();
+#else
+        // every step in one dispatch
+        gParticleDrawListBuffer.ClearCount();
+        numActiveParticles = gpParticleUpdater->Update(stepSec, numSimulationSteps);
+        activeCountLatencyFrames = gpParticleUpdater->ActiveCountLatencyFrames();
+#endif
+#ifdef USE_PARTICLE_COLLISIONS
+        // the new velocities are used by the next update
+        gpParticleCollisions->ResolveCollisions();
+#endif
+    }
     
     // draw the particle region borders
     glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("render geometry"));
@@ -344,7 +1258,20 @@ void Display()
     // draw the particles
     glUseProgram(ShaderStorage::GetInstance().GetShaderProgram("render particles"));
     glBindVertexArray(gParticleBuffer.VaoId());
+#ifdef USE_PARTICLE_DRAW_LIST
+    // only the active particles, and the compute shader decided how many there are
+    // Note: The draw command and the indices were written by a shader, so the indirect draw 
+    // and element fetches have to wait for them.
+    // Also Note: The element buffer binding is part of the VAO's state, so the particle VAO 
+    // keeps the draw list as its element buffer after this.  That is harmless.
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gParticleDrawListBuffer.BufferId());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gParticleDrawListBuffer.BufferId());
+    glDrawElementsIndirect(gParticleBuffer.DrawStyle(), GL_UNSIGNED_INT, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#else
     glDrawArrays(gParticleBuffer.DrawStyle(), 0, gParticleBuffer.NumVertices());
+#endif
 
     // draw the frame rate once per second in the lower left corner
     GLfloat color[4] = { 0.5f, 0.5f, 0.0f, 1.0f };
@@ -359,6 +1286,33 @@ void Display()
         frameRate = (double)elapsedFramesPerSecond / elapsedTime;
         elapsedFramesPerSecond = 0;
         elapsedTime -= 1.0f;
+
+#ifdef BENCHMARK_PARTICLE_LAYOUTS
+        gpParticleLayoutBenchmark->Run();
+#endif
+#ifdef BENCHMARK_PARTICLE_COUNTERS
+        gpParticleCountBenchmark->Run();
+#endif
+#ifdef BENCHMARK_FACE_TILES
+        // only once, after the emitters have had time to fill the region with particles
+        static int secondsUntilFaceTileBenchmark = 5;
+        if (--secondsUntilFaceTileBenchmark == 0)
+        {
+            gpFaceTileBenchmark->Run();
+        }
+#endif
+#ifdef BENCHMARK_PARTICLE_SORT
+        // only once, after the emitters have scattered the particles around the buffer
+        static int secondsUntilParticleSortBenchmark = 5;
+        if (--secondsUntilParticleSortBenchmark == 0)
+        {
+            gpParticleSortBenchmark->Run();
+#ifdef USE_PARTICLE_LIVE_LIST
+            // the benchmark sorted the particles too
+            gpParticleLiveList->Rebuild();
+#endif
+        }
+#endif
     }
     sprintf(str, "%.2lf", frameRate);
 
@@ -373,7 +1327,9 @@ void Display()
 
     // now show number of active particles
     // Note: For some reason, lower case "i" seems to appear too close to the other letters.
-    sprintf(str, "active: %d", numActiveParticles);
+    // Also Note: The latency is tiny, but showing it makes it obvious that the count is not 
+    // from this frame.
+    sprintf(str, "active: %d (%d frames ago)", numActiveParticles, activeCountLatencyFrames);
     float numActiveParticlesXY[2] = { -0.99f, +0.7f };
     gTextAtlases.GetAtlas(48)->RenderText(str, numActiveParticlesXY, scaleXY, color);
 
@@ -497,6 +1453,18 @@ void CleanupAll()
     delete gpParticleEmitterBar4;
     delete gpParticleReseter;
     delete gpParticleUpdater;
+    delete gpParticleResetAndUpdater;
+    delete gpCpuParticleReseter;
+    delete gpCpuParticleUpdater;
+    delete gpParticleCountBenchmark;
+    delete gpParticleLayoutBenchmark;
+    delete gpFaceTileBenchmark;
+    delete gpParticleCollisions;
+    delete gpParticleSortBenchmark;
+    delete gpParticleSort;
+    delete gpParticleLiveList;
+    delete gpComputePrimitives;
+    delete gpThreadPool;
 }
 
 /*-----------------------------------------------------------------------------------------------
@@ -545,6 +1513,18 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    // the highest shader storage buffer binding in use is 31 (see ComputeParticleSort.cpp), 
+    // but OpenGL only promises 8
+    GLint maxSsboBindings = 0;
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &maxSsboBindings);
+    if (maxSsboBindings < 32)
+    {
+        printf("Your OpenGL driver has %i shader storage buffer bindings. You must have at least 32 to run this tutorial.\n",
+            maxSsboBindings);
+        glutDestroyWindow(window);
+        return 0;
+    }
+
     if (glext_ARB_debug_output)
     {
         glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
@@ -0,0 +1,112 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleCollision.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses the particle buffer, so include it after particleLayout.glsl.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The spatial hash that particle-particle collisions are found with (see 
+    ComputeParticleCollisions for how the passes fit together).
+
+    Space is cut into square cells as wide as a particle (2 radii), so 2 particles can only 
+    touch if they are in the same cell or in neighboring cells.  Each cell is hashed into a 
+    table with a power of 2 number of slots:
+    - CollisionKeys: each particle's slot (or uCollisionTableSize for inactive particles, so 
+    that they sort to the end), sorted along with CollisionIndices, which starts out as 
+    0, 1, 2, ... so that afterwards it says which particle ended up in each sorted spot
+    - CollisionCells: where each slot's particles start and end in the sorted order 
+    ([start, end), and [0, 0) for empty slots)
+    - CollisionSorted: each particle's position (XY) and velocity (ZW) in sorted order, so that 
+    the neighbors in a cell are read from one contiguous run instead of all over the particle 
+    buffer
+
+    Different cells can hash to the same slot, so the particles in a slot are checked against 
+    the cell that was asked for.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer CollisionKeyBuffer
+{
+    uint CollisionKeys[];
+};
+
+layout (std430) buffer CollisionIndexBuffer
+{
+    uint CollisionIndices[];
+};
+
+layout (std430) buffer CollisionCellBuffer
+{
+    uvec2 CollisionCells[];
+};
+
+layout (std430) buffer CollisionSortedBuffer
+{
+    vec4 CollisionSorted[];
+};
+
+uniform float uCollisionCellSize;
+uniform uint uCollisionTableSize;
+uniform float uCollisionRadius;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    pos     A particle's position.
+Returns:
+    The grid cell that the position is in.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ivec2 CollisionCell(vec2 pos)
+{
+    return ivec2(floor(pos / uCollisionCellSize));
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Hashes a grid cell into a slot in the table.  The primes are the usual ones for spatial 
+    hashing (Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable 
+    Objects", 2003).  Negative cells wrap around as uints, which is fine for a hash.
+Parameters:
+    cell    Self-explanatory.
+Returns:
+    A slot on the range [0, uCollisionTableSize).
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint CollisionCellKey(ivec2 cell)
+{
+    return ((uint(cell.x) * 73856093u) ^ (uint(cell.y) * 19349663u)) & (uCollisionTableSize - 1);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How much one particle's velocity changes when it bumps into another.  The particles are 
+    circles of the same size and mass, and the collision is elastic, so they swap the parts of 
+    their velocities that are along the line between them.  Particles that overlap but are 
+    already moving apart are left alone so that they don't get stuck together.
+Parameters:
+    posVel      This particle's position (XY) and velocity (ZW).
+    otherPosVel The other particle's.
+Returns:
+    The change to this particle's velocity (0 if they don't collide).
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+vec2 CollisionVelocityChange(vec4 posVel, vec4 otherPosVel)
+{
+    vec2 between = posVel.xy - otherPosVel.xy;
+    float distSqr = dot(between, between);
+    float touchDist = 2.0 * uCollisionRadius;
+    if (distSqr >= (touchDist * touchDist) || distSqr == 0.0)
+    {
+        // not touching, or right on top of each other with no line between them
+        return vec2(0.0);
+    }
+
+    vec2 normal = between * inversesqrt(distSqr);
+    float approachSpeed = dot(posVel.zw - otherPosVel.zw, normal);
+    if (approachSpeed >= 0.0)
+    {
+        return vec2(0.0);
+    }
+
+    return -approachSpeed * normal;
+}
@@ -0,0 +1,23 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleDeadList.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The stack of inactive particles' indices.  The update shader pushes onto it, the "dead list 
+    pop" shader takes a reset pass' worth off the top, and the reset shader works through what 
+    was taken.  Set up on the CPU side in ParticleDeadListSsbo::Init(...).
+
+    Must match ParticleDeadListHeader on the CPU side.  The first three members are the 
+    arguments for glDispatchComputeIndirect(...).
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer DeadListBuffer
+{
+    uint NumWorkGroupsX;
+    uint NumWorkGroupsY;
+    uint NumWorkGroupsZ;
+    uint NumToReset;
+    uint PopStart;
+    uint NumDeadIndices;
+    uint DeadIndices[];
+};
@@ -0,0 +1,57 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleDrawList.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses WorkGroupCountOffset(...), so include it after workGroupCounter.glsl.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The list of particles to draw.  The first five members are the command for 
+    glDrawElementsIndirect(...), and the active particles' indices are its element buffer.  
+    Set up on the CPU side in ParticleDrawListSsbo::Init(...).
+
+    Must match ParticleDrawListHeader on the CPU side.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer DrawListBuffer
+{
+    uint DrawCount;
+    uint DrawInstanceCount;
+    uint DrawFirstIndex;
+    int DrawBaseVertex;
+    uint DrawBaseInstance;
+    uint DrawIndices[];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds the work group's drawn particles to this frame's draw list with one atomicAdd(...) on 
+    DrawCount instead of one per particle.  Each drawn particle writes its index into its own 
+    slot in the work group's range.
+
+    Note: This uses barrier(), so every invocation in the work group must call it, and from 
+    the same place (see workGroupCounter.glsl).
+Parameters:
+    index       The particle's index in the particle buffer.
+    isDrawn     Whether the particle is still active at the end of the update.
+Returns:    None
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void AppendToDrawList(uint index, bool isDrawn)
+{
+    uint offset = WorkGroupCountOffset(isDrawn);
+    if (gl_LocalInvocationIndex == 0)
+    {
+        // atomicAdd(...) returns the value from before the add
+        sWorkGroupCounterStart = 0;
+        if (sWorkGroupCount > 0)
+        {
+            sWorkGroupCounterStart = atomicAdd(DrawCount, sWorkGroupCount);
+        }
+    }
+    memoryBarrierShared();
+    barrier();
+
+    if (isDrawn)
+    {
+        DrawIndices[sWorkGroupCounterStart + offset] = index;
+    }
+}
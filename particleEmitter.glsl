@@ -0,0 +1,236 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleEmitter.glsl" by ShaderStorage::AddShaderFile(...)
+//
+// Everything that is needed to give an inactive particle a new life at one of the emitters in 
+// the EmitterBuffer.  Used by the "particle reset" shader and the fused "particle reset and 
+// update" shader.  
+// Note: It needs the Particle structure (particleLayout.glsl).
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A convenience function whose name indicates its purpose.  Also useful so that I don't have 
+    to type the actual vector name three times.  This isn't quite as accurate as a real square 
+    root, but from what I've read, it is pretty accurate out to a few decimal places, so it's 
+    good enough for simulation work.
+Parameters:
+    v   The vec4 to be normalized.
+Returns:
+    A normalized copy of input v;
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+vec4 QuickNormalize(vec4 v)
+{
+    return inversesqrt(dot(v, v)) * v;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Helps to generate a random displacement region around a particle's spawn point.  It gives 
+    the illusion that the particles come from a cloud instead of a point.  It's a "looks nice" 
+    feature.
+Parameters:
+    v1              The start of the linear blend.
+    v2              The end of the linear blend.
+    Between0And1    Some fraction of the difference between v1 and v2.
+Returns:
+    A vec4 that is linearly blended according to Between0and1.
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+vec4 LinearMix(vec4 v1, vec4 v2, float Between0And1)
+{
+    return (v1 * (1 - Between0And1)) + (v2 * Between0And1);
+}
+
+// the random numbers for new particles
+#include "particleRandom.glsl"
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One particle emitter.  Point and bar emitters share this structure (_isBar says which one 
+    it is) so that every emitter can be in the same buffer and be handled by the same dispatch.  
+    
+    Must match GpuParticleEmitter on the CPU side.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleEmitter
+{
+    // point emitter: _pos1 is the center
+    // bar emitter: _pos1 and _pos2 are the ends of the bar
+    vec4 _pos1;
+    vec4 _pos2;
+    vec4 _emitDir;
+    float _minVelocity;
+    float _deltaVelocity;
+    uint _isBar;
+
+    // this emitter's spawn slots are [_spawnStart, _spawnStart + _spawnCount)
+    uint _spawnStart;
+    uint _spawnCount;
+};
+
+// uploaded once per frame by ComputeParticleReset::ResetParticles(...)
+layout (std430) buffer EmitterBuffer
+{
+    ParticleEmitter AllEmitters[];
+};
+uniform uint uNumEmitters;
+
+// part of the key for the random numbers (see particleRandom.glsl); goes up by 1 every frame
+uniform uint uFrameNumber;
+
+#ifdef GPU_TRANSFORMS
+// the emitters are uploaded untransformed, and this moves them to where they are this frame 
+// (see ComputeParticleReset::SetEmitterTransform(...))
+uniform mat4 uEmitterTransform;
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Similar to the MinMaxVelocity::GetNew() on the CPU side, this function calculates a random 
+    velocity between a min and max value.  The max is inferred by the emitter's "delta 
+    velocity" since all that is needed for the calculation is a variance on the delta.
+
+    Used for both point and bar emitters.
+Parameters:
+    e   The emitter that is resetting the particle.
+    r   The particle's stream of random numbers.
+Returns:
+    A semi-random float on the range e._minVelocity + (rand0To1 * e._deltaVelocity).
+Creator: John Cox (10-10-2016)
+-----------------------------------------------------------------------------------------------*/
+float NewVelocityBetweenMinAndMax(ParticleEmitter e, inout ParticleRandom r)
+{
+    float velocityVariation = RandomOnRange0To1(r) * e._deltaVelocity;
+    float velocityMagnitude = e._minVelocity + velocityVariation;
+
+    return velocityMagnitude;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Resets a particle to a point emitter's position plus a variation on the position that gives
+    the particles the appearance of eminating from a cloud (looks nicer than eminating from a
+    point).
+Parameters:
+    p   A Particle instance.  
+    e   A point emitter.
+    r   The particle's stream of random numbers.
+Returns:
+    A Particle object with a random 2D velocity and a position that is the point emitter's 
+    position plus a small variation on that position to give the appearance of spawning in a 
+    particle cloud.
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+Particle PointEmitterResetPos(Particle p, ParticleEmitter e, inout ParticleRandom r)
+{
+    Particle pCopy = p;
+    
+    vec4 basePosition = e._pos1;
+    float posX = RandomOnRangeNeg1ToPos1(r);
+    float posY = RandomOnRangeNeg1ToPos1(r);
+
+    // need to normalize the outer limit (), but to do that we can't have a 1 in the w position 
+    // or else the X and Y's normalization get's messed up
+    // Note: Window space is on the range [-1,+1] on X and Y, hence the normalizing.
+    vec4 outerPosLimit = 0.1 * QuickNormalize(vec4(posX, posY, 0.0, 0.0));
+    vec4 posVariance = LinearMix(e._pos1, outerPosLimit, RandomOnRange0To1(r));
+    pCopy._pos = basePosition + posVariance;
+    
+    // velocity
+    float velX = RandomOnRangeNeg1ToPos1(r);
+    float velY = RandomOnRangeNeg1ToPos1(r);
+    vec4 randomVelocityVector = QuickNormalize(vec4(velX, velY, 0.0, 0.0));
+    pCopy._vel = randomVelocityVector * NewVelocityBetweenMinAndMax(e, r);
+    
+    return pCopy;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Like PointEmitterResetPos(...), but for a bar emitter.
+Parameters:
+    p   A Particle instance.  
+    e   A bar emitter.
+    r   The particle's stream of random numbers.
+Returns:
+    A Particle object with a 2D velocity on the range min + (rand * delta) and a position 
+    randomly placed between the bar emitter's start and end points.
+Creator: John Cox (10-10-2016)
+-----------------------------------------------------------------------------------------------*/
+Particle BarEmitterResetPos(Particle p, ParticleEmitter e, inout ParticleRandom r)
+{
+    Particle pCopy = p;
+
+    // position
+    vec4 start = e._pos1;
+    vec4 end = e._pos2;
+    vec4 startToEnd = end - start;
+    pCopy._pos = start + (RandomOnRange0To1(r) * startToEnd);
+
+    // velocity
+    vec4 velocityDir = QuickNormalize(e._emitDir);
+    pCopy._vel = velocityDir * NewVelocityBetweenMinAndMax(e, r);
+
+    return pCopy;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Finds the emitter whose range of spawn slots contains the given slot.  There are only a 
+    handful of emitters, so a linear walk over the (ascending) starts is plenty.
+Parameters:
+    spawnSlot   Which of this frame's resets this is.
+Returns:
+    The emitter's index, or uNumEmitters if the slot is past the end of the last emitter's 
+    range.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint FindEmitterForSpawnSlot(uint spawnSlot)
+{
+    for (uint emitterIndex = 0; emitterIndex < uNumEmitters; emitterIndex++)
+    {
+        ParticleEmitter e = AllEmitters[emitterIndex];
+        if (spawnSlot < e._spawnStart + e._spawnCount)
+        {
+            return emitterIndex;
+        }
+    }
+
+    return uNumEmitters;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Makes a new particle at the given emitter.  The random numbers depend only on the frame, 
+    the emitter, and the particle, so the CPU reset makes the same ones (see 
+    CpuParticleReset).
+Parameters:
+    emitterIndex    The emitter that is resetting the particle.
+    particleIndex   The particle's index in the particle buffer.
+Returns:
+    An active Particle with a new position and velocity.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+Particle NewParticleFromEmitter(uint emitterIndex, uint particleIndex)
+{
+    ParticleEmitter e = AllEmitters[emitterIndex];
+#ifdef GPU_TRANSFORMS
+    e._pos1 = uEmitterTransform * e._pos1;
+    e._pos2 = uEmitterTransform * e._pos2;
+    e._emitDir = uEmitterTransform * e._emitDir;
+#endif
+    ParticleRandom r = NewParticleRandom(uFrameNumber, emitterIndex, particleIndex);
+
+    Particle p = Particle(vec4(0.0), vec4(0.0), 0);
+    if (e._isBar == 0)
+    {
+        p = PointEmitterResetPos(p, e, r);
+    }
+    else
+    {
+        p = BarEmitterResetPos(p, e, r);
+    }
+
+    p._isActive = 1;
+    return p;
+}
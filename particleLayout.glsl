@@ -0,0 +1,347 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleLayout.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: Which layout is used is decided on the CPU side by ParticleLayoutInfo::ShaderDefines(),
+// which must be given to AddShaderFile(...) as well.  No defines means AoS.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Stores info about a single particle.  Must match the version on the CPU side.
+
+    This is how the shaders see a particle no matter how it is stored in the ParticleBuffer.
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+struct Particle
+{
+    vec4 _pos;
+    vec4 _vel;
+    int _isActive;
+};
+
+#if defined(PARTICLE_LAYOUT_COMPACT_2D) || defined(PARTICLE_LAYOUT_QUANTIZED_2D)
+
+#if defined(PARTICLE_LAYOUT_COMPACT_2D)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Compact 2D layout.  Only the X and Y of position and velocity are stored (this demo never 
+    uses Z or W), and the "is active" flags are packed 32 to a word in front of the particles.
+    Must match ParticleCompact2D on the CPU side.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct CompactParticle
+{
+    vec2 _pos;
+    vec2 _vel;
+};
+
+layout (std430) buffer ParticleBuffer
+{
+    // PARTICLE_ACTIVE_BIT_WORDS is padded out to a multiple of 4 so that the particles start 
+    // on a 16-byte boundary, just like on the CPU side
+    uint ActiveBits[PARTICLE_ACTIVE_BIT_WORDS];
+    CompactParticle AllParticles[];
+};
+
+vec4 ReadParticlePos(uint index)
+{
+    return vec4(AllParticles[index]._pos, 0.0f, 0.0f);
+}
+
+vec4 ReadParticleVel(uint index)
+{
+    return vec4(AllParticles[index]._vel, 0.0f, 0.0f);
+}
+
+void WriteParticlePosXY(uint index, vec2 pos)
+{
+    AllParticles[index]._pos = pos;
+}
+
+void WriteParticlePos(uint index, vec4 pos)
+{
+    AllParticles[index]._pos = pos.xy;
+}
+
+void WriteParticleVel(uint index, vec4 vel)
+{
+    AllParticles[index]._vel = vel.xy;
+}
+
+#else
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Quantized 2D layout.  Like the compact layout, but the position is two 16-bit unsigned 
+    normalized integers across the particle region's bounding box (PARTICLE_QUANTIZE_MIN and 
+    PARTICLE_QUANTIZE_EXTENT, provided by the CPU side) and the velocity is two half floats.  
+    Must match ParticleQuantized2D and ParticleLayoutInfo::EncodePosition(...) and friends on 
+    the CPU side.
+
+    Note: packUnorm2x16(...) clamps to [0,1], so a position outside of the bounding box is 
+    stored on the edge of the box.  The update shader checks bounds before writing the 
+    position, so that doesn't keep an "out of bounds" particle alive.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct QuantizedParticle
+{
+    uint _packedPos;
+    uint _packedVel;
+};
+
+layout (std430) buffer ParticleBuffer
+{
+    uint ActiveBits[PARTICLE_ACTIVE_BIT_WORDS];
+    QuantizedParticle AllParticles[];
+};
+
+uint EncodePosition(vec2 pos)
+{
+    return packUnorm2x16((pos - PARTICLE_QUANTIZE_MIN) / PARTICLE_QUANTIZE_EXTENT);
+}
+
+vec2 DecodePosition(uint packedPos)
+{
+    return PARTICLE_QUANTIZE_MIN + (unpackUnorm2x16(packedPos) * PARTICLE_QUANTIZE_EXTENT);
+}
+
+vec4 ReadParticlePos(uint index)
+{
+    return vec4(DecodePosition(AllParticles[index]._packedPos), 0.0f, 0.0f);
+}
+
+vec4 ReadParticleVel(uint index)
+{
+    return vec4(unpackHalf2x16(AllParticles[index]._packedVel), 0.0f, 0.0f);
+}
+
+void WriteParticlePosXY(uint index, vec2 pos)
+{
+    AllParticles[index]._packedPos = EncodePosition(pos);
+}
+
+void WriteParticlePos(uint index, vec4 pos)
+{
+    WriteParticlePosXY(index, pos.xy);
+}
+
+void WriteParticleVel(uint index, vec4 vel)
+{
+    AllParticles[index]._packedVel = packHalf2x16(vel.xy);
+}
+
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The "is active" bit field of the compact and quantized layouts.
+
+    Note: Neighboring invocations share "is active" words, so writes to them must be atomic.
+    Reads don't need to be because each invocation only cares about its own bit.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+int ReadParticleIsActive(uint index)
+{
+    return int((ActiveBits[index / 32] >> (index % 32)) & 1);
+}
+
+void WriteParticleIsActive(uint index, int isActive)
+{
+    uint bit = 1u << (index % 32);
+    if (isActive != 0)
+    {
+        atomicOr(ActiveBits[index / 32], bit);
+    }
+    else
+    {
+        atomicAnd(ActiveBits[index / 32], ~bit);
+    }
+}
+
+#elif !defined(PARTICLE_BLOCK_SIZE)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    AoS ("array of structures") layout.  This is the array of particles that the shaders will be
+    accessing.  It is set up on the CPU side in ParticleSsbo::Init(...).
+
+    Note: Instead of the hard-coded binding point as was used in the "render particles 2D basic"
+    project, the binding point is determined on the CPU side.  Is that necessary in this demo?
+    No.  Binding points are relevant only to a particular shader and the CPU side needs to, at
+    least, tell OpenGL that the just-created SSBO should be bound to the same binding point
+    ("binding = 0" here in the shader means glBindBufferBase(..., 0, ...0 in the SSBO setup),
+    but if the user doesn't want to handle the binding on both the shader side and the CPU side,
+    then this demo shows how to handle binding entirely on the CPU side.
+
+    Also Note: Without the binding point specifier, which implicitly assumed std430, then the
+    layout standard needs to be specified explicitly.  According to this website under heading
+    "Layout std430, new and better std140", std430 is the ONLY layout specifier available for
+    SSBOs.  I don't know what it does, but it is necessary.
+    http://malideveloper.arm.com/resources/sample-code/introduction-compute-shaders-2/
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer ParticleBuffer
+{
+    // Note: According to the documentation for shader storage buffer objects, "there can only
+    // be one array of variable size per SSBO and it has to be the bottommost in the layout
+    // definition."  This means that, if I wanted to define anything else in here (I don't since
+    // it is an array of Particle structures whose size is determined on the CPU side), then I
+    // would have to declare it before the array.  If I declared it after, then the shader won't
+    // compile.
+    // See here: https://www.opengl.org/wiki/Shader_Storage_Buffer_Object.
+    Particle AllParticles[];
+};
+
+vec4 ReadParticlePos(uint index)
+{
+    return AllParticles[index]._pos;
+}
+
+vec4 ReadParticleVel(uint index)
+{
+    return AllParticles[index]._vel;
+}
+
+int ReadParticleIsActive(uint index)
+{
+    return AllParticles[index]._isActive;
+}
+
+void WriteParticlePosXY(uint index, vec2 pos)
+{
+    AllParticles[index]._pos.xy = pos;
+}
+
+void WriteParticlePos(uint index, vec4 pos)
+{
+    AllParticles[index]._pos = pos;
+}
+
+void WriteParticleVel(uint index, vec4 vel)
+{
+    AllParticles[index]._vel = vel;
+}
+
+void WriteParticleIsActive(uint index, int isActive)
+{
+    AllParticles[index]._isActive = isActive;
+}
+
+#else
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    SoA and AoSoA layouts.  The buffer is treated as a big array of 32-bit words, and every
+    member of every particle has its own word.  The members are grouped into blocks of
+    PARTICLE_BLOCK_SIZE particles:
+    - SoA: one block for every particle (all the X positions, then all the Y positions, etc.)
+    - AoSoA: blocks of 8 or 16 particles (8 X positions, then 8 Y positions, etc.)
+
+    Neighboring invocations in a work group handle neighboring particles, so when they all read
+    (for example) the X position, they read neighboring words instead of words that are a whole
+    Particle apart.  And a shader that only needs a few members doesn't drag the rest of the
+    Particle through memory.
+
+    Must match ParticleLayoutInfo::WordIndex(...) on the CPU side.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer ParticleBuffer
+{
+    uint AllParticleWords[];
+};
+
+// must match the ParticleField enum on the CPU side
+const uint PARTICLE_FIELD_POS_X = 0;
+const uint PARTICLE_FIELD_POS_Y = 1;
+const uint PARTICLE_FIELD_POS_Z = 2;
+const uint PARTICLE_FIELD_POS_W = 3;
+const uint PARTICLE_FIELD_VEL_X = 4;
+const uint PARTICLE_FIELD_VEL_Y = 5;
+const uint PARTICLE_FIELD_VEL_Z = 6;
+const uint PARTICLE_FIELD_VEL_W = 7;
+const uint PARTICLE_FIELD_IS_ACTIVE = 8;
+
+uint ParticleWordIndex(uint index, uint field)
+{
+    return ((index / PARTICLE_BLOCK_SIZE) * PARTICLE_WORDS_PER_BLOCK) +
+        (field * PARTICLE_BLOCK_SIZE) + (index % PARTICLE_BLOCK_SIZE);
+}
+
+float ReadParticleFloat(uint index, uint field)
+{
+    return uintBitsToFloat(AllParticleWords[ParticleWordIndex(index, field)]);
+}
+
+void WriteParticleFloat(uint index, uint field, float value)
+{
+    AllParticleWords[ParticleWordIndex(index, field)] = floatBitsToUint(value);
+}
+
+vec4 ReadParticlePos(uint index)
+{
+    return vec4(
+        ReadParticleFloat(index, PARTICLE_FIELD_POS_X),
+        ReadParticleFloat(index, PARTICLE_FIELD_POS_Y),
+        ReadParticleFloat(index, PARTICLE_FIELD_POS_Z),
+        ReadParticleFloat(index, PARTICLE_FIELD_POS_W));
+}
+
+vec4 ReadParticleVel(uint index)
+{
+    return vec4(
+        ReadParticleFloat(index, PARTICLE_FIELD_VEL_X),
+        ReadParticleFloat(index, PARTICLE_FIELD_VEL_Y),
+        ReadParticleFloat(index, PARTICLE_FIELD_VEL_Z),
+        ReadParticleFloat(index, PARTICLE_FIELD_VEL_W));
+}
+
+int ReadParticleIsActive(uint index)
+{
+    return int(AllParticleWords[ParticleWordIndex(index, PARTICLE_FIELD_IS_ACTIVE)]);
+}
+
+void WriteParticlePosXY(uint index, vec2 pos)
+{
+    WriteParticleFloat(index, PARTICLE_FIELD_POS_X, pos.x);
+    WriteParticleFloat(index, PARTICLE_FIELD_POS_Y, pos.y);
+}
+
+void WriteParticlePos(uint index, vec4 pos)
+{
+    WriteParticlePosXY(index, pos.xy);
+    WriteParticleFloat(index, PARTICLE_FIELD_POS_Z, pos.z);
+    WriteParticleFloat(index, PARTICLE_FIELD_POS_W, pos.w);
+}
+
+void WriteParticleVel(uint index, vec4 vel)
+{
+    WriteParticleFloat(index, PARTICLE_FIELD_VEL_X, vel.x);
+    WriteParticleFloat(index, PARTICLE_FIELD_VEL_Y, vel.y);
+    WriteParticleFloat(index, PARTICLE_FIELD_VEL_Z, vel.z);
+    WriteParticleFloat(index, PARTICLE_FIELD_VEL_W, vel.w);
+}
+
+void WriteParticleIsActive(uint index, int isActive)
+{
+    AllParticleWords[ParticleWordIndex(index, PARTICLE_FIELD_IS_ACTIVE)] = uint(isActive);
+}
+
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Convenience functions for shaders that want the whole particle.  Shaders that only need a
+    few members (ex: the update shader) should use the Read/Write functions above directly so
+    that the rest of the particle isn't dragged through memory.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+Particle ReadParticle(uint index)
+{
+    return Particle(ReadParticlePos(index), ReadParticleVel(index), ReadParticleIsActive(index));
+}
+
+void WriteParticle(uint index, Particle p)
+{
+    WriteParticlePos(index, p._pos);
+    WriteParticleVel(index, p._vel);
+    WriteParticleIsActive(index, p._isActive);
+}
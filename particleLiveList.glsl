@@ -0,0 +1,51 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleLiveList.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The dense list of active ("live") particles' indices that the update shader is dispatched 
+    over (see ComputeParticleLiveList).  The front of the list buffer is the count, then the 
+    arguments for glDispatchComputeIndirect(...) (one invocation per listed particle).
+
+    Every particle also has a flag that says whether it is live.  The flags are what gets 
+    compacted into the list after each update.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer LiveListBuffer
+{
+    uint LiveCount;
+    uint LiveNumWorkGroupsX;
+    uint LiveNumWorkGroupsY;
+    uint LiveNumWorkGroupsZ;
+};
+
+layout (std430) buffer LiveIndexBuffer
+{
+    uint LiveIndices[];
+};
+
+layout (std430) buffer LiveFlagBuffer
+{
+    uint LiveFlags[];
+};
+
+// the update shader's work group size
+const uint LIVE_LIST_WORK_GROUP_SIZE = 256;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds a particle that was just reset to the end of the list and makes sure that the 
+    update's dispatch reaches it.  The reset shader calls this so that new particles are 
+    updated on the frame that they are born, before the next compaction puts them in order.
+Parameters:
+    index   The particle's index in the particle buffer.
+Returns:    None
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+void AppendToLiveList(uint index)
+{
+    uint liveSlot = atomicAdd(LiveCount, 1);
+    LiveIndices[liveSlot] = index;
+    LiveFlags[index] = 1;
+    atomicMax(LiveNumWorkGroupsX, (liveSlot / LIVE_LIST_WORK_GROUP_SIZE) + 1);
+}
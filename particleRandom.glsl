@@ -0,0 +1,111 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleRandom.glsl" by ShaderStorage::AddShaderFile(...)
+//
+// A counter-based random number generator.  Every random number is a hash of a key and a
+// count, so there is no state that invocations share and no atomic counter to fight over.
+// The key is made from the frame, the emitter, and the particle, so a particle that is reset
+// by the same emitter on the same frame always gets the same random numbers.
+//
+// Must match ParticleRandom on the CPU side bit for bit.  It is all 32bit unsigned integer
+// math, and the conversion to float is exact, so the GPU and CPU come up with the same numbers.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The PCG hash: one step of a 32bit linear congruential generator followed by PCG's "random
+    xorshift, multiply, xorshift" output permutation (http://www.pcg-random.org/).  It is only 
+    a few integer operations and doesn't have the sin(...) hash's banding.
+Parameters:
+    v   Any unsigned int.
+Returns:
+    A chaotic unsigned int.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint PcgHash(uint v)
+{
+    uint state = (v * 747796405u) + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    One particle's stream of random numbers.  GLSL has no references, so functions that draw
+    from it take it as "inout".
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+struct ParticleRandom
+{
+    uint _key;
+    uint _counter;
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Starts a particle's stream of random numbers.
+Parameters:
+    frameNumber     Which frame this is.
+    emitterIndex    Which emitter is resetting the particle.
+    particleIndex   The particle's index in the particle buffer.
+Returns:
+    A new ParticleRandom.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+ParticleRandom NewParticleRandom(uint frameNumber, uint emitterIndex, uint particleIndex)
+{
+    uint key = PcgHash(frameNumber ^ PcgHash(emitterIndex ^ PcgHash(particleIndex)));
+    return ParticleRandom(key, 0u);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The next random number in the stream.  The count is spread out over all 32 bits (golden
+    ratio increments) before it is hashed so that streams with nearby keys don't overlap.
+Parameters:
+    r   The particle's stream of random numbers.
+Returns:
+    A random unsigned int.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint NextRandomUint(inout ParticleRandom r)
+{
+    uint value = PcgHash(r._key + (r._counter * 2654435769u));
+    r._counter = r._counter + 1u;
+    return value;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A random float on the range [0,+1).  The top 24 bits of the random number fit in a float's
+    mantissa exactly, so there is no rounding to differ between the GPU and the CPU.
+Parameters:
+    r   The particle's stream of random numbers.
+Returns:
+    See description.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float RandomOnRange0To1(inout ParticleRandom r)
+{
+    return float(NextRandomUint(r) >> 8u) * (1.0 / 16777216.0);
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A convenience function that generates a single number on the range (-1,+1).  It is used to
+    generate random X and Y velocity vectors for newly-eminating particles.
+Parameters:
+    r   The particle's stream of random numbers.
+Returns:
+    A random float on the range (-1,+1).
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+float RandomOnRangeNeg1ToPos1(inout ParticleRandom r)
+{
+    if (RandomOnRange0To1(r) < 0.5)
+    {
+        return -1.0 * RandomOnRange0To1(r);
+    }
+    else
+    {
+        return +1.0 * RandomOnRange0To1(r);
+    }
+}
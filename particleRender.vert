@@ -1,5 +1,16 @@
 #version 440
 
+#if defined(PARTICLE_BLOCK_SIZE) || defined(PARTICLE_LAYOUT_COMPACT_2D) || defined(PARTICLE_LAYOUT_QUANTIZED_2D)
+
+// SoA and AoSoA layouts don't have a fixed distance between one particle and the next, and the 
+// compact and quantized layouts keep their "is active" flags in a bit field (and the quantized 
+// layout packs X and Y together), so vertex attributes can't describe them.  Instead, pull 
+// each particle straight out of the particle SSBO with the vertex ID (see 
+// ParticleSsbo::ConfigureRender(...)).
+#include "particleLayout.glsl"
+
+#else
+
 // position in window space (both X and Y on the range [-1,+1])
 layout (location = 0) in vec2 pos;  
 
@@ -9,11 +20,19 @@ layout (location = 1) in vec2 vel;
 
 layout (location = 2) in int isActive;
 
+#endif
+
 // must have the same name as its corresponding "in" item in the frag shader
 smooth out vec4 particleColor;
 
 void main()
 {
+#if defined(PARTICLE_BLOCK_SIZE) || defined(PARTICLE_LAYOUT_COMPACT_2D) || defined(PARTICLE_LAYOUT_QUANTIZED_2D)
+    vec2 pos = ReadParticlePos(uint(gl_VertexID)).xy;
+    int isActive = ReadParticleIsActive(uint(gl_VertexID));
+#endif
+
+    // Note: With the draw list (see ParticleDrawListSsbo), only active particles are drawn.
     if (isActive == 0)
     {
         // invisible (alpha = 0), but "fully transparent" does not mean "no color", it merely 
@@ -0,0 +1,82 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "particleSort.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses the Particle structure, so include it after particleLayout.glsl.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The buffers for re-sorting the particle buffer into Z order (see ComputeParticleSort for 
+    how the passes fit together).
+    - ParticleSortKeys: each particle's Morton key (or PARTICLE_SORT_INACTIVE_KEY), sorted 
+    along with ParticleSortIndices, which starts out as 0, 1, 2, ... so that afterwards it says 
+    which particle goes in each spot
+    - SortedParticles: the particles in their new order, whole, so that they can be written 
+    back into the particle buffer in whatever layout it uses
+    - ParticleRemap: each particle's new index, by old index, for anything that was holding 
+    on to particle indices (the dead list)
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer ParticleSortKeyBuffer
+{
+    uint ParticleSortKeys[];
+};
+
+layout (std430) buffer ParticleSortIndexBuffer
+{
+    uint ParticleSortIndices[];
+};
+
+layout (std430) buffer ParticleSortedBuffer
+{
+    Particle SortedParticles[];
+};
+
+layout (std430) buffer ParticleRemapBuffer
+{
+    uint ParticleRemap[];
+};
+
+// must match ComputeParticleSort
+const uint PARTICLE_SORT_BITS_PER_AXIS = 10;
+const uint PARTICLE_SORT_INACTIVE_KEY = 1u << (2 * PARTICLE_SORT_BITS_PER_AXIS);
+
+// the box that the keys are spread over; anything outside of it is clamped to its edges
+uniform vec2 uSortRegionMin;
+uniform vec2 uSortRegionSize;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Spreads the lowest 10 bits of the value out so that there is a 0 between each of them.
+Parameters:
+    value   Self-explanatory.
+Returns:
+    See description.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint SpreadBits(uint value)
+{
+    uint spread = value & 0x000003FF;
+    spread = (spread | (spread << 8)) & 0x00FF00FF;
+    spread = (spread | (spread << 4)) & 0x0F0F0F0F;
+    spread = (spread | (spread << 2)) & 0x33333333;
+    spread = (spread | (spread << 1)) & 0x55555555;
+    return spread;
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Cuts the sort region into a 1024x1024 grid and interleaves the bits of the position's cell 
+    (X in the even bits, Y in the odd bits).  Sorting by this walks the grid in a Z curve, so 
+    particles that are near each other in the region mostly end up near each other in the 
+    buffer.
+Parameters:
+    pos     A particle's position.
+Returns:
+    A key on the range [0, PARTICLE_SORT_INACTIVE_KEY).
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint MortonKey(vec2 pos)
+{
+    float maxCell = float((1u << PARTICLE_SORT_BITS_PER_AXIS) - 1);
+    vec2 cell = clamp(((pos - uSortRegionMin) / uSortRegionSize) * maxCell, 0.0, maxCell);
+    return SpreadBits(uint(cell.x)) | (SpreadBits(uint(cell.y)) << 1);
+}
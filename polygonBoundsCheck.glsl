@@ -0,0 +1,81 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonBoundsCheck.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses whichever of polygonFaceGrid.glsl, polygonDistanceField.glsl, and 
+// polygonWindingTable.glsl the shader was built with, so include it after those and after 
+// polygonFacePlanes.glsl.
+
+#ifdef GPU_TRANSFORMS
+// the faces are uploaded untransformed (see ComputeParticleUpdate::SetRegionTransform(...)), 
+// so move the particle into the region's space instead of moving every face to the particle
+uniform mat4 uInverseRegionTransform;
+#endif
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Moves a particle's position into the space that the region's faces were uploaded in.  
+    Without GPU_TRANSFORMS they are already in the same space.
+Parameters:
+    pos A particle's position.
+Returns:
+    The position relative to the region.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+vec4 ParticleRegionPos(vec4 pos)
+{
+#ifdef GPU_TRANSFORMS
+    // the compact layouts read back a W of 0, but this is a point, so it has to translate
+    return uInverseRegionTransform * vec4(pos.xyz, 1.0);
+#else
+    return pos;
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks if the provided position has gone outside of any of the faces specified in the 
+    PolygonRegionPlanes buffer.
+
+    Note: Checking the faces only works on convex polygons whose face normals point out (see 
+    ParticleRegionPolygon::IsConvex()).  This algorithm simply checks if a vector from the face 
+    (either start or end; both work) to the particle's position is less than 90 degrees away 
+    from the face normal.  Any other region is built with POLYGON_WINDING_TEST, and the faces' 
+    winding number decides instead (see polygonWindingTable.glsl).
+Parameters:
+    pos A particle's position.  It is not a reference or a pointer (GLSL doesn't do either), 
+        but a copy.  If can therefore be used as a local variable, but as a matter of personal 
+        coding principle, I do not use an argument as a local variable.
+Returns:
+    A semi-random float on the range [-1,+1].
+Creator: John Cox (9-25-2016)
+-----------------------------------------------------------------------------------------------*/
+bool ParticleOutOfBoundsPolygon(vec4 pos)
+{
+    vec4 regionPos = ParticleRegionPos(pos);
+#ifdef POLYGON_WINDING_TEST
+    return WindingTableParticleOutOfBounds(regionPos);
+#else
+#ifdef POLYGON_FACE_GRID
+    bool isOut = false;
+    if (FaceGridParticleOutOfBounds(regionPos, isOut))
+    {
+        return isOut;
+    }
+#endif
+#ifdef POLYGON_DISTANCE_FIELD
+    float boundaryDistance = 0.0;
+    if (DistanceFieldSample(regionPos, boundaryDistance))
+    {
+        return boundaryDistance > 0;
+    }
+#endif
+    for (uint faceIndex = 0; faceIndex < uPolygonFaceCount; faceIndex++)
+    {
+        if (DistanceOutsideFace(regionPos, faceIndex) > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+#endif
+}
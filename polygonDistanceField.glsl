@@ -0,0 +1,58 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonDistanceField.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The polygon region baked into signed distances.  Baked on the CPU side by
+    PolygonDistanceField::Bake(...) (see there for what the distances are and how accurate
+    they are) and set up in PolygonDistanceFieldSsbo::Init(...).
+
+    Must match PolygonDistanceFieldHeader on the CPU side.  The texels go row by row from
+    DistanceFieldMin, and each one is a sample at a corner of the grid.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer DistanceFieldBuffer
+{
+    vec2 DistanceFieldMin;
+    vec2 DistanceFieldTexelSize;
+    uint DistanceFieldTexelsX;
+    uint DistanceFieldTexelsY;
+    float DistanceFieldData[];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Interpolates the distance between the 4 texels around the position.  Same as
+    PolygonDistanceField::Sample(...).
+Parameters:
+    regionPos   A particle's position in the same space as the faces that were baked.
+    distance    Set to the signed distance to the region's boundary (positive is out of
+                bounds), but only if the position is in the field.
+Returns:
+    True if the position is in the field, otherwise false (the caller checks every face).  That
+    only happens for particles that are well on their way out of the region.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool DistanceFieldSample(vec4 regionPos, out float distance)
+{
+    distance = 0.0;
+
+    // written so that NaN also goes to the "not in the field" case
+    vec2 texel = (regionPos.xy - DistanceFieldMin) / DistanceFieldTexelSize;
+    if (!(texel.x >= 0.0 && texel.x <= float(DistanceFieldTexelsX - 1) &&
+        texel.y >= 0.0 && texel.y <= float(DistanceFieldTexelsY - 1)))
+    {
+        return false;
+    }
+
+    // the last row and column are the far side of the one before them
+    uint x = min(uint(texel.x), DistanceFieldTexelsX - 2);
+    uint y = min(uint(texel.y), DistanceFieldTexelsY - 2);
+    vec2 fraction = texel - vec2(x, y);
+    uint bottomIndex = (y * DistanceFieldTexelsX) + x;
+    uint topIndex = bottomIndex + DistanceFieldTexelsX;
+    float bottom = mix(DistanceFieldData[bottomIndex], DistanceFieldData[bottomIndex + 1], fraction.x);
+    float top = mix(DistanceFieldData[topIndex], DistanceFieldData[topIndex + 1], fraction.x);
+    distance = mix(bottom, top, fraction.y);
+    return true;
+}
@@ -0,0 +1,72 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonFaceGrid.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses DistanceOutsideFace(...), so include it after polygonFacePlanes.glsl.
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    A uniform grid over the polygon region that says which faces each part of it needs to be
+    checked against.  Built on the CPU side by PolygonFaceGrid::Build(...) (see there for how
+    the cells work) and set up in PolygonFaceGridSsbo::Init(...).
+
+    Must match PolygonFaceGridHeader on the CPU side.  The cells are 2 uints each (where the
+    cell's face list starts in FaceGridData and how many faces are in it, or
+    FACE_GRID_CELL_OUTSIDE), then come the face lists.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer FaceGridBuffer
+{
+    vec2 FaceGridMin;
+    vec2 FaceGridCellSize;
+    uint FaceGridCellsX;
+    uint FaceGridCellsY;
+    uint FaceGridData[];
+};
+
+// same as PolygonFaceGrid::CELL_OUTSIDE
+const uint FACE_GRID_CELL_OUTSIDE = 0xFFFFFFFF;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Checks the position against only the faces that its grid cell lists.  Same answers as
+    checking every face (see PolygonFaceGrid::ParticleOutOfBounds(...)).
+Parameters:
+    regionPos   A particle's position in the same space as the faces.
+    isOut       Set to whether the particle is outside of the region, but only if the position
+                is in the grid.
+Returns:
+    True if the position is in the grid, otherwise false (the caller checks every face).  That
+    only happens for particles that are on their way out of the region.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool FaceGridParticleOutOfBounds(vec4 regionPos, out bool isOut)
+{
+    isOut = false;
+
+    // written so that NaN also goes to the "not in the grid" case
+    vec2 cell = (regionPos.xy - FaceGridMin) / FaceGridCellSize;
+    if (!(cell.x >= 0.0 && cell.x < float(FaceGridCellsX) &&
+        cell.y >= 0.0 && cell.y < float(FaceGridCellsY)))
+    {
+        return false;
+    }
+
+    uint cellIndex = (uint(cell.y) * FaceGridCellsX) + uint(cell.x);
+    uint firstListed = FaceGridData[(2 * cellIndex) + 0];
+    uint numListed = FaceGridData[(2 * cellIndex) + 1];
+    if (numListed == FACE_GRID_CELL_OUTSIDE)
+    {
+        isOut = true;
+        return true;
+    }
+
+    for (uint listIndex = firstListed; listIndex < firstListed + numListed; listIndex++)
+    {
+        if (DistanceOutsideFace(regionPos, FaceGridData[listIndex]) > 0)
+        {
+            isOut = true;
+            break;
+        }
+    }
+
+    return true;
+}
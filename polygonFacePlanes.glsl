@@ -0,0 +1,37 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonFacePlanes.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The polygon's faces as the compute shaders see them: only the half-plane that each face
+    bounds, which is all that the "out of bounds" check needs.  3 floats per face (X and Y of
+    the face's normal, then the normal dotted with the face's start), or 12 bytes instead of
+    the 64 byte PolygonFace that the render shader draws.  Set up on the CPU side in
+    PolygonSsbo::UpdateValues(...).
+
+    Note: std430 pads each element of a vec3 array out to 16 bytes, so this is a float array.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uniform uint uPolygonFaceCount;
+layout (std430) buffer FacePlaneBuffer
+{
+    float PolygonRegionPlanes[];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    How far the position is on the outside of a face's line.  Same as the old
+    dot(pos - face start, face normal), give or take rounding.
+Parameters:
+    regionPos   A particle's position in the same space as the faces.
+    faceIndex   Self-explanatory.
+Returns:
+    The distance times the normal's length.  Positive is outside.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+float DistanceOutsideFace(vec4 regionPos, uint faceIndex)
+{
+    uint planeIndex = 3 * faceIndex;
+    vec2 normal = vec2(PolygonRegionPlanes[planeIndex + 0], PolygonRegionPlanes[planeIndex + 1]);
+    return dot(regionPos.xy, normal) - PolygonRegionPlanes[planeIndex + 2];
+}
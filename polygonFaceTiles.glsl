@@ -0,0 +1,56 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonFaceTiles.glsl" by ShaderStorage::AddShaderFile(...)
+// Note: It uses the FacePlaneBuffer, so include it after polygonFacePlanes.glsl.
+
+// Every invocation in a work group checks its particle against the same faces, so instead of
+// each of them reading every face from the SSBO, the work group reads the faces into shared
+// memory one tile (one face per invocation) at a time and everyone checks their particle
+// against the tile.  Regions with more faces than a tile just take more tiles.
+//
+// Note: This uses barrier(), so every invocation in the work group must call
+// TiledParticleOutOfBoundsPolygon(...), even the ones whose particle is inactive or past the
+// end of the particle buffer.  Don't call it from inside of a branch that only some
+// invocations take (same as workGroupCounter.glsl).
+shared vec3 sFaceTile[gl_WorkGroupSize.x];
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Same answer as checking every face in the FacePlaneBuffer, but each work group only reads
+    each face once.
+Parameters:
+    regionPos   A particle's position in the same space as the faces.
+    isChecked   False if this invocation only helps load the tiles (ex: inactive particle).
+Returns:
+    True if the particle is checked and is on the outside of any face, otherwise false.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool TiledParticleOutOfBoundsPolygon(vec4 regionPos, bool isChecked)
+{
+    bool isOut = false;
+
+    // the face count is a uniform, so every invocation goes around this loop the same number
+    // of times and they all reach both barriers
+    for (uint tileStart = 0; tileStart < uPolygonFaceCount; tileStart += gl_WorkGroupSize.x)
+    {
+        uint faceIndex = tileStart + gl_LocalInvocationIndex;
+        if (faceIndex < uPolygonFaceCount)
+        {
+            uint planeIndex = 3 * faceIndex;
+            sFaceTile[gl_LocalInvocationIndex] = vec3(PolygonRegionPlanes[planeIndex + 0],
+                PolygonRegionPlanes[planeIndex + 1], PolygonRegionPlanes[planeIndex + 2]);
+        }
+        barrier();
+
+        uint numTileFaces = min(gl_WorkGroupSize.x, uPolygonFaceCount - tileStart);
+        for (uint tileIndex = 0; tileIndex < numTileFaces && isChecked && !isOut; tileIndex++)
+        {
+            vec3 plane = sFaceTile[tileIndex];
+            isOut = (dot(regionPos.xy, plane.xy) - plane.z) > 0;
+        }
+
+        // nobody can load the next tile until everyone is done with this one
+        barrier();
+    }
+
+    return isOut;
+}
@@ -0,0 +1,73 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "polygonWindingTable.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The region's faces cut into rows so that a particle only has to look at the faces that 
+    span its own row.  Built on the CPU side by PolygonWindingTable::Build(...) (see there for 
+    how the rows work) and set up in PolygonWindingTableSsbo::Init(...).
+
+    Must match PolygonWindingTableHeader on the CPU side.  The data is (rows + 1) row starts, 
+    then 4 words per face in each row (start X, start Y, end X, end Y; float bits).
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer WindingTableBuffer
+{
+    vec2 WindingTableMin;
+    vec2 WindingTableMax;
+    float WindingTableRowsPerUnit;
+    uint WindingTableRows;
+    uint WindingTableData[];
+};
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Adds up how many times the faces wind around the position.  Unlike the per-face check, 
+    this works for concave regions and regions with holes.  Same answers as 
+    PolygonWindingTable::ParticleOutOfBounds(...).
+Parameters:
+    regionPos   A particle's position in the same space as the faces.
+Returns:
+    True if the faces don't wind around the position, otherwise false.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+bool WindingTableParticleOutOfBounds(vec4 regionPos)
+{
+    // written so that NaN also goes to the "out" case
+    vec2 pos = regionPos.xy;
+    if (!(all(greaterThanEqual(pos, WindingTableMin)) && all(lessThanEqual(pos, WindingTableMax))))
+    {
+        return true;
+    }
+
+    // multiply (not divide) to get the same row as the CPU side
+    float rowFloat = (pos.y - WindingTableMin.y) * WindingTableRowsPerUnit;
+    uint row = min(uint(max(rowFloat, 0.0)), WindingTableRows - 1);
+
+    uint faceDataStart = WindingTableRows + 1;
+    int winding = 0;
+    for (uint faceIndex = WindingTableData[row]; faceIndex < WindingTableData[row + 1]; faceIndex++)
+    {
+        uint faceWord = faceDataStart + (4 * faceIndex);
+        vec2 start = uintBitsToFloat(uvec2(WindingTableData[faceWord + 0], WindingTableData[faceWord + 1]));
+        vec2 end = uintBitsToFloat(uvec2(WindingTableData[faceWord + 2], WindingTableData[faceWord + 3]));
+
+        // positive if the particle is to the left of the face (going from start to end)
+        float side = ((end.x - start.x) * (pos.y - start.y)) - ((pos.x - start.x) * (end.y - start.y));
+        if (start.y <= pos.y)
+        {
+            if (end.y > pos.y && side > 0)
+            {
+                // going up and crossing the ray
+                winding++;
+            }
+        }
+        else if (end.y <= pos.y && side < 0)
+        {
+            // going down and crossing the ray
+            winding--;
+        }
+    }
+
+    return winding == 0;
+}
@@ -0,0 +1,71 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "radixSort.glsl" by ShaderStorage::AddShaderFile(...)
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    The buffers and the shared bits of the key-value radix sort (see 
+    ComputePrimitives::SortKeyValue(...)).  Each pass sorts by one 4-bit digit of the keys, 
+    from the lowest digit to the highest:
+    (1) radixSortHistogram.comp: every block of 256 keys counts its keys with each digit
+    (2) an exclusive scan (see scanBlocks.comp) turns the counts into where each block's keys 
+    with each digit go, all of the 0's first (block by block), then all of the 1's, and so on
+    (3) radixSortScatter.comp: every block sorts itself by the digit in shared memory and 
+    writes its keys and values out to where the scan said they go
+    Every step keeps keys with the same digit in the order that they came in, so after the 
+    last pass the keys are sorted and keys that are equal are still in their original order.
+
+    There can be more blocks than work groups (a dispatch can only have so many), so each work 
+    group loops over every (number of work groups)'th block.
+
+    Note: Not every shader uses every buffer.  The ones that aren't used are compiled away, and 
+    ComputePrimitives only binds the ones that are there.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+layout (std430) buffer RadixSortKeysIn
+{
+    uint KeysIn[];
+};
+
+layout (std430) buffer RadixSortValuesIn
+{
+    uint ValuesIn[];
+};
+
+layout (std430) buffer RadixSortKeysOut
+{
+    uint KeysOut[];
+};
+
+layout (std430) buffer RadixSortValuesOut
+{
+    uint ValuesOut[];
+};
+
+// digit-major: all of the blocks' counts for digit 0, then all of them for digit 1, ...
+layout (std430) buffer RadixSortBlockCounts
+{
+    uint BlockDigitCounts[];
+};
+
+// must match ComputePrimitives
+const uint RADIX_SORT_DIGIT_BITS = 4;
+const uint RADIX_SORT_NUM_DIGITS = 16;
+
+// how many elements are being sorted, in how many blocks, and which digit this pass sorts by
+uniform uint uNumElements;
+uniform uint uNumBlocks;
+uniform uint uDigitShift;
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    Self-explanatory.
+Parameters:
+    key     Self-explanatory.
+Returns:
+    The digit that this pass sorts by.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint RadixSortDigit(uint key)
+{
+    return (key >> uDigitShift) & (RADIX_SORT_NUM_DIGITS - 1);
+}
@@ -0,0 +1,39 @@
+// this file is not a shader on its own; it is pasted into any shader that has the line
+// #include "workGroupScan.glsl" by ShaderStorage::AddShaderFile(...)
+
+shared uint sScan[gl_WorkGroupSize.x];
+
+/*-----------------------------------------------------------------------------------------------
+Description:
+    An exclusive prefix sum across the work group (Hillis-Steele, in shared memory).  The 
+    building block of the scan, compaction, and radix sort primitives (see ComputePrimitives).
+
+    Note: This uses barrier(), so every invocation in the work group must call it.
+Parameters:
+    value   This invocation's value.
+    total   Set to the sum of every invocation's value.
+Returns:
+    The sum of the values of every invocation before this one.
+Creator: agent (10-16-2026)
+-----------------------------------------------------------------------------------------------*/
+uint WorkGroupExclusiveScan(uint value, out uint total)
+{
+    uint localIndex = gl_LocalInvocationIndex;
+    sScan[localIndex] = value;
+    barrier();
+
+    for (uint offset = 1; offset < gl_WorkGroupSize.x; offset <<= 1)
+    {
+        uint addend = (localIndex >= offset) ? sScan[localIndex - offset] : 0;
+        barrier();
+        sScan[localIndex] += addend;
+        barrier();
+    }
+
+    total = sScan[gl_WorkGroupSize.x - 1];
+    uint sumBefore = sScan[localIndex] - value;
+
+    // nobody can start another scan until everyone has read this one
+    barrier();
+    return sumBefore;
+}